@@ -1,7 +1,9 @@
 #pragma once
 #include "core_types.h"
+#include "core_string.h"
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace Audio
 {
@@ -45,4 +47,51 @@ namespace Audio
 		struct Impl;
 		std::unique_ptr<Impl> impl;
 	};
+
+	enum class OfflineRenderMode : u8
+	{
+		// NOTE: Nothing is rendered until RenderFrames() is called
+		Manual,
+		// NOTE: Renders on a driver thread paced at the stream sample rate, like a real device would
+		RealTime,
+		// NOTE: Renders on a driver thread as fast as the render callback allows
+		AsFastAsPossible,
+		Count
+	};
+
+	// NOTE: Doesn't require any audio device at all and so works headless on any platform.
+	//		 The output can optionally be captured into memory and then written out as a 16-bit PCM WAV file
+	class OfflineBackend : public IAudioBackend
+	{
+	public:
+		OfflineBackend();
+		~OfflineBackend();
+
+	public:
+		b8 OpenStartStream(const BackendStreamParam& param, BackendRenderCallback callback) override;
+		b8 StopCloseStream() override;
+		b8 IsOpenRunning() const override;
+
+	public:
+		// NOTE: Only applied when the stream is (re)opened
+		OfflineRenderMode GetRenderMode() const;
+		void SetRenderMode(OfflineRenderMode value);
+
+		b8 GetCaptureOutput() const;
+		void SetCaptureOutput(b8 value);
+
+		// NOTE: Synchronously renders on the calling thread in chunks of at most the desired stream frame count, only valid for OfflineRenderMode::Manual.
+		//		 Returns the number of frames rendered, which is zero if the stream isn't open
+		i64 RenderFrames(i64 frameCount);
+		i64 GetTotalRenderedFrameCount() const;
+
+		// NOTE: All captured output since the stream was opened (or last cleared) as interleaved samples of the stream channel count
+		std::vector<i16> GetCapturedSamples() const;
+		void ClearCapturedSamples();
+		b8 WriteCapturedSamplesToWAVFile(std::string_view filePath) const;
+
+	private:
+		struct Impl;
+		std::unique_ptr<Impl> impl;
+	};
 }
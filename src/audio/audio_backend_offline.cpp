@@ -0,0 +1,185 @@
+#include "audio_backend.h"
+#include "core_io.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+
+namespace Audio
+{
+	// NOTE: Used if the requested frame count is zero, roughly matching a typical shared mode device period
+	static constexpr u32 OfflineFallbackBufferFrameCount = 480;
+
+	struct OfflineBackend::Impl
+	{
+	public:
+		b8 OpenStartStream(const BackendStreamParam& param, BackendRenderCallback callback)
+		{
+			if (isOpenRunning)
+				return false;
+
+			if (param.SampleRate == 0 || param.ChannelCount == 0 || callback == nullptr)
+				return false;
+
+			streamParam = param;
+			renderCallback = std::move(callback);
+			bufferFrameCount = (streamParam.DesiredFrameCount > 0) ? streamParam.DesiredFrameCount : OfflineFallbackBufferFrameCount;
+			renderBuffer.resize(static_cast<size_t>(bufferFrameCount) * streamParam.ChannelCount);
+			totalRenderedFrameCount = 0;
+			ClearCapturedSamples();
+
+			activeRenderMode = renderMode;
+			isOpenRunning = true;
+
+			if (activeRenderMode != OfflineRenderMode::Manual)
+				renderThread = std::thread([this] { RenderThreadEntryPoint(); });
+
+			return true;
+		}
+
+		b8 StopCloseStream()
+		{
+			if (!isOpenRunning)
+				return false;
+
+			isOpenRunning = false;
+			renderThreadStopRequested = true;
+			if (renderThread.joinable())
+				renderThread.join();
+			renderThreadStopRequested = false;
+
+			renderCallback = nullptr;
+			return true;
+		}
+
+		b8 IsOpenRunning() const
+		{
+			return isOpenRunning;
+		}
+
+	public:
+		i64 RenderFrames(i64 frameCount)
+		{
+			if (!isOpenRunning || activeRenderMode != OfflineRenderMode::Manual)
+				return 0;
+
+			i64 framesRendered = 0;
+			while (framesRendered < frameCount)
+			{
+				const u32 chunkFrameCount = static_cast<u32>(Min<i64>(frameCount - framesRendered, bufferFrameCount));
+				RenderNextBuffer(chunkFrameCount);
+				framesRendered += chunkFrameCount;
+			}
+			return framesRendered;
+		}
+
+		void RenderThreadEntryPoint()
+		{
+			using Clock = std::chrono::steady_clock;
+			const auto bufferDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<f64>(static_cast<f64>(bufferFrameCount) / streamParam.SampleRate));
+
+			// NOTE: Pace against the absolute start time instead of sleeping a fixed duration each iteration so that timing errors don't accumulate
+			const auto startTime = Clock::now();
+			for (i64 bufferIndex = 1; !renderThreadStopRequested; bufferIndex++)
+			{
+				RenderNextBuffer(bufferFrameCount);
+
+				if (activeRenderMode == OfflineRenderMode::RealTime)
+					std::this_thread::sleep_until(startTime + (bufferDuration * bufferIndex));
+			}
+		}
+
+		void RenderNextBuffer(const u32 frameCount)
+		{
+			const size_t sampleCount = (static_cast<size_t>(frameCount) * streamParam.ChannelCount);
+			std::fill(renderBuffer.begin(), renderBuffer.begin() + sampleCount, static_cast<i16>(0));
+
+			renderCallback(renderBuffer.data(), frameCount, streamParam.ChannelCount);
+			totalRenderedFrameCount += frameCount;
+
+			if (captureOutput)
+			{
+				const auto lock = std::scoped_lock(capturedSamplesMutex);
+				capturedSamples.insert(capturedSamples.end(), renderBuffer.begin(), renderBuffer.begin() + sampleCount);
+			}
+		}
+
+	public:
+		std::vector<i16> GetCapturedSamples() const
+		{
+			const auto lock = std::scoped_lock(capturedSamplesMutex);
+			return capturedSamples;
+		}
+
+		void ClearCapturedSamples()
+		{
+			const auto lock = std::scoped_lock(capturedSamplesMutex);
+			capturedSamples.clear();
+		}
+
+		b8 WriteCapturedSamplesToWAVFile(std::string_view filePath) const
+		{
+			const u32 channelCount = Max<u32>(streamParam.ChannelCount, 1);
+			const u32 sampleRate = streamParam.SampleRate;
+
+			const auto lock = std::scoped_lock(capturedSamplesMutex);
+			const u32 dataByteSize = static_cast<u32>(capturedSamples.size() * sizeof(i16));
+
+			// NOTE: Canonical 44 byte RIFF header for uncompressed 16-bit PCM, written out as little endian
+			std::vector<u8> fileContent;
+			fileContent.reserve(44 + dataByteSize);
+			auto writeTag = [&](const char tag[4]) { fileContent.insert(fileContent.end(), tag, tag + 4); };
+			auto writeU16 = [&](u16 v) { fileContent.push_back(static_cast<u8>(v)); fileContent.push_back(static_cast<u8>(v >> 8)); };
+			auto writeU32 = [&](u32 v) { writeU16(static_cast<u16>(v)); writeU16(static_cast<u16>(v >> 16)); };
+
+			writeTag("RIFF"); writeU32(36 + dataByteSize); writeTag("WAVE");
+			writeTag("fmt "); writeU32(16);
+			writeU16(1); // NOTE: WAVE_FORMAT_PCM
+			writeU16(static_cast<u16>(channelCount));
+			writeU32(sampleRate);
+			writeU32(sampleRate * channelCount * sizeof(i16));
+			writeU16(static_cast<u16>(channelCount * sizeof(i16)));
+			writeU16(sizeof(i16) * 8);
+			writeTag("data"); writeU32(dataByteSize);
+			for (const i16 sample : capturedSamples)
+				writeU16(static_cast<u16>(sample));
+
+			return File::WriteAllBytes(filePath, fileContent.data(), fileContent.size());
+		}
+
+	public:
+		OfflineRenderMode renderMode = OfflineRenderMode::RealTime;
+		std::atomic<b8> captureOutput = false;
+		std::atomic<i64> totalRenderedFrameCount = 0;
+
+	private:
+		BackendStreamParam streamParam = {};
+		BackendRenderCallback renderCallback;
+		OfflineRenderMode activeRenderMode = OfflineRenderMode::RealTime;
+		u32 bufferFrameCount = 0;
+		std::vector<i16> renderBuffer;
+
+		std::atomic<b8> isOpenRunning = false;
+		std::atomic<b8> renderThreadStopRequested = false;
+		std::thread renderThread;
+
+		mutable std::mutex capturedSamplesMutex;
+		std::vector<i16> capturedSamples;
+	};
+
+	OfflineBackend::OfflineBackend() : impl(std::make_unique<Impl>()) {}
+	OfflineBackend::~OfflineBackend() { impl->StopCloseStream(); }
+	b8 OfflineBackend::OpenStartStream(const BackendStreamParam& param, BackendRenderCallback callback) { return impl->OpenStartStream(param, std::move(callback)); }
+	b8 OfflineBackend::StopCloseStream() { return impl->StopCloseStream(); }
+	b8 OfflineBackend::IsOpenRunning() const { return impl->IsOpenRunning(); }
+	OfflineRenderMode OfflineBackend::GetRenderMode() const { return impl->renderMode; }
+	void OfflineBackend::SetRenderMode(OfflineRenderMode value) { impl->renderMode = value; }
+	b8 OfflineBackend::GetCaptureOutput() const { return impl->captureOutput; }
+	void OfflineBackend::SetCaptureOutput(b8 value) { impl->captureOutput = value; }
+	i64 OfflineBackend::RenderFrames(i64 frameCount) { return impl->RenderFrames(frameCount); }
+	i64 OfflineBackend::GetTotalRenderedFrameCount() const { return impl->totalRenderedFrameCount; }
+	std::vector<i16> OfflineBackend::GetCapturedSamples() const { return impl->GetCapturedSamples(); }
+	void OfflineBackend::ClearCapturedSamples() { impl->ClearCapturedSamples(); }
+	b8 OfflineBackend::WriteCapturedSamplesToWAVFile(std::string_view filePath) const { return impl->WriteCapturedSamplesToWAVFile(filePath); }
+}
@@ -2,14 +2,14 @@
 
 namespace Audio
 {
-	i64 PCMSampleBuffer::ReadAtOrFillSilence(i64 inFrameOffset, i64 inFrameCount, i16 outSamples[]) const
+	i64 PCMSampleBuffer::ReadAtOrFillSilence(i64 inFrameOffset, i64 inFrameCount, i16 outSamples[], i64 readableFrameCount) const
 	{
 		// TODO: Handle channel count mismatch (?) 
 		// assert(ChannelCount == 2);
 
 		const i64 sourceChannelCount = ChannelCount;
-		const i64 sourceFrameCount = FrameCount;
-		const i64 sourceSampleCount = SampleCount();
+		const i64 sourceFrameCount = Clamp<i64>(readableFrameCount, 0, FrameCount);
+		const i64 sourceSampleCount = (sourceFrameCount * sourceChannelCount);
 
 		std::fill(outSamples, outSamples + (inFrameCount * sourceChannelCount), 0);
 
@@ -26,7 +26,7 @@ namespace Audio
 
 			std::copy(
 				InterleavedSamples.get(),
-				Min<i16*>(InterleavedSamples.get() + nonSilentSamples, InterleavedSamples.get() + sourceSampleCount),
+				Min<const i16*>(InterleavedSamples.get() + nonSilentSamples, InterleavedSamples.get() + sourceSampleCount),
 				Min<i16*>(nonSilentBuffer, outSamples + (inFrameCount * sourceChannelCount)));
 		}
 		else
@@ -39,4 +39,84 @@ namespace Audio
 
 		return inFrameCount;
 	}
+
+	struct PCMCacheFileHeader
+	{
+		static constexpr char CurrentMagic[8] = { 'P', 'D', 'K', 'P', 'C', 'M', '1', '6', };
+		static constexpr u32 CurrentVersion = 1;
+		static constexpr size_t SampleDataAlignment = 16;
+
+		char Magic[8];
+		u32 Version;
+		u32 ChannelCount;
+		u64 SourceContentHash;
+		u64 SourceFileSize;
+		u32 SampleRate;
+		u32 Reserved;
+		i64 FrameCount;
+		u64 SampleDataOffset;
+	};
+
+	static constexpr size_t PCMCacheFileSampleDataOffset = (sizeof(PCMCacheFileHeader) + PCMCacheFileHeader::SampleDataAlignment - 1) & ~(PCMCacheFileHeader::SampleDataAlignment - 1);
+
+	b8 WritePCMCacheFile(std::string_view filePath, const SourceCacheKey& key, const PCMSampleBuffer& buffer)
+	{
+		if (filePath.empty() || buffer.InterleavedSamples == nullptr || buffer.ChannelCount == 0 || buffer.FrameCount <= 0)
+			return false;
+
+		PCMCacheFileHeader header = {};
+		memcpy(header.Magic, PCMCacheFileHeader::CurrentMagic, sizeof(header.Magic));
+		header.Version = PCMCacheFileHeader::CurrentVersion;
+		header.ChannelCount = buffer.ChannelCount;
+		header.SourceContentHash = key.SourceContentHash;
+		header.SourceFileSize = key.SourceFileSize;
+		header.SampleRate = buffer.SampleRate;
+		header.FrameCount = buffer.FrameCount;
+		header.SampleDataOffset = PCMCacheFileSampleDataOffset;
+
+		// NOTE: Only the (padded) header is assembled separately with the samples themselves being written straight from the buffer
+		u8 headerBytes[PCMCacheFileSampleDataOffset] = {};
+		memcpy(headerBytes, &header, sizeof(header));
+		const File::ByteSpan fileContentSpans[] = { { headerBytes, sizeof(headerBytes) }, { buffer.InterleavedSamples.get(), buffer.ByteSize() } };
+
+		std::string tempFilePath { filePath };
+		tempFilePath += ".tmp";
+		if (!File::WriteAllBytes(tempFilePath, fileContentSpans, ArrayCount(fileContentSpans)))
+			return false;
+
+		return File::Move(tempFilePath, filePath, true);
+	}
+
+	b8 MapPCMCacheFile(std::string_view filePath, const SourceCacheKey& key, u32 expectedSampleRate, PCMSampleBuffer& outBuffer)
+	{
+		std::unique_ptr<File::MemoryMappedFile> mappedFile = File::MapReadOnly(filePath);
+		if (mappedFile == nullptr || mappedFile->Size < PCMCacheFileSampleDataOffset)
+			return false;
+
+		PCMCacheFileHeader header;
+		memcpy(&header, mappedFile->Content, sizeof(header));
+
+		const b8 isUpToDate =
+			memcmp(header.Magic, PCMCacheFileHeader::CurrentMagic, sizeof(header.Magic)) == 0 &&
+			header.Version == PCMCacheFileHeader::CurrentVersion &&
+			header.SourceContentHash == key.SourceContentHash &&
+			header.SourceFileSize == key.SourceFileSize &&
+			header.SampleRate == expectedSampleRate;
+		if (!isUpToDate)
+			return false;
+
+		// NOTE: Guard against truncated or otherwise corrupted files before pointing anything into the mapped sample data
+		const u64 sampleDataByteSize = (mappedFile->Size - PCMCacheFileSampleDataOffset);
+		if (header.ChannelCount == 0 || header.FrameCount <= 0 || header.SampleDataOffset != PCMCacheFileSampleDataOffset)
+			return false;
+		if (static_cast<u64>(header.FrameCount) > (sampleDataByteSize / sizeof(i16) / header.ChannelCount))
+			return false;
+
+		const i16* mappedSamples = reinterpret_cast<const i16*>(mappedFile->Content + header.SampleDataOffset);
+		outBuffer.ChannelCount = header.ChannelCount;
+		outBuffer.SampleRate = header.SampleRate;
+		outBuffer.FrameCount = header.FrameCount;
+		outBuffer.InterleavedSamples = PCMSampleStorage(std::move(mappedFile), mappedSamples);
+		return true;
+	}
 }
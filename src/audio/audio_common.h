@@ -1,5 +1,6 @@
 #pragma once
 #include "core_types.h"
+#include "core_io.h"
 #include <memory>
 #include <vector>
 
@@ -33,18 +34,59 @@ namespace Audio
 	template <typename T, typename S> // Target, Source
 	constexpr T ScaleSampleILinear_Clamped(S v, f32 linear) { return ClampSampleI<T>(v * linear); }
 
+	// NOTE: Interleaved samples either owned on the heap or pointing into a read-only memory mapped cache file, which is kept alive for as long as they are in use.
+	//		 Implicitly constructible from a heap allocation so that decoders can keep handing over their std::unique_ptr buffers
+	class PCMSampleStorage
+	{
+	public:
+		PCMSampleStorage() = default;
+		PCMSampleStorage(std::nullptr_t) {}
+		PCMSampleStorage(std::unique_ptr<i16[]> heapSamples) : heapSamples(std::move(heapSamples)) {}
+		PCMSampleStorage(std::shared_ptr<const File::MemoryMappedFile> mappedFile, const i16* mappedSamples) : mappedFile(std::move(mappedFile)), mappedSamples(mappedSamples) {}
+
+		inline const i16* get() const { return (heapSamples != nullptr) ? heapSamples.get() : (mappedFile != nullptr) ? mappedSamples : nullptr; }
+		inline i16* GetMutable() { assert(!IsMapped()); return heapSamples.get(); }
+		inline b8 IsMapped() const { return (mappedFile != nullptr); }
+
+		inline const i16& operator[](size_t index) const { return get()[index]; }
+		inline b8 operator==(std::nullptr_t) const { return (get() == nullptr); }
+		inline b8 operator!=(std::nullptr_t) const { return (get() != nullptr); }
+
+	private:
+		std::unique_ptr<i16[]> heapSamples;
+		std::shared_ptr<const File::MemoryMappedFile> mappedFile;
+		const i16* mappedSamples = nullptr;
+	};
+
 	struct PCMSampleBuffer
 	{
 		u32 ChannelCount;
 		u32 SampleRate;
 		i64 FrameCount;
-		std::unique_ptr<i16[]> InterleavedSamples;
+		PCMSampleStorage InterleavedSamples;
 
 		constexpr size_t SampleCount() const { return (FrameCount * ChannelCount); }
 		constexpr size_t ByteSize() const { return (FrameCount * ChannelCount * sizeof(i16)); }
-		i64 ReadAtOrFillSilence(i64 inFrameOffset, i64 inFrameCount, i16 outSamples[]) const;
+		inline i64 ReadAtOrFillSilence(i64 inFrameOffset, i64 inFrameCount, i16 outSamples[]) const { return ReadAtOrFillSilence(inFrameOffset, inFrameCount, outSamples, FrameCount); }
+
+		// NOTE: Treating every frame past readableFrameCount as silence, for buffers still in the process of being filled in by a streaming decode
+		i64 ReadAtOrFillSilence(i64 inFrameOffset, i64 inFrameCount, i16 outSamples[], i64 readableFrameCount) const;
+	};
+
+	// NOTE: Identifies the exact source file content a cache file was generated from, so that a changed audio file invalidates its stale cache entry
+	struct SourceCacheKey
+	{
+		u64 SourceContentHash;
+		u64 SourceFileSize;
 	};
 
+	// NOTE: Raw interleaved samples of an already decoded (and resampled) source, going through a temporary file so that a half written cache file can never be mapped
+	b8 WritePCMCacheFile(std::string_view filePath, const SourceCacheKey& key, const PCMSampleBuffer& buffer);
+
+	// NOTE: Maps the cache file and points the buffer directly at its samples without any copying.
+	//		 Returns false if the file doesn't exist, is stale or doesn't match the expected sample rate
+	b8 MapPCMCacheFile(std::string_view filePath, const SourceCacheKey& key, u32 expectedSampleRate, PCMSampleBuffer& outBuffer);
+
 	enum class ChannelMixingBehavior : u8
 	{
 		Combine,
@@ -67,18 +109,18 @@ namespace Audio
 		u32 TargetChannels = 2;
 		std::vector<i16> MixBuffer;
 
-		i64 MixChannels(PCMSampleBuffer& buffer, i16 bufferToFill[], i64 frameOffset, i64 framesToRead);
+		i64 MixChannels(PCMSampleBuffer& buffer, i16 bufferToFill[], i64 frameOffset, i64 framesToRead, i64 readableFrameCount);
 		i64 MixChannels(u32 sourceChannels, i16 sampleSwapBuffer[], i64 framesRead, i16 bufferToFill[], i64 frameOffset, i64 framesToRead);
 
 		inline i16* GetMixSampleBufferWithMinSize(size_t minSampleCount) { if (MixBuffer.size() < minSampleCount) MixBuffer.resize(minSampleCount); return MixBuffer.data(); }
 	};
 
-	inline i64 ChannelMixer::MixChannels(PCMSampleBuffer& buffer, i16 bufferToFill[], i64 frameOffset, i64 framesToRead)
+	inline i64 ChannelMixer::MixChannels(PCMSampleBuffer& buffer, i16 bufferToFill[], i64 frameOffset, i64 framesToRead, i64 readableFrameCount)
 	{
 		const u32 sourceChannels = buffer.ChannelCount;
 		i16* mixBuffer = GetMixSampleBufferWithMinSize(framesToRead * sourceChannels);
 
-		const i64 framesRead = buffer.ReadAtOrFillSilence(frameOffset, framesToRead, mixBuffer);
+		const i64 framesRead = buffer.ReadAtOrFillSilence(frameOffset, framesToRead, mixBuffer, readableFrameCount);
 		return MixChannels(sourceChannels, mixBuffer, framesRead, bufferToFill, frameOffset, framesToRead);
 	}
 
@@ -159,16 +201,8 @@ namespace Audio
 
 	// TODO: Switch to f32 instead (?)
 	template <typename SampleType>
-	constexpr SampleType LinearSampleAtTimeOrZero(f64 atSecond, u32 atChannel, const SampleType* samples, size_t sampleCount, f64 sampleRate, u32 channelCount)
+	constexpr SampleType LerpSamplesClamped(SampleType startValue, SampleType endValue, f64 inbetween)
 	{
-		const f64 frameFaction = (atSecond * sampleRate);
-		const i64 startFrame = static_cast<i64>(frameFaction);
-		const i64 endFrame = (startFrame + 1);
-
-		const SampleType startValue = SampleAtFrameIndexOrZero<SampleType>(startFrame, atChannel, samples, sampleCount, channelCount);
-		const SampleType endValue = SampleAtFrameIndexOrZero<SampleType>(endFrame, atChannel, samples, sampleCount, channelCount);
-		const f64 inbetween = (frameFaction - static_cast<f64>(startFrame));
-
 		static constexpr f64 maxSampleValueF64 = static_cast<f64>(std::numeric_limits<SampleType>::max());
 		const f64 normalizedStart = static_cast<f64>(startValue / maxSampleValueF64);
 		const f64 normalizedEnd = static_cast<f64>(endValue / maxSampleValueF64);
@@ -180,49 +214,18 @@ namespace Audio
 		return sampleTypeResult;
 	}
 
-	// NOTE: Low quallity linear resampling lacking a low pass filter, should however still be better than having sped up audio for now
 	template <typename SampleType>
-	void LinearlyResampleBuffer(std::unique_ptr<SampleType[]>& inOutSamples, size_t& inOutFrameCount, u32& inOutSampleRate, const u32 inChannelCount, const u32 targetSampleRate)
+	constexpr SampleType LinearSampleAtTimeOrZero(f64 atSecond, u32 atChannel, const SampleType* samples, size_t sampleCount, f64 sampleRate, u32 channelCount)
 	{
-		if (inOutSampleRate == targetSampleRate) { assert(false); return; }
-
-		const SampleType* inSamples = inOutSamples.get();
-		const size_t inSampleCount = (inOutFrameCount * inChannelCount);
-
-		const f64 sourceRate = static_cast<f64>(inOutSampleRate);
-		const f64 targetRate = static_cast<f64>(targetSampleRate);
-
-		const size_t inFrameCount = (inSampleCount / inChannelCount);
-		const size_t outFrameCount = static_cast<size_t>(inFrameCount * targetRate / sourceRate + 0.5);
-
-		const size_t outSampleCount = (outFrameCount * inChannelCount);
-		// auto outSamples = std::make_unique<SampleType[]>(outSampleCount);
-		auto outSamples = std::unique_ptr<SampleType[]>(new SampleType[outSampleCount]);
-
-		const f64 outFrameToSecond = (1.0 / targetRate);
-		SampleType* outSampleWriteHead = outSamples.get();
-
-		for (size_t frame = 0; frame < outFrameCount; frame++)
-		{
-			const f64 second = (static_cast<f64>(frame) * outFrameToSecond);
-
-			for (u32 channel = 0; channel < inChannelCount; channel++)
-				outSampleWriteHead[channel] = LinearSampleAtTimeOrZero<SampleType>(second, channel, inSamples, inSampleCount, sourceRate, inChannelCount);
-
-			outSampleWriteHead += inChannelCount;
-		}
+		const f64 frameFaction = (atSecond * sampleRate);
+		const i64 startFrame = static_cast<i64>(frameFaction);
+		const i64 endFrame = (startFrame + 1);
 
-		inOutSamples = std::move(outSamples);
-		inOutFrameCount = outFrameCount;
-		inOutSampleRate = targetSampleRate;
-	}
+		const SampleType startValue = SampleAtFrameIndexOrZero<SampleType>(startFrame, atChannel, samples, sampleCount, channelCount);
+		const SampleType endValue = SampleAtFrameIndexOrZero<SampleType>(endFrame, atChannel, samples, sampleCount, channelCount);
+		const f64 inbetween = (frameFaction - static_cast<f64>(startFrame));
 
-	template <typename SampleType>
-	void LinearlyResampleBuffer(std::unique_ptr<SampleType[]>& inOutSamples, i64& inOutFrameCount, u32& inOutSampleRate, const u32 inChannelCount, const u32 targetSampleRate)
-	{
-		size_t inOutFrameCountSizeT = static_cast<size_t>(inOutFrameCount);
-		Audio::LinearlyResampleBuffer(inOutSamples, inOutFrameCountSizeT, inOutSampleRate, inChannelCount, targetSampleRate);
-		inOutFrameCount = static_cast<i64>(inOutFrameCountSizeT);
+		return LerpSamplesClamped<SampleType>(startValue, endValue, inbetween);
 	}
 
 	template <typename T>
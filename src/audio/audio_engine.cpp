@@ -1,16 +1,65 @@
 #include "audio_engine.h"
 #include "audio_file_formats.h"
 #include "audio_backend.h"
+#include "audio_resampler.h"
 #include "core_io.h"
-#include <mutex>
+
+// NOTE: SSE2 is always available on x64 so there is no need for any runtime CPU feature detection
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define AUDIO_ENGINE_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define AUDIO_ENGINE_USE_SSE2 0
+#endif
 
 namespace Audio
 {
-	constexpr HandleBaseType VoiceHandleToIndex(VoiceHandle handle) { return static_cast<HandleBaseType>(handle); }
-	constexpr VoiceHandle IndexToVoiceHandle(HandleBaseType index) { return static_cast<VoiceHandle>(index); }
+	using HandleGeneration = u16;
+	constexpr HandleBaseType HandleIndexMask = 0xFFFF;
+	constexpr u32 HandleGenerationShift = 16;
+
+	constexpr HandleBaseType VoiceHandleToIndex(VoiceHandle handle) { return static_cast<HandleBaseType>(handle) & HandleIndexMask; }
+	constexpr HandleGeneration VoiceHandleToGeneration(VoiceHandle handle) { return static_cast<HandleGeneration>(static_cast<HandleBaseType>(handle) >> HandleGenerationShift); }
+	constexpr VoiceHandle IndexToVoiceHandle(HandleBaseType index, HandleGeneration generation) { return static_cast<VoiceHandle>((static_cast<HandleBaseType>(generation) << HandleGenerationShift) | index); }
+
+	constexpr HandleBaseType SourceHandleToIndex(SourceHandle handle) { return static_cast<HandleBaseType>(handle) & HandleIndexMask; }
+	constexpr HandleGeneration SourceHandleToGeneration(SourceHandle handle) { return static_cast<HandleGeneration>(static_cast<HandleBaseType>(handle) >> HandleGenerationShift); }
+	constexpr SourceHandle IndexToSourceHandle(HandleBaseType index, HandleGeneration generation) { return static_cast<SourceHandle>((static_cast<HandleBaseType>(generation) << HandleGenerationShift) | index); }
+
+	static_assert(AudioEngine::MaxSimultaneousVoices <= HandleIndexMask && AudioEngine::MaxLoadedSources <= HandleIndexMask);
+
+	// NOTE: Wait-free single producer single consumer queue, with the indices only ever increasing and wrapping around naturally
+	template <typename T, size_t Capacity>
+	struct SPSCRingBuffer
+	{
+		static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
 
-	constexpr HandleBaseType SourceHandleToIndex(SourceHandle handle) { return static_cast<HandleBaseType>(handle); }
-	constexpr SourceHandle IndexToSourceHandle(HandleBaseType index) { return static_cast<SourceHandle>(index); }
+		std::array<T, Capacity> Items = {};
+		alignas(64) std::atomic<size_t> WriteIndex = 0;
+		alignas(64) std::atomic<size_t> ReadIndex = 0;
+
+		b8 TryPush(const T& item)
+		{
+			const size_t writeIndex = WriteIndex.load(std::memory_order_relaxed);
+			if ((writeIndex - ReadIndex.load(std::memory_order_acquire)) >= Capacity)
+				return false;
+
+			Items[writeIndex & (Capacity - 1)] = item;
+			WriteIndex.store(writeIndex + 1, std::memory_order_release);
+			return true;
+		}
+
+		b8 TryPop(T& outItem)
+		{
+			const size_t readIndex = ReadIndex.load(std::memory_order_relaxed);
+			if (readIndex == WriteIndex.load(std::memory_order_acquire))
+				return false;
+
+			outItem = Items[readIndex & (Capacity - 1)];
+			ReadIndex.store(readIndex + 1, std::memory_order_release);
+			return true;
+		}
+	};
 
 	static std::unique_ptr<IAudioBackend> CreateBackendInterface(Backend backend)
 	{
@@ -19,12 +68,157 @@ namespace Audio
 		case Backend::WASAPI_Shared:
 		case Backend::WASAPI_Exclusive:
 			return std::make_unique<WASAPIBackend>();
+		case Backend::Offline:
+			return std::make_unique<OfflineBackend>();
 		}
 
 		assert(false);
 		return nullptr;
 	}
 
+	// NOTE: Mixing kernels for the render callback, all operating on interleaved stereo frames.
+	//		 Each has a plain scalar loop handling both the leftover frames and platforms without SSE2
+	static_assert(AudioEngine::OutputChannelCount == 2, "The mixing kernels assume interleaved stereo output");
+
+	static void MixStereoI16IntoF32(f32* inOutMix, const i16* samples, const i64 frameCount, const f32 gainL, const f32 gainR)
+	{
+		i64 f = 0;
+#if AUDIO_ENGINE_USE_SSE2
+		const __m128 gainLR = _mm_setr_ps(gainL, gainR, gainL, gainR);
+		for (; (f + 4) <= frameCount; f += 4)
+		{
+			const __m128i samplesI16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&samples[f * 2]));
+			const __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samplesI16, samplesI16), 16));
+			const __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samplesI16, samplesI16), 16));
+			_mm_storeu_ps(&inOutMix[(f * 2) + 0], _mm_add_ps(_mm_loadu_ps(&inOutMix[(f * 2) + 0]), _mm_mul_ps(lo, gainLR)));
+			_mm_storeu_ps(&inOutMix[(f * 2) + 4], _mm_add_ps(_mm_loadu_ps(&inOutMix[(f * 2) + 4]), _mm_mul_ps(hi, gainLR)));
+		}
+#endif
+		for (; f < frameCount; f++)
+		{
+			inOutMix[(f * 2) + 0] += samples[(f * 2) + 0] * gainL;
+			inOutMix[(f * 2) + 1] += samples[(f * 2) + 1] * gainR;
+		}
+	}
+
+	// NOTE: Linearly ramping the volume between the start and end frame, holding the start / end volume before / after.
+	//		 The ramp position is calculated relative to the first frame to keep the f32 lanes precise even for very large frame positions
+	static void MixStereoI16IntoF32VolumeRamp(f32* inOutMix, const i16* samples, const i64 frameCount, const i64 firstFrame,
+		const i64 rampStartFrame, const i64 rampEndFrame, const f32 startVolume, const f32 endVolume, const f32 gainL, const f32 gainR)
+	{
+		const i64 rampFrameLength = (rampEndFrame - rampStartFrame);
+		const f32 rampStep = (rampFrameLength > 0) ? static_cast<f32>(1.0 / static_cast<f64>(rampFrameLength)) : 0.0f;
+		const f32 rampFirst = (rampFrameLength > 0) ? static_cast<f32>(static_cast<f64>(firstFrame - rampStartFrame) / static_cast<f64>(rampFrameLength)) : 0.0f;
+		const f32 volumeDelta = (endVolume - startVolume);
+
+		auto rampVolumeAt = [&](i64 f) -> f32
+		{
+			const i64 frame = (firstFrame + f);
+			if (frame <= rampStartFrame) return startVolume;
+			if (frame >= rampEndFrame) return endVolume;
+			return startVolume + (volumeDelta * Clamp(rampFirst + (static_cast<f32>(f) * rampStep), 0.0f, 1.0f));
+		};
+
+		i64 f = 0;
+#if AUDIO_ENGINE_USE_SSE2
+		if (rampFrameLength > 0)
+		{
+			const __m128 gainLR = _mm_setr_ps(gainL, gainR, gainL, gainR);
+			const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+			const __m128 laneOffsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+			for (; (f + 4) <= frameCount; f += 4)
+			{
+				// NOTE: Clamping the ramp position also takes care of holding the start / end volume
+				const __m128 rampT = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_set1_ps(rampFirst), _mm_mul_ps(_mm_add_ps(_mm_set1_ps(static_cast<f32>(f)), laneOffsets), _mm_set1_ps(rampStep))), zero), one);
+				const __m128 volumes = _mm_add_ps(_mm_set1_ps(startVolume), _mm_mul_ps(_mm_set1_ps(volumeDelta), rampT));
+				const __m128 volumesLo = _mm_unpacklo_ps(volumes, volumes), volumesHi = _mm_unpackhi_ps(volumes, volumes);
+
+				const __m128i samplesI16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&samples[f * 2]));
+				const __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samplesI16, samplesI16), 16));
+				const __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samplesI16, samplesI16), 16));
+				_mm_storeu_ps(&inOutMix[(f * 2) + 0], _mm_add_ps(_mm_loadu_ps(&inOutMix[(f * 2) + 0]), _mm_mul_ps(lo, _mm_mul_ps(volumesLo, gainLR))));
+				_mm_storeu_ps(&inOutMix[(f * 2) + 4], _mm_add_ps(_mm_loadu_ps(&inOutMix[(f * 2) + 4]), _mm_mul_ps(hi, _mm_mul_ps(volumesHi, gainLR))));
+			}
+		}
+#endif
+		for (; f < frameCount; f++)
+		{
+			const f32 volume = rampVolumeAt(f);
+			inOutMix[(f * 2) + 0] += samples[(f * 2) + 0] * (volume * gainL);
+			inOutMix[(f * 2) + 1] += samples[(f * 2) + 1] * (volume * gainR);
+		}
+	}
+
+	// NOTE: The (signed) sample value with the highest magnitude of each frame after applying the pre gain, preferring the left channel on ties
+	static void FindStereoFramePeaks(const f32* mix, const i64 frameCount, const f32 preGain, f32* outFramePeaks)
+	{
+		i64 f = 0;
+#if AUDIO_ENGINE_USE_SSE2
+		const __m128 preGainX4 = _mm_set1_ps(preGain);
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+		for (; (f + 4) <= frameCount; f += 4)
+		{
+			const __m128 a = _mm_mul_ps(_mm_loadu_ps(&mix[(f * 2) + 0]), preGainX4);
+			const __m128 b = _mm_mul_ps(_mm_loadu_ps(&mix[(f * 2) + 4]), preGainX4);
+			const __m128 left = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+			const __m128 right = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+			const __m128 rightIsLouder = _mm_cmpgt_ps(_mm_and_ps(right, absMask), _mm_and_ps(left, absMask));
+			_mm_storeu_ps(&outFramePeaks[f], _mm_or_ps(_mm_and_ps(rightIsLouder, right), _mm_andnot_ps(rightIsLouder, left)));
+		}
+#endif
+		for (; f < frameCount; f++)
+		{
+			const f32 left = mix[(f * 2) + 0] * preGain, right = mix[(f * 2) + 1] * preGain;
+			outFramePeaks[f] = (std::abs(right) > std::abs(left)) ? right : left;
+		}
+	}
+
+	static void ApplyStereoFrameGainsAndMix(f32* inOutOutput, const f32* mix, const f32* frameGains, const i64 frameCount, const f32 preGain, const f32 postGain)
+	{
+		i64 f = 0;
+#if AUDIO_ENGINE_USE_SSE2
+		const __m128 preGainX4 = _mm_set1_ps(preGain), postGainX4 = _mm_set1_ps(postGain);
+		for (; (f + 2) <= frameCount; f += 2)
+		{
+			const __m128 gains = _mm_setr_ps(frameGains[f + 0], frameGains[f + 0], frameGains[f + 1], frameGains[f + 1]);
+			const __m128 result = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&mix[f * 2]), preGainX4), gains), postGainX4);
+			_mm_storeu_ps(&inOutOutput[f * 2], _mm_add_ps(_mm_loadu_ps(&inOutOutput[f * 2]), result));
+		}
+#endif
+		for (; f < frameCount; f++)
+		{
+			for (i64 c = 0; c < 2; c++)
+				inOutOutput[(f * 2) + c] += mix[(f * 2) + c] * preGain * frameGains[f] * postGain;
+		}
+	}
+
+	static void ApplyStereoFrameGainsAndMix(i16* inOutOutput, const f32* mix, const f32* frameGains, const i64 frameCount, const f32 preGain, const f32 postGain)
+	{
+		i64 f = 0;
+#if AUDIO_ENGINE_USE_SSE2
+		const __m128 preGainX4 = _mm_set1_ps(preGain), postGainX4 = _mm_set1_ps(postGain);
+		const __m128 sampleMin = _mm_set1_ps(static_cast<f32>(I16Min)), sampleMax = _mm_set1_ps(static_cast<f32>(I16Max));
+		for (; (f + 4) <= frameCount; f += 4)
+		{
+			const __m128 gainsLo = _mm_setr_ps(frameGains[f + 0], frameGains[f + 0], frameGains[f + 1], frameGains[f + 1]);
+			const __m128 gainsHi = _mm_setr_ps(frameGains[f + 2], frameGains[f + 2], frameGains[f + 3], frameGains[f + 3]);
+			const __m128 lo = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&mix[(f * 2) + 0]), preGainX4), gainsLo), postGainX4);
+			const __m128 hi = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&mix[(f * 2) + 4]), preGainX4), gainsHi), postGainX4);
+
+			// NOTE: Clamp then truncate (same as ClampSampleI) with the final add wrapping around the same way the scalar i16 addition does
+			const __m128i loI32 = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(lo, sampleMin), sampleMax));
+			const __m128i hiI32 = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(hi, sampleMin), sampleMax));
+			__m128i* outputI16 = reinterpret_cast<__m128i*>(&inOutOutput[f * 2]);
+			_mm_storeu_si128(outputI16, _mm_add_epi16(_mm_loadu_si128(outputI16), _mm_packs_epi32(loI32, hiI32)));
+		}
+#endif
+		for (; f < frameCount; f++)
+		{
+			for (i64 c = 0; c < 2; c++)
+				inOutOutput[(f * 2) + c] += ClampSampleI<i16>(mix[(f * 2) + c] * preGain * frameGains[f] * postGain);
+		}
+	}
+
 	using VoiceFlags = u16;
 	enum VoiceFlagsEnum : VoiceFlags
 	{
@@ -36,13 +230,17 @@ namespace Audio
 		VoiceFlags_RemoveOnEnd = 1 << 4,
 		VoiceFlags_PauseOnEnd = 1 << 5,
 		VoiceFlags_VariablePlaybackSpeed = 1 << 6,
+		// NOTE: Still owned by the render thread until it has processed the remove command
+		VoiceFlags_RemovePending = 1 << 7,
 	};
 
-	// NOTE: Indexed into by VoiceHandle, slot valid if Flags != VoiceFlags_Dead
+	// NOTE: Indexed into by VoiceHandle, slot valid if Flags != VoiceFlags_Dead and the generation matches.
+	//		 Only the main thread claims dead slots, while both threads may kill voices (see RenderCommandType)
 	struct VoiceData
 	{
-		// NOTE: Automatically resets to SourceHandle::Invalid when the source is unloaded
 		std::atomic<VoiceFlags> Flags;
+		std::atomic<HandleGeneration> Generation;
+		// NOTE: Automatically resets to SourceHandle::Invalid when the source is unloaded
 		std::atomic<SourceHandle> Source;
 		std::atomic<i32> SoundGroup;
 		std::atomic<f32> Volume;
@@ -72,13 +270,45 @@ namespace Audio
 		char Name[64];
 	};
 
-	// NOTE: Indexed into by SourceHandle, slot valid if SlotUsed
+	enum class SourceSlotState : u8
+	{
+		// NOTE: Can be claimed by any thread loading a source
+		Free,
+		// NOTE: Claimed but not yet visible to the render thread
+		Loading,
+		Used,
+		// NOTE: Invisible to everyone except the render thread, until it has processed the unload command
+		UnloadPending,
+	};
+
+	// NOTE: Indexed into by SourceHandle, slot valid if SlotState == Used and the generation matches
 	struct SourceData
 	{
-		std::atomic<bool> SlotUsed;
+		std::atomic<SourceSlotState> SlotState = SourceSlotState::Free;
+		std::atomic<HandleGeneration> Generation = 0;
 		PCMSampleBuffer Buffer;
 		std::atomic<f32> BaseVolume = 0.0f;
 		char Name[256];
+
+		// NOTE: Streamed sources have their full buffer allocated upfront which is then filled in by a background decode.
+		//		 Only the frames below DecodedFrameCount are safe to read, with the rest being treated as silence
+		std::atomic<i64> DecodedFrameCount = 0;
+		std::atomic<bool> CancelStreamingRequested = false;
+		std::future<void> StreamingTask;
+	};
+
+	// NOTE: Anything freeing a slot the render thread might currently be reading from has to go through the command queue,
+	//		 everything else is either a single atomic store or published by a final release store to the slot flags / state
+	enum class RenderCommandType : u8
+	{
+		RemoveVoice,
+		UnloadSource,
+	};
+
+	struct RenderCommand
+	{
+		RenderCommandType Type;
+		HandleBaseType SlotIndex;
 	};
 
 	struct AudioEngine::Impl
@@ -94,7 +324,12 @@ namespace Audio
 		std::unique_ptr<IAudioBackend> CurrentBackend = nullptr;
 
 	public:
-		std::mutex VoiceRenderMutex;
+		// NOTE: Produced by the main thread, consumed by the render thread at the start of each callback (or by the main thread itself while the stream is closed).
+		//		 Every voice / source slot can have at most one command in flight because it stays RemovePending / UnloadPending (and can't be reused) until the command has been executed,
+		//		 so with room for one command per slot the queue can never fill up and pushing never has to wait on a stalled render thread
+		static constexpr size_t RenderCommandCapacity = 512;
+		static_assert(RenderCommandCapacity >= (MaxSimultaneousVoices + MaxLoadedSources), "Render command queue must fit one command per voice and source slot");
+		SPSCRingBuffer<RenderCommand, RenderCommandCapacity> RenderCommands;
 
 		// NOTE: Slot maps indexed into via handles
 		std::array<VoiceData, MaxSimultaneousVoices> VoicePool;
@@ -103,7 +338,10 @@ namespace Audio
 	public:
 		std::array<i16, (MaxBufferFrameCount * OutputChannelCount)> TempOutputBuffer = {};
 		std::array<f32, (MaxBufferFrameCount* OutputChannelCount)> MasterBuffer = {};
-		std::array<f32, (MaxBufferFrameCount* OutputChannelCount)> SoundGroupBuffer = {};
+		// NOTE: Sound group 0 renders directly into the MasterBuffer, so the first one is left unused
+		std::array<std::array<f32, (MaxBufferFrameCount* OutputChannelCount)>, MaxSoundGroups> SoundGroupBuffers = {};
+		std::array<f32, MaxBufferFrameCount> LimiterFramePeaks = {};
+		std::array<f32, MaxBufferFrameCount> LimiterFrameGains = {};
 		u32 CurrentBufferFrameSize = DefaultBufferFrameCount;
 		u32 TargetBufferFrameSize = DefaultBufferFrameCount;
 
@@ -123,6 +361,7 @@ namespace Audio
 		Time CallbackStreamTime = {}, LastCallbackStreamTime = {};
 
 		std::atomic<i64> TotalRenderedFrames = {};
+		std::atomic<i64> LateCallbackCount = {};
 
 	public:
 		VoiceData* TryGetVoiceData(VoiceHandle handle)
@@ -132,7 +371,11 @@ namespace Audio
 				return nullptr;
 
 			VoiceData* voiceData = &VoicePool[handleIndex];
-			return (voiceData->Flags & VoiceFlags_Alive) ? voiceData : nullptr;
+			const VoiceFlags flags = voiceData->Flags.load();
+			if (!(flags & VoiceFlags_Alive) || (flags & VoiceFlags_RemovePending))
+				return nullptr;
+
+			return (voiceData->Generation == VoiceHandleToGeneration(handle)) ? voiceData : nullptr;
 		}
 
 		enum class GetSourceDataParam : u8 { None, ValidateBuffer };
@@ -143,7 +386,7 @@ namespace Audio
 				return nullptr;
 
 			SourceData* sourceData = &LoadedSources[handleIndex];
-			if (!sourceData->SlotUsed)
+			if (sourceData->SlotState.load(std::memory_order_acquire) != SourceSlotState::Used || sourceData->Generation != SourceHandleToGeneration(handle))
 				return nullptr;
 
 			if (param == GetSourceDataParam::ValidateBuffer)
@@ -152,6 +395,91 @@ namespace Audio
 				return sourceData;
 		}
 
+		// NOTE: Safe to call from any thread, with the slot only becoming visible to the render thread once fully initialized
+		SourceHandle AddSourceToFreeSlot(std::string_view sourceName, PCMSampleBuffer&& bufferToMove, i64 decodedFrameCount)
+		{
+			for (HandleBaseType index = 0; index < static_cast<HandleBaseType>(LoadedSources.size()); index++)
+			{
+				SourceData& sourceData = LoadedSources[index];
+				SourceSlotState expectedState = SourceSlotState::Free;
+				if (!sourceData.SlotState.compare_exchange_strong(expectedState, SourceSlotState::Loading))
+					continue;
+
+				// NOTE: Also frees the previous buffer of this slot, which is no longer referenced by the render thread
+				sourceData.Buffer = std::move(bufferToMove);
+				sourceData.DecodedFrameCount = decodedFrameCount;
+				sourceData.CancelStreamingRequested = false;
+				sourceData.BaseVolume = 1.0f;
+				CopyStringViewIntoFixedBuffer(sourceData.Name, sourceName);
+				sourceData.SlotState.store(SourceSlotState::Used, std::memory_order_release);
+
+				return IndexToSourceHandle(index, sourceData.Generation);
+			}
+
+#if PEEPO_DEBUG
+			assert(!"Consider increasing MaxLoadedSources");
+#endif
+
+			return SourceHandle::Invalid;
+		}
+
+		// NOTE: Must be called before the source slot can be reused, since the decode thread would otherwise still be writing into its old buffer
+		void CancelAndWaitForSourceStreaming(SourceData& sourceData)
+		{
+			if (!sourceData.StreamingTask.valid())
+				return;
+
+			sourceData.CancelStreamingRequested = true;
+			sourceData.StreamingTask.get();
+		}
+
+		void PushRenderCommand(const RenderCommand& command)
+		{
+			const b8 wasPushed = RenderCommands.TryPush(command);
+			assert(wasPushed && "Render command queue should never be full, see RenderCommandCapacity");
+
+			// NOTE: Without a running stream there is no render thread to consume the command, so the main thread has to take its place
+			if (!IsStreamOpenRunning)
+				ExecuteRenderCommands();
+		}
+
+		void ExecuteRenderCommands()
+		{
+			RenderCommand command;
+			while (RenderCommands.TryPop(command))
+			{
+				switch (command.Type)
+				{
+				case RenderCommandType::RemoveVoice:
+				{
+					// NOTE: The voice might have already been removed on end by the render thread and then reused for a new voice by the main thread
+					VoiceData& voiceData = VoicePool[command.SlotIndex];
+					if (voiceData.Flags & VoiceFlags_RemovePending)
+					{
+						voiceData.Generation++;
+						voiceData.Flags = VoiceFlags_Dead;
+					}
+				} break;
+
+				case RenderCommandType::UnloadSource:
+				{
+					SourceData& sourceData = LoadedSources[command.SlotIndex];
+					assert(sourceData.SlotState == SourceSlotState::UnloadPending);
+
+					const SourceHandle unloadedSource = IndexToSourceHandle(command.SlotIndex, sourceData.Generation);
+					for (VoiceData& voice : VoicePool)
+					{
+						SourceHandle expectedSource = unloadedSource;
+						voice.Source.compare_exchange_strong(expectedSource, SourceHandle::Invalid);
+					}
+
+					sourceData.Generation++;
+					sourceData.SlotState.store(SourceSlotState::Free, std::memory_order_release);
+				} break;
+				}
+			}
+		}
+
 		f32 GetSourceBaseVolume(SourceHandle source)
 		{
 			SourceData* sourceData = TryGetSourceData(source, GetSourceDataParam::None);
@@ -211,10 +539,7 @@ namespace Audio
 
 			if (startVolume == endVolume)
 			{
-				for (i64 i = 0, n = (frameCount * OutputChannelCount); i < n;) {
-					for (u32 c = 0; c < OutputChannelCount; ++c, ++i)
-						outputBuffer[i] += TempOutputBuffer[i] * channelGain(c, voiceVolume);
-				}
+				MixStereoI16IntoF32(outputBuffer, TempOutputBuffer.data(), frameCount, channelGain(0, voiceVolume), channelGain(1, voiceVolume));
 			}
 			else
 			{
@@ -238,29 +563,29 @@ namespace Audio
 				else
 				{
 					const i64 voiceStartFrame = (voiceData.FramePosition - frameCount);
-
-					for (i64 f = 0, i = 0; f < frameCount; ++f)
-					{
-						const f32 frameVolume = SampleVolumeMapAt(volumeMapStartFrame, volumeMapEndFrame, startVolume, endVolume, voiceStartFrame + f) * voiceVolume;
-						for (u32 c = 0; c < OutputChannelCount; ++c, ++i)
-							outputBuffer[i] += TempOutputBuffer[i] * channelGain(c, frameVolume);
-					}
+					MixStereoI16IntoF32VolumeRamp(outputBuffer, TempOutputBuffer.data(), frameCount, voiceStartFrame,
+						volumeMapStartFrame, volumeMapEndFrame, startVolume, endVolume, channelGain(0, voiceVolume), channelGain(1, voiceVolume));
 				}
 			}
 		}
 
-		void CallbackProcessVoices(f32* outputBuffer, const u32 bufferFrameCount, const u32 bufferSampleCount, i32 soundGroup)
+		f32* GetSoundGroupRenderBuffer(i32 soundGroup)
 		{
-			const auto lock = std::scoped_lock(VoiceRenderMutex);
+			// NOTE: Any invalid sound group is treated as group 0
+			return (soundGroup > 0 && soundGroup < MaxSoundGroups) ? SoundGroupBuffers[soundGroup].data() : MasterBuffer.data();
+		}
 
+		// NOTE: Render all voices in a single pass over the pool, each into the buffer of its own sound group
+		void CallbackProcessVoices(const u32 bufferFrameCount, const u32 bufferSampleCount)
+		{
 			for (size_t voiceIndex = 0; voiceIndex < VoicePool.size(); voiceIndex++)
 			{
 				VoiceData& voiceData = VoicePool[voiceIndex];
-				if (i32 group = voiceData.SoundGroup; !(group == soundGroup || ((soundGroup == 0) && !(group >= 0 && group < MaxSoundGroups))))
-					continue;
-				if (!(voiceData.Flags & VoiceFlags_Alive))
+				if (const VoiceFlags flags = voiceData.Flags.load(std::memory_order_acquire); !(flags & VoiceFlags_Alive) || (flags & VoiceFlags_RemovePending))
 					continue;
 
+				f32* outputBuffer = GetSoundGroupRenderBuffer(voiceData.SoundGroup);
+
 				// TODO: Handle sample rate mismatch (by always setting variable playback speed?)
 				SourceData* sourceData = TryGetSourceData(voiceData.Source, GetSourceDataParam::ValidateBuffer);
 
@@ -293,6 +618,7 @@ namespace Audio
 				{
 					if (!playPastEnd && (voiceData.Flags & VoiceFlags_RemoveOnEnd))
 					{
+						voiceData.Generation++;
 						voiceData.Flags = VoiceFlags_Dead;
 						continue;
 					}
@@ -304,8 +630,7 @@ namespace Audio
 				}
 			}
 
-			if (soundGroup == 0)
-				TotalRenderedFrames += bufferFrameCount;
+			TotalRenderedFrames += bufferFrameCount;
 		}
 
 		void CallbackProcessNormalSpeedVoiceSamples(f32* outputBuffer, const u32 bufferFrameCount, const b8 playPastEnd, const b8 hasReachedEnd, VoiceData& voiceData, SourceData* sourceData)
@@ -317,10 +642,11 @@ namespace Audio
 			}
 
 			i64 framesRead = 0;
+			const i64 readableFrameCount = sourceData->DecodedFrameCount.load(std::memory_order_acquire);
 			if (sourceData->Buffer.ChannelCount != 0 && sourceData->Buffer.ChannelCount != OutputChannelCount)
-				framesRead = ChannelMixer.MixChannels(sourceData->Buffer, TempOutputBuffer.data(), voiceData.FramePosition, bufferFrameCount);
+				framesRead = ChannelMixer.MixChannels(sourceData->Buffer, TempOutputBuffer.data(), voiceData.FramePosition, bufferFrameCount, readableFrameCount);
 			else
-				framesRead = sourceData->Buffer.ReadAtOrFillSilence(voiceData.FramePosition, bufferFrameCount, TempOutputBuffer.data());
+				framesRead = sourceData->Buffer.ReadAtOrFillSilence(voiceData.FramePosition, bufferFrameCount, TempOutputBuffer.data(), readableFrameCount);
 
 			voiceData.FramePosition += framesRead;
 			if (hasReachedEnd && !playPastEnd)
@@ -345,8 +671,8 @@ namespace Audio
 			const f64 sampleDurationSec = (1.0 / static_cast<i64>(sampleRate)) * voiceData.PlaybackSpeed;
 			const i64 framesRead = static_cast<i64>(Round(bufferDurationSec / sampleDurationSec));
 
-			const size_t providerSampleCount = sourceData->Buffer.SampleCount();
 			const u32 providerChannelCount = sourceData->Buffer.ChannelCount;
+			const size_t providerSampleCount = static_cast<size_t>(Min(sourceData->DecodedFrameCount.load(std::memory_order_acquire), sourceData->Buffer.FrameCount) * providerChannelCount);
 
 			const f64 sampleRateF64 = static_cast<f64>(sampleRate);
 			const f64 voiceStartTimeSec = voiceData.TimePositionSec;
@@ -386,24 +712,12 @@ namespace Audio
 		{
 			const f32 limitMin = (std::is_integral_v<T> || soundGroup == 0) ? I16Min : SoundGroupVolumeLimit * I16Min;
 			const f32 limitMax = (std::is_integral_v<T> || soundGroup == 0) ? I16Max : SoundGroupVolumeLimit * I16Max;
-			std::array<f32, OutputChannelCount> frame;
-			for (size_t f = 0, i = 0; f < frameCount; ++f) {
-				// get gain for all channels first
-				f32 frameMaxValue = 0;
-				for (i32 c = 0; c < OutputChannelCount; ++c) {
-					frame[c] = mixedBuffer[i + c] * preGain;
-					if (std::abs(frame[c]) > std::abs(frameMaxValue))
-						frameMaxValue = frame[c];
-				}
-				auto gain = Limiter[soundGroup].GetGain(frameMaxValue, limitMin, limitMax);
-				// apply gain
-				for (i32 c = 0; c < OutputChannelCount; ++c, ++i) {
-					if constexpr (std::is_integral_v<T>)
-						outputBuffer[i] += ClampSampleI<T>(frame[c] * gain * postGain);
-					else
-						outputBuffer[i] += frame[c] * gain * postGain;
-				}
-			}
+
+			// NOTE: Only the limiter itself has to run frame by frame since its state depends on all previous frames
+			FindStereoFramePeaks(mixedBuffer, static_cast<i64>(frameCount), preGain, LimiterFramePeaks.data());
+			for (size_t f = 0; f < frameCount; f++)
+				LimiterFrameGains[f] = Limiter[soundGroup].GetGain(LimiterFramePeaks[f], limitMin, limitMax);
+			ApplyStereoFrameGainsAndMix(outputBuffer, mixedBuffer, LimiterFrameGains.data(), static_cast<i64>(frameCount), preGain, postGain);
 		}
 
 		void CallbackUpdateLastPlayedSamplesRingBuffer(i16* outputBuffer, const size_t frameCount)
@@ -457,21 +771,25 @@ namespace Audio
 			CallbackFrequency = (CallbackStreamTime - LastCallbackStreamTime);
 			LastCallbackStreamTime = CallbackStreamTime;
 
+			ExecuteRenderCommands();
+
 			CallbackClearOutBuffer(outputBuffer, bufferSampleCount);
 			CallbackClearOutBuffer(MasterBuffer.data(), bufferSampleCount);
 
-			// render each sound group separately, adjust volume, and then to master (except group 0)
-			for (i32 g = 1; g < MaxSoundGroups; ++g) {
-				CallbackClearOutBuffer(SoundGroupBuffer.data(), bufferSampleCount);
-				CallbackProcessVoices(SoundGroupBuffer.data(), bufferFrameCount, bufferSampleCount, g);
-				CallbackAdjustVolumeAndMix(MasterBuffer.data(), SoundGroupBuffer.data(), bufferFrameCount, 1, SoundGroupVolume[g], g);
-			}
+			// render each sound group separately (with sound group 0 rendering directly to master), adjust volume, and then to master
+			for (i32 g = 1; g < MaxSoundGroups; ++g)
+				CallbackClearOutBuffer(SoundGroupBuffers[g].data(), bufferSampleCount);
+			CallbackProcessVoices(bufferFrameCount, bufferSampleCount);
+			for (i32 g = 1; g < MaxSoundGroups; ++g)
+				CallbackAdjustVolumeAndMix(MasterBuffer.data(), SoundGroupBuffers[g].data(), bufferFrameCount, 1, SoundGroupVolume[g], g);
 
-			// sound group 0 (or any invalid group) renders directly to master
-			CallbackProcessVoices(MasterBuffer.data(), bufferFrameCount, bufferSampleCount, 0);
 			CallbackAdjustVolumeAndMix(outputBuffer, MasterBuffer.data(), bufferFrameCount, SoundGroupVolume[0], 1, 0);
 			CallbackUpdateLastPlayedSamplesRingBuffer(outputBuffer, bufferFrameCount);
-			CallbackUpdateCallbackDurationRingBuffer(stopwatch.Stop());
+
+			const Time renderDuration = stopwatch.Stop();
+			CallbackUpdateCallbackDurationRingBuffer(renderDuration);
+			if (renderDuration > FramesToTime(bufferFrameCount, OutputSampleRate))
+				LateCallbackCount++;
 		}
 	};
 
@@ -500,7 +818,11 @@ namespace Audio
 	void AudioEngine::ApplicationShutdown()
 	{
 		if (impl != nullptr)
+		{
 			StopCloseStream();
+			for (SourceData& sourceData : impl->LoadedSources)
+				impl->CancelAndWaitForSourceStreaming(sourceData);
+		}
 		impl = nullptr;
 	}
 
@@ -546,6 +868,7 @@ namespace Audio
 		impl->StreamTimeStopwatch.Stop();
 
 		impl->IsStreamOpenRunning = false;
+		impl->ExecuteRenderCommands();
 	}
 
 	void AudioEngine::EnsureStreamRunning()
@@ -586,27 +909,100 @@ namespace Audio
 
 	SourceHandle AudioEngine::LoadSourceFromBufferMove(std::string_view sourceName, PCMSampleBuffer bufferToMove)
 	{
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
-		for (HandleBaseType index = 0; index < static_cast<HandleBaseType>(impl->LoadedSources.size()); index++)
-		{
-			const SourceHandle handleIt = IndexToSourceHandle(index);
-			SourceData& sourceData = impl->LoadedSources[index];
-			if (sourceData.SlotUsed)
-				continue;
+		const i64 decodedFrameCount = bufferToMove.FrameCount;
+		return impl->AddSourceToFreeSlot(sourceName, std::move(bufferToMove), decodedFrameCount);
+	}
 
-			sourceData.SlotUsed = true;
-			sourceData.Buffer = std::move(bufferToMove);
-			sourceData.BaseVolume = 1.0f;
-			CopyStringViewIntoFixedBuffer(sourceData.Name, sourceName);
+	SourceHandle AudioEngine::LoadSourceFromFileContentStreaming(std::string_view fileName, std::unique_ptr<u8[]> fileContent, size_t fileSize)
+	{
+		auto decoder = std::make_unique<StreamingFileDecoder>();
+		if (decoder->OpenFromMemory(fileName, fileContent.get(), fileSize) != DecodeFileResult::FeelsGoodMan || decoder->GetChannelCount() == 0 || decoder->GetSampleRate() == 0)
+			return SourceHandle::Invalid;
 
-			return static_cast<SourceHandle>(index);
+		// NOTE: Without knowing the length upfront there is no buffer to stream into, so fall back to decoding everything in one go
+		if (decoder->GetFrameCount() <= 0)
+		{
+			decoder = nullptr;
+			PCMSampleBuffer sampleBuffer;
+			if (DecodeEntireFile(fileName, fileContent.get(), fileSize, sampleBuffer) == DecodeFileResult::Sadge)
+				return SourceHandle::Invalid;
+			if (sampleBuffer.SampleRate != OutputSampleRate)
+				PolyphaseResampleBuffer(sampleBuffer.InterleavedSamples, sampleBuffer.FrameCount, sampleBuffer.SampleRate, sampleBuffer.ChannelCount, OutputSampleRate);
+			return LoadSourceFromBufferMove(fileName, std::move(sampleBuffer));
 		}
 
-#if PEEPO_DEBUG
-		assert(!"Consider increasing MaxLoadedSources");
-#endif
+		const u32 channelCount = decoder->GetChannelCount();
+		const u32 sourceSampleRate = decoder->GetSampleRate();
+		const i64 sourceFrameCount = decoder->GetFrameCount();
+
+		PCMSampleBuffer sampleBuffer = {};
+		sampleBuffer.ChannelCount = channelCount;
+		sampleBuffer.SampleRate = OutputSampleRate;
+		sampleBuffer.FrameCount = (sourceSampleRate == OutputSampleRate) ? sourceFrameCount : static_cast<i64>(GetResampledFrameCount(static_cast<size_t>(sourceFrameCount), sourceSampleRate, OutputSampleRate));
+		sampleBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[sampleBuffer.SampleCount()]);
+
+		const SourceHandle source = impl->AddSourceToFreeSlot(fileName, std::move(sampleBuffer), 0);
+		if (source == SourceHandle::Invalid)
+			return SourceHandle::Invalid;
+
+		// NOTE: The buffer pointer stays stable while the source slot is in use and the slot can't be reused before this task has finished
+		SourceData& sourceData = impl->LoadedSources[SourceHandleToIndex(source)];
+		sourceData.StreamingTask = std::async(std::launch::async, [&sourceData, sourceSampleRate, sourceFrameCount, decoder = std::move(decoder), fileContent = std::move(fileContent)]()
+		{
+			i16* const outSamples = sourceData.Buffer.InterleavedSamples.GetMutable();
+			const u32 channelCount = sourceData.Buffer.ChannelCount;
+			const i64 outFrameCount = sourceData.Buffer.FrameCount;
+			i64 outFramesWritten = 0;
+
+			if (sourceSampleRate == OutputSampleRate)
+			{
+				// NOTE: Decode straight into the final buffer without any intermediate copies
+				while (outFramesWritten < outFrameCount && !sourceData.CancelStreamingRequested)
+				{
+					const i64 framesDecoded = decoder->DecodeNextFrames(Min(StreamingDecodeChunkFrameCount, outFrameCount - outFramesWritten), &outSamples[outFramesWritten * channelCount]);
+					if (framesDecoded <= 0)
+						break;
+
+					outFramesWritten += framesDecoded;
+					sourceData.DecodedFrameCount.store(outFramesWritten, std::memory_order_release);
+				}
+			}
+			else
+			{
+				// NOTE: Resampled chunk by chunk as it is being decoded, giving the exact same output as resampling the entire song upfront
+				PolyphaseResampler resampler { channelCount, sourceSampleRate, OutputSampleRate, sourceFrameCount };
+				auto chunkSamples = std::unique_ptr<i16[]>(new i16[StreamingDecodeChunkFrameCount * channelCount]);
+
+				while (outFramesWritten < outFrameCount && !sourceData.CancelStreamingRequested)
+				{
+					const i64 framesDecoded = decoder->DecodeNextFrames(StreamingDecodeChunkFrameCount, chunkSamples.get());
+					outFramesWritten = resampler.ResampleChunk(chunkSamples.get(), Max<i64>(framesDecoded, 0), (framesDecoded <= 0), outSamples);
+					sourceData.DecodedFrameCount.store(outFramesWritten, std::memory_order_release);
+					if (framesDecoded <= 0)
+						break;
+				}
+			}
+
+			// NOTE: The length reported by the file header isn't always exact so fill any remaining frames with silence
+			if (outFramesWritten < outFrameCount)
+				std::fill(&outSamples[outFramesWritten * channelCount], &outSamples[outFrameCount * channelCount], static_cast<i16>(0));
+			sourceData.DecodedFrameCount.store(outFrameCount, std::memory_order_release);
+		});
+
+		return source;
+	}
+
+	b8 AudioEngine::GetIsSourceStreamingFinished(SourceHandle source)
+	{
+		const SourceData* sourceData = impl->TryGetSourceData(source, Impl::GetSourceDataParam::None);
+		return (sourceData == nullptr) || (sourceData->DecodedFrameCount.load(std::memory_order_acquire) >= sourceData->Buffer.FrameCount);
+	}
 
-		return SourceHandle::Invalid;
+	void AudioEngine::WaitForSourceStreamingToFinish(SourceHandle source)
+	{
+		SourceData* sourceData = impl->TryGetSourceData(source, Impl::GetSourceDataParam::None);
+		if (sourceData != nullptr && sourceData->StreamingTask.valid())
+			sourceData->StreamingTask.wait();
 	}
 
 	void AudioEngine::UnloadSource(SourceHandle source)
@@ -614,17 +1010,15 @@ namespace Audio
 		if (source == SourceHandle::Invalid)
 			return;
 
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
+		if (SourceData* sourceData = impl->TryGetSourceData(source, Impl::GetSourceDataParam::None); sourceData != nullptr)
+			impl->CancelAndWaitForSourceStreaming(*sourceData);
+
 		SourceData* sourceData = impl->TryGetSourceData(source, Impl::GetSourceDataParam::None);
 		if (sourceData == nullptr)
 			return;
 
-		sourceData->SlotUsed = false;
-		for (VoiceData& voice : impl->VoicePool)
-		{
-			if ((voice.Flags & VoiceFlags_Alive) && voice.Source == source)
-				voice.Source = SourceHandle::Invalid;
-		}
+		sourceData->SlotState = SourceSlotState::UnloadPending;
+		impl->PushRenderCommand(RenderCommand { RenderCommandType::UnloadSource, SourceHandleToIndex(source) });
 	}
 
 	const PCMSampleBuffer* AudioEngine::GetSourceSampleBufferView(SourceHandle source)
@@ -655,18 +1049,13 @@ namespace Audio
 
 	VoiceHandle AudioEngine::AddVoice(SourceHandle source, std::string_view name, b8 playing, f32 volume, f32 pan, b8 playPastEnd, i32 soundGroup)
 	{
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
-
 		for (size_t i = 0; i < impl->VoicePool.size(); i++)
 		{
 			VoiceData& voiceToUpdate = impl->VoicePool[i];
 			if (voiceToUpdate.Flags & VoiceFlags_Alive)
 				continue;
 
-			voiceToUpdate.Flags = VoiceFlags_Alive;
-			if (playing) voiceToUpdate.Flags |= VoiceFlags_Playing;
-			if (playPastEnd) voiceToUpdate.Flags |= VoiceFlags_PlayPastEnd;
-
+			// NOTE: Dead slots are never touched by the render thread, so only the final flags store has to be ordered
 			voiceToUpdate.Source = source;
 			voiceToUpdate.SoundGroup = soundGroup;
 			voiceToUpdate.Volume = volume;
@@ -676,7 +1065,12 @@ namespace Audio
 			voiceToUpdate.VolumeMap.EndVolume = 0.0f;
 			CopyStringViewIntoFixedBuffer(voiceToUpdate.Name, name);
 
-			return static_cast<VoiceHandle>(i);
+			VoiceFlags newFlags = VoiceFlags_Alive;
+			if (playing) newFlags |= VoiceFlags_Playing;
+			if (playPastEnd) newFlags |= VoiceFlags_PlayPastEnd;
+			voiceToUpdate.Flags.store(newFlags, std::memory_order_release);
+
+			return IndexToVoiceHandle(static_cast<HandleBaseType>(i), voiceToUpdate.Generation);
 		}
 
 #if PEEPO_DEBUG
@@ -691,12 +1085,12 @@ namespace Audio
 		if (voice == VoiceHandle::Invalid)
 			return;
 
-		// TODO: Think these locks through again
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
-
 		VoiceData* voiceData = impl->TryGetVoiceData(voice);
-		if (voiceData != nullptr)
-			voiceData->Flags = VoiceFlags_Dead;
+		if (voiceData == nullptr)
+			return;
+
+		voiceData->Flags |= VoiceFlags_RemovePending;
+		impl->PushRenderCommand(RenderCommand { RenderCommandType::RemoveVoice, VoiceHandleToIndex(voice) });
 	}
 
 	void AudioEngine::PlayOneShotSound(SourceHandle source, std::string_view name, f32 volume, f32 pan, i32 soundGroup)
@@ -704,14 +1098,11 @@ namespace Audio
 		if (source == SourceHandle::Invalid)
 			return;
 
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
-
 		for (VoiceData& voiceToUpdate : impl->VoicePool)
 		{
 			if (voiceToUpdate.Flags & VoiceFlags_Alive)
 				continue;
 
-			voiceToUpdate.Flags = VoiceFlags_Alive | VoiceFlags_Playing | VoiceFlags_RemoveOnEnd;
 			voiceToUpdate.Source = source;
 			voiceToUpdate.SoundGroup = soundGroup;
 			voiceToUpdate.Volume = volume;
@@ -720,6 +1111,7 @@ namespace Audio
 			voiceToUpdate.VolumeMap.StartVolume = 0.0f;
 			voiceToUpdate.VolumeMap.EndVolume = 0.0f;
 			CopyStringViewIntoFixedBuffer(voiceToUpdate.Name, name);
+			voiceToUpdate.Flags.store(VoiceFlags_Alive | VoiceFlags_Playing | VoiceFlags_RemoveOnEnd, std::memory_order_release);
 			return;
 		}
 	}
@@ -747,6 +1139,11 @@ namespace Audio
 		}
 	}
 
+	OfflineBackend* AudioEngine::GetOfflineBackend()
+	{
+		return (impl->CurrentBackendType == Backend::Offline) ? static_cast<OfflineBackend*>(impl->CurrentBackend.get()) : nullptr;
+	}
+
 	b8 AudioEngine::GetIsStreamOpenRunning() const
 	{
 		return impl->IsStreamOpenRunning;
@@ -810,14 +1207,19 @@ namespace Audio
 		return impl->TotalRenderedFrames;
 	}
 
+	i64 AudioEngine::DebugGetLateCallbackCount() const
+	{
+		return impl->LateCallbackCount;
+	}
+
 	AudioEngine::DebugVoicesArray AudioEngine::DebugGetAllActiveVoices()
 	{
 		DebugVoicesArray out = {};
 		for (size_t i = 0; i < impl->VoicePool.size(); i++)
 		{
 			const VoiceData& voice = impl->VoicePool[i];
-			if (voice.Flags & VoiceFlags_Alive)
-				out.Slots[out.Count++] = static_cast<VoiceHandle>(i);
+			if ((voice.Flags & VoiceFlags_Alive) && !(voice.Flags & VoiceFlags_RemovePending))
+				out.Slots[out.Count++] = IndexToVoiceHandle(static_cast<HandleBaseType>(i), voice.Generation);
 		}
 		return out;
 	}
@@ -828,8 +1230,8 @@ namespace Audio
 		for (size_t i = 0; i < impl->LoadedSources.size(); i++)
 		{
 			const SourceData& source = impl->LoadedSources[i];
-			if (source.SlotUsed)
-				out.Slots[out.Count++] = static_cast<SourceHandle>(i);
+			if (source.SlotState == SourceSlotState::Used)
+				out.Slots[out.Count++] = IndexToSourceHandle(static_cast<HandleBaseType>(i), source.Generation);
 		}
 		return out;
 	}
@@ -1010,12 +1412,6 @@ namespace Audio
 
 	void Voice::SetIsPlaying(b8 value)
 	{
-		// TODO: Allow manual render thread locking from outside code to then be used for playback sounds
-		//		 This should then become lockfree again!
-
-		// HACK: Prevent randomly "stacking" playback button sounds... need to find a better solution, definitely don't want any locks like this
-		const auto lock = std::scoped_lock(Engine.impl->VoiceRenderMutex);
-
 		SetInternalFlag(VoiceFlags_Playing, value);
 	}
 
@@ -15,11 +15,11 @@
 //		 "Voice"  -> Instance of a source, rendered to the output stream
 namespace Audio
 {
-	// NOTE: Opaque types for referncing data stored in the AudioEngine, internally interpreted as in index.
-	//		 A genertion ID could easily be tagged on for extra safety but so far it hasn't felt necessary
-	using HandleBaseType = u16;
-	enum class VoiceHandle : HandleBaseType { Invalid = 0xFFFF };
-	enum class SourceHandle : HandleBaseType { Invalid = 0xFFFF };
+	// NOTE: Opaque types for referncing data stored in the AudioEngine, internally interpreted as a slot index in the lower 16 bits
+	//		 and a generation ID in the upper 16 bits. The generation is incremented whenever a slot is freed so that stale handles are rejected
+	using HandleBaseType = u32;
+	enum class VoiceHandle : HandleBaseType { Invalid = 0xFFFFFFFF };
+	enum class SourceHandle : HandleBaseType { Invalid = 0xFFFFFFFF };
 
 	// NOTE: Lightweight non-owning wrapper around a VoiceHandle providing a convenient OOP interface
 	struct Voice
@@ -80,10 +80,14 @@ namespace Audio
 		void SetInternalFlag(u16 flag, b8 value);
 	};
 
+	class OfflineBackend;
+
 	enum class Backend : u8
 	{
 		WASAPI_Shared,
 		WASAPI_Exclusive,
+		// NOTE: No audio device, see OfflineBackend
+		Offline,
 		Count,
 		// TEMP: Switching to shared during early developement where there isn't actually any charting to do yet
 		// Default = WASAPI_Exclusive,
@@ -94,6 +98,7 @@ namespace Audio
 	{
 		"WASAPI (Shared)",
 		"WASAPI (Exclusive)",
+		"Offline (No Device)",
 	};
 
 	enum class PanLaw : u8
@@ -139,6 +144,8 @@ namespace Audio
 		static constexpr u32 MinBufferFrameCount = 8;
 		static constexpr u32 MaxBufferFrameCount = OutputSampleRate;
 
+		static constexpr i64 StreamingDecodeChunkFrameCount = 8192;
+
 		static constexpr size_t CallbackDurationRingBufferSize = 64;
 		static constexpr size_t LastPlayedSamplesRingBufferFrameCount = MaxBufferFrameCount;
 
@@ -161,8 +168,18 @@ namespace Audio
 		SourceHandle LoadSourceFromFileSync(std::string_view filePath);
 		SourceHandle LoadSourceFromFileContentSync(std::string_view fileName, const void* fileContent, size_t fileSize);
 		SourceHandle LoadSourceFromBufferMove(std::string_view sourceName, PCMSampleBuffer bufferToMove);
+
+		// NOTE: Only to be called from the main thread. The handle becomes invalid immediately
+		//		 but the slot is only freed once the render thread has processed the request
 		void UnloadSource(SourceHandle source);
 
+		// NOTE: Only decodes the file header upfront and the rest in fixed size chunks on a background thread,
+		//		 so that the source can already be played back long before the entire file has been decoded.
+		//		 Always resampled to the OutputSampleRate. The sample buffer view is only complete once streaming has finished
+		SourceHandle LoadSourceFromFileContentStreaming(std::string_view fileName, std::unique_ptr<u8[]> fileContent, size_t fileSize);
+		b8 GetIsSourceStreamingFinished(SourceHandle source);
+		void WaitForSourceStreamingToFinish(SourceHandle source);
+
 		const PCMSampleBuffer* GetSourceSampleBufferView(SourceHandle source);
 
 		f32 GetSourceBaseVolume(SourceHandle source);
@@ -171,7 +188,7 @@ namespace Audio
 		std::string_view GetSourceName(SourceHandle source);
 		void SetSourceName(SourceHandle source, std::string_view newName);
 
-		// NOTE: Add a voice and keep a handle to it
+		// NOTE: Add a voice and keep a handle to it, only to be called from the main thread (same for removing)
 		VoiceHandle AddVoice(SourceHandle source, std::string_view name, b8 playing, f32 volume = MaxVolume, f32 pan = 0, b8 playPastEnd = false, i32 soundGroup = 0);
 		void RemoveVoice(VoiceHandle voice);
 
@@ -182,6 +199,9 @@ namespace Audio
 		Backend GetBackend() const;
 		void SetBackend(Backend value);
 
+		// NOTE: Only non-null while using Backend::Offline, to drive rendering manually and access the captured output
+		OfflineBackend* GetOfflineBackend();
+
 		b8 GetIsStreamOpenRunning() const;
 		b8 GetAllVoicesAreIdle() const;
 
@@ -200,6 +220,9 @@ namespace Audio
 	public:
 		i64 DebugGetTotalRenderedFrames() const;
 
+		// NOTE: Number of callbacks that took longer to render than the duration of the audio they produced, since startup
+		i64 DebugGetLateCallbackCount() const;
+
 		struct DebugVoicesArray { Voice Slots[MaxSimultaneousVoices]; size_t Count; };
 		struct DebugSourcesArray { SourceHandle Slots[MaxLoadedSources]; size_t Count; };
 		DebugVoicesArray DebugGetAllActiveVoices();
@@ -17,7 +17,17 @@
 
 // TODO: Forward declare because visual studio is having a stroke parsing the C header (something about the typedef union { ... } Floor; ???)
 //		 even though it was working perfectly fine in a different C++ project before :PeepoShrug:
-extern "C" int stb_vorbis_decode_memory(const unsigned char* mem, int len, int* channels, int* sample_rate, short** output);
+extern "C"
+{
+	typedef struct stb_vorbis stb_vorbis;
+	typedef struct { unsigned int sample_rate; int channels; unsigned int setup_memory_required, setup_temp_memory_required, temp_memory_required; int max_frame_size; } stb_vorbis_info;
+	typedef struct stb_vorbis_alloc stb_vorbis_alloc;
+	stb_vorbis* stb_vorbis_open_memory(const unsigned char* data, int len, int* error, const stb_vorbis_alloc* alloc_buffer);
+	stb_vorbis_info stb_vorbis_get_info(stb_vorbis* f);
+	unsigned int stb_vorbis_stream_length_in_samples(stb_vorbis* f);
+	int stb_vorbis_get_samples_short_interleaved(stb_vorbis* f, int channels, short* buffer, int num_shorts);
+	void stb_vorbis_close(stb_vorbis* f);
+}
 
 namespace Audio
 {
@@ -35,114 +45,195 @@ namespace Audio
 	{
 		outBuffer = {};
 
+		// TODO: Check for magic bytes instead, though shouldn't really matter for now
+		StreamingFileDecoder decoder;
+		if (decoder.OpenFromMemory(fileNameWithExtension, inFileContent, inFileSize) != DecodeFileResult::FeelsGoodMan)
+			return DecodeFileResult::Sadge;
+
+		const u32 channelCount = decoder.GetChannelCount();
+		if (channelCount == 0 || decoder.GetSampleRate() == 0)
+			return DecodeFileResult::Sadge;
+
+		// NOTE: Decode straight into the final buffer instead of letting each library allocate its own and then copying it over.
+		//		 The buffer only ever has to grow (and be copied) if the length reported by the file header is unknown or too short
+		static constexpr i64 fallbackCapacityFrameCount = (1 << 16);
+		static constexpr i64 endOfFileProbeFrameCount = 1024;
+		i64 capacityFrameCount = (decoder.GetFrameCount() > 0) ? decoder.GetFrameCount() : fallbackCapacityFrameCount;
+		auto interleavedSamples = std::unique_ptr<i16[]>(new i16[capacityFrameCount * channelCount]);
+		if (interleavedSamples == nullptr)
+			return DecodeFileResult::Sadge;
+
+		i64 framesDecoded = 0;
+		std::unique_ptr<i16[]> probeSamples = nullptr;
+		while (true)
+		{
+			if (framesDecoded < capacityFrameCount)
+			{
+				const i64 framesRead = decoder.DecodeNextFrames(capacityFrameCount - framesDecoded, &interleavedSamples[framesDecoded * channelCount]);
+				if (framesRead <= 0)
+					break;
+				framesDecoded += framesRead;
+				continue;
+			}
+
+			// NOTE: Check if there is anything left before having to grow the buffer, which for accurate file headers is never the case
+			if (probeSamples == nullptr)
+				probeSamples = std::unique_ptr<i16[]>(new i16[endOfFileProbeFrameCount * channelCount]);
+			const i64 probeFramesRead = decoder.DecodeNextFrames(endOfFileProbeFrameCount, probeSamples.get());
+			if (probeFramesRead <= 0)
+				break;
+
+			capacityFrameCount = (capacityFrameCount + (capacityFrameCount / 2) + probeFramesRead);
+			auto grownSamples = std::unique_ptr<i16[]>(new i16[capacityFrameCount * channelCount]);
+			if (grownSamples == nullptr)
+				return DecodeFileResult::Sadge;
+
+			std::copy(interleavedSamples.get(), interleavedSamples.get() + (framesDecoded * channelCount), grownSamples.get());
+			std::copy(probeSamples.get(), probeSamples.get() + (probeFramesRead * channelCount), grownSamples.get() + (framesDecoded * channelCount));
+			interleavedSamples = std::move(grownSamples);
+			framesDecoded += probeFramesRead;
+		}
+
+		if (framesDecoded <= 0)
+			return DecodeFileResult::Sadge;
+
+		outBuffer.ChannelCount = channelCount;
+		outBuffer.SampleRate = decoder.GetSampleRate();
+		outBuffer.FrameCount = framesDecoded;
+		outBuffer.InterleavedSamples = std::move(interleavedSamples);
+		return DecodeFileResult::FeelsGoodMan;
+	}
+
+	struct StreamingFileDecoder::Impl
+	{
+		SupportedFileFormat Format = SupportedFileFormat::Count;
+		u32 ChannelCount = 0;
+		u32 SampleRate = 0;
+		i64 FrameCount = 0;
+
+		::stb_vorbis* Vorbis = nullptr;
+		::drwav WAV = {};
+		::drflac* FLAC = nullptr;
+		::drmp3 MP3 = {};
+	};
+
+	StreamingFileDecoder::StreamingFileDecoder() = default;
+	StreamingFileDecoder::~StreamingFileDecoder() { Close(); }
+
+	DecodeFileResult StreamingFileDecoder::OpenFromMemory(std::string_view fileNameWithExtension, const void* inFileContent, size_t inFileSize)
+	{
+		Close();
+
 		if (inFileContent == nullptr || inFileSize == 0)
 			return DecodeFileResult::Sadge;
 
-		// TODO: Check for magic bytes instead, though shouldn't really matter for now
 		const SupportedFileFormat fileFormat = TryToDetermineFileFormatFromExtension(fileNameWithExtension);
 		if (fileFormat == SupportedFileFormat::Count)
 			return DecodeFileResult::Sadge;
 
+		impl = std::make_unique<Impl>();
+		impl->Format = fileFormat;
+
 		switch (fileFormat)
 		{
 		case SupportedFileFormat::OggVorbis:
 		{
-			i32 outChannels = {};
-			i32 outSampleRate = {};
-			i16* outSamplesI16 = {};
-			i32 outFrameCount = ::stb_vorbis_decode_memory(static_cast<const unsigned char*>(inFileContent), static_cast<int>(inFileSize), &outChannels, &outSampleRate, &outSamplesI16);
-			defer { ::free(outSamplesI16); };
-			if (outSamplesI16 == nullptr || outFrameCount < 0)
-				return DecodeFileResult::Sadge;
-
-			const size_t totalSampleCount = static_cast<size_t>(outFrameCount * outChannels);
-			outBuffer.ChannelCount = static_cast<u32>(outChannels);
-			outBuffer.SampleRate = static_cast<u32>(outSampleRate);
-			outBuffer.FrameCount = static_cast<i64>(outFrameCount);
-			// outBuffer.InterleavedSamples = std::make_unique<i16[]>(totalSampleCount);
-			outBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[totalSampleCount]);
-			if (outBuffer.InterleavedSamples == nullptr)
-				return DecodeFileResult::Sadge;
-
-			// TODO: Prevent copy by.. overwriting malloc? or manually read chunks
-			::memcpy(outBuffer.InterleavedSamples.get(), outSamplesI16, totalSampleCount * sizeof(i16));
-		} break;
+			i32 outError = {};
+			impl->Vorbis = ::stb_vorbis_open_memory(static_cast<const unsigned char*>(inFileContent), static_cast<int>(inFileSize), &outError, nullptr);
+			if (impl->Vorbis == nullptr)
+				break;
+
+			const ::stb_vorbis_info info = ::stb_vorbis_get_info(impl->Vorbis);
+			impl->ChannelCount = static_cast<u32>(info.channels);
+			impl->SampleRate = info.sample_rate;
+			impl->FrameCount = static_cast<i64>(::stb_vorbis_stream_length_in_samples(impl->Vorbis));
+			return DecodeFileResult::FeelsGoodMan;
+		}
 
 		case SupportedFileFormat::WAV:
 		{
-			u32 outChannels = {};
-			u32 outSampleRate = {};
-			u64 outFrameCount = {};
-			i16* outSamplesI16 = ::drwav_open_memory_and_read_pcm_frames_s16(inFileContent, inFileSize, &outChannels, &outSampleRate, &outFrameCount, nullptr);
-			defer { ::drwav_free(outSamplesI16, nullptr); };
-			if (outSamplesI16 == nullptr)
-				return DecodeFileResult::Sadge;
+			if (!::drwav_init_memory(&impl->WAV, inFileContent, inFileSize, nullptr))
+				break;
 
-			const size_t totalSampleCount = static_cast<size_t>(outFrameCount * outChannels);
-			outBuffer.ChannelCount = static_cast<u32>(outChannels);
-			outBuffer.SampleRate = static_cast<u32>(outSampleRate);
-			outBuffer.FrameCount = static_cast<i64>(outFrameCount);
-			// outBuffer.InterleavedSamples = std::make_unique<i16[]>(totalSampleCount);
-			outBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[totalSampleCount]);
-			if (outBuffer.InterleavedSamples == nullptr)
-				return DecodeFileResult::Sadge;
-
-			// TODO: Prevent copy by passing down custom allocator or manually read chunks
-			::memcpy(outBuffer.InterleavedSamples.get(), outSamplesI16, totalSampleCount * sizeof(i16));
-		} break;
+			impl->ChannelCount = static_cast<u32>(impl->WAV.channels);
+			impl->SampleRate = static_cast<u32>(impl->WAV.sampleRate);
+			impl->FrameCount = static_cast<i64>(impl->WAV.totalPCMFrameCount);
+			return DecodeFileResult::FeelsGoodMan;
+		}
 
 		case SupportedFileFormat::FLAC:
 		{
-			u32 outChannels = {};
-			u32 outSampleRate = {};
-			u64 outFrameCount = {};
-			i16* outSamplesI16 = ::drflac_open_memory_and_read_pcm_frames_s16(inFileContent, inFileSize, &outChannels, &outSampleRate, &outFrameCount, nullptr);
-			defer { ::drflac_free(outSamplesI16, nullptr); };
-			if (outSamplesI16 == nullptr)
-				return DecodeFileResult::Sadge;
+			impl->FLAC = ::drflac_open_memory(inFileContent, inFileSize, nullptr);
+			if (impl->FLAC == nullptr)
+				break;
+
+			impl->ChannelCount = static_cast<u32>(impl->FLAC->channels);
+			impl->SampleRate = static_cast<u32>(impl->FLAC->sampleRate);
+			impl->FrameCount = static_cast<i64>(impl->FLAC->totalPCMFrameCount);
+			return DecodeFileResult::FeelsGoodMan;
+		}
 
-			const size_t totalSampleCount = static_cast<size_t>(outFrameCount * outChannels);
-			outBuffer.ChannelCount = static_cast<u32>(outChannels);
-			outBuffer.SampleRate = static_cast<u32>(outSampleRate);
-			outBuffer.FrameCount = static_cast<i64>(outFrameCount);
-			// outBuffer.InterleavedSamples = std::make_unique<i16[]>(totalSampleCount);
-			outBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[totalSampleCount]);
-			if (outBuffer.InterleavedSamples == nullptr)
-				return DecodeFileResult::Sadge;
+		case SupportedFileFormat::MP3:
+		{
+			if (!::drmp3_init_memory(&impl->MP3, inFileContent, inFileSize, nullptr))
+				break;
+
+			impl->ChannelCount = static_cast<u32>(impl->MP3.channels);
+			impl->SampleRate = static_cast<u32>(impl->MP3.sampleRate);
+			// NOTE: MP3s don't store their length so this has to scan over all frame headers (without decoding) and seek back to the start
+			impl->FrameCount = static_cast<i64>(::drmp3_get_pcm_frame_count(&impl->MP3));
+			return DecodeFileResult::FeelsGoodMan;
+		}
 
-			// TODO: Prevent copy by passing down custom allocator or manually read chunks
-			::memcpy(outBuffer.InterleavedSamples.get(), outSamplesI16, totalSampleCount * sizeof(i16));
+		default:
+		{
+			assert(!"Unhandled file format switch case");
 		} break;
+		}
 
-		case SupportedFileFormat::MP3:
+		impl = nullptr;
+		return DecodeFileResult::Sadge;
+	}
+
+	void StreamingFileDecoder::Close()
+	{
+		if (impl == nullptr)
+			return;
+
+		switch (impl->Format)
 		{
-			::drmp3_config outConfig = {};
-			::drmp3_uint64 outFrameCount = {};
-			::drmp3d_sample_t* outSamplesI16 = ::drmp3_open_memory_and_read_pcm_frames_s16(inFileContent, inFileSize, &outConfig, &outFrameCount, nullptr);
-			defer { ::drmp3_free(outSamplesI16, nullptr); };
-			if (outSamplesI16 == nullptr)
-				return DecodeFileResult::Sadge;
+		case SupportedFileFormat::OggVorbis: { if (impl->Vorbis != nullptr) ::stb_vorbis_close(impl->Vorbis); } break;
+		case SupportedFileFormat::WAV: { ::drwav_uninit(&impl->WAV); } break;
+		case SupportedFileFormat::FLAC: { if (impl->FLAC != nullptr) ::drflac_close(impl->FLAC); } break;
+		case SupportedFileFormat::MP3: { ::drmp3_uninit(&impl->MP3); } break;
+		default: { assert(!"Unhandled file format switch case"); } break;
+		}
+		impl = nullptr;
+	}
 
-			const size_t totalSampleCount = static_cast<size_t>(outFrameCount * outConfig.channels);
-			outBuffer.ChannelCount = static_cast<u32>(outConfig.channels);
-			outBuffer.SampleRate = static_cast<u32>(outConfig.sampleRate);
-			outBuffer.FrameCount = static_cast<i64>(outFrameCount);
-			// outBuffer.InterleavedSamples = std::make_unique<i16[]>(totalSampleCount);
-			outBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[totalSampleCount]);
-			if (outBuffer.InterleavedSamples == nullptr)
-				return DecodeFileResult::Sadge;
+	b8 StreamingFileDecoder::GetIsOpen() const { return (impl != nullptr); }
+	u32 StreamingFileDecoder::GetChannelCount() const { return (impl != nullptr) ? impl->ChannelCount : 0; }
+	u32 StreamingFileDecoder::GetSampleRate() const { return (impl != nullptr) ? impl->SampleRate : 0; }
+	i64 StreamingFileDecoder::GetFrameCount() const { return (impl != nullptr) ? impl->FrameCount : 0; }
 
-			// TODO: Prevent copy by passing down custom allocator or manually read chunks
-			::memcpy(outBuffer.InterleavedSamples.get(), outSamplesI16, totalSampleCount * sizeof(i16));
-		} break;
+	i64 StreamingFileDecoder::DecodeNextFrames(i64 maxFrameCount, i16 outSamples[])
+	{
+		if (impl == nullptr || maxFrameCount <= 0)
+			return 0;
 
-		default:
+		switch (impl->Format)
 		{
+		case SupportedFileFormat::OggVorbis:
+			return static_cast<i64>(::stb_vorbis_get_samples_short_interleaved(impl->Vorbis, static_cast<int>(impl->ChannelCount), outSamples, static_cast<int>(maxFrameCount * impl->ChannelCount)));
+		case SupportedFileFormat::WAV:
+			return static_cast<i64>(::drwav_read_pcm_frames_s16(&impl->WAV, static_cast<::drwav_uint64>(maxFrameCount), outSamples));
+		case SupportedFileFormat::FLAC:
+			return static_cast<i64>(::drflac_read_pcm_frames_s16(impl->FLAC, static_cast<::drflac_uint64>(maxFrameCount), outSamples));
+		case SupportedFileFormat::MP3:
+			return static_cast<i64>(::drmp3_read_pcm_frames_s16(&impl->MP3, static_cast<::drmp3_uint64>(maxFrameCount), outSamples));
+		default:
 			assert(!"Unhandled file format switch case");
-			return DecodeFileResult::Sadge;
-		} break;
+			return 0;
 		}
-
-		return DecodeFileResult::FeelsGoodMan;
 	}
 }
@@ -33,8 +33,33 @@ namespace Audio
 
 	SupportedFileFormat TryToDetermineFileFormatFromExtension(std::string_view fileName);
 
-	// TODO: Also expose file streaming API if / when it's needed
-	//		 but for now everything will be stored in one big continuous buffer since it greatly reduces complexity.
-	//		 Instead of constantly reading a streamed file from disk it might also be an option to read the entire file upfront but then only decode chunks on demand (?)
+	// NOTE: Decodes everything into one big continuous buffer, see StreamingFileDecoder for decoding in chunks instead
 	DecodeFileResult DecodeEntireFile(std::string_view fileNameWithExtension, const void* inFileContent, size_t inFileSize, PCMSampleBuffer& outBuffer);
+
+	// NOTE: Reads from an entire file upfront loaded into memory but only decodes it chunk by chunk on demand.
+	//		 The file content is not copied and has to outlive the decoder
+	class StreamingFileDecoder : NonCopyable
+	{
+	public:
+		StreamingFileDecoder();
+		~StreamingFileDecoder();
+
+	public:
+		DecodeFileResult OpenFromMemory(std::string_view fileNameWithExtension, const void* inFileContent, size_t inFileSize);
+		void Close();
+
+		b8 GetIsOpen() const;
+		u32 GetChannelCount() const;
+		u32 GetSampleRate() const;
+
+		// NOTE: As reported by the file header, zero if unknown and not guaranteed to exactly match the number of decodable frames
+		i64 GetFrameCount() const;
+
+		// NOTE: Returns the number of frames written to the output buffer, with zero meaning the end of the file has been reached
+		i64 DecodeNextFrames(i64 maxFrameCount, i16 outSamples[]);
+
+	private:
+		struct Impl;
+		std::unique_ptr<Impl> impl;
+	};
 }
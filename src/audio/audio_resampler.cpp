@@ -0,0 +1,276 @@
+#include "audio_resampler.h"
+#include <numeric>
+#include <thread>
+#include <future>
+
+// NOTE: SSE2 is always available on x64 so there is no need for any runtime CPU feature detection
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define AUDIO_RESAMPLER_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define AUDIO_RESAMPLER_USE_SSE2 0
+#endif
+
+namespace Audio
+{
+	// NOTE: Roughly 70 dB of stopband attenuation, placing the cutoff slightly below nyquist so that the transition band ends before it
+	static constexpr f64 KaiserWindowBeta = 7.0;
+	static constexpr f64 PassbandFraction = 0.91;
+	static constexpr f64 PiF64 = 3.14159265358979323846;
+
+	// NOTE: Whole buffer resampling is only split up across threads once there is enough work per job to make up for the thread startup cost
+	static constexpr i64 MinOutFramesPerResampleJob = 0x10000;
+
+	static f64 BesselI0(f64 x)
+	{
+		f64 sum = 1.0, term = 1.0;
+		const f64 halfXSquared = (x * x) * 0.25;
+		for (i32 k = 1; k < 64 && term > (sum * 1e-12); k++)
+		{
+			term *= halfXSquared / static_cast<f64>(k * k);
+			sum += term;
+		}
+		return sum;
+	}
+
+	PolyphaseFilterBank::PolyphaseFilterBank(u32 sourceSampleRate, u32 targetSampleRate)
+	{
+		assert(sourceSampleRate > 0 && targetSampleRate > 0);
+		const u32 divisor = std::gcd(sourceSampleRate, targetSampleRate);
+		UpFactor = (targetSampleRate / divisor);
+		DownFactor = (sourceSampleRate / divisor);
+
+		// NOTE: Very uncommon sample rate pairs can reduce to huge ratios in which case the fractional position gets quantized to the closest phase instead
+		PhaseCount = Min(UpFactor, MaxPhaseCount);
+
+		// NOTE: When downsampling the cutoff has to move down to the target nyquist and the filter has to get wider (in source frames) to keep the same steepness
+		const f64 cutoffScale = Min(1.0, static_cast<f64>(UpFactor) / static_cast<f64>(DownFactor));
+		TapCount = static_cast<u32>(Ceil(BaseTapCount / cutoffScale));
+		TapCount = (TapCount + (TapCountAlignment - 1)) & ~(TapCountAlignment - 1);
+		TapOffset = static_cast<i64>(TapCount / 2) - 1;
+
+		const f64 cutoff = (0.5 * cutoffScale * PassbandFraction);
+		const f64 halfWindowWidth = static_cast<f64>(TapCount / 2);
+		const f64 windowNormalization = 1.0 / BesselI0(KaiserWindowBeta);
+
+		PhaseTaps.resize(static_cast<size_t>(PhaseCount) * TapCount);
+		std::vector<f64> phaseTapsF64(TapCount);
+		for (u32 phase = 0; phase < PhaseCount; phase++)
+		{
+			const f64 fraction = static_cast<f64>(phase) / static_cast<f64>(PhaseCount);
+
+			f64 tapSum = 0.0;
+			for (u32 tap = 0; tap < TapCount; tap++)
+			{
+				const f64 distance = (static_cast<f64>(static_cast<i64>(tap) - TapOffset) - fraction);
+				const f64 sincX = (2.0 * cutoff * distance);
+				const f64 sinc = (sincX == 0.0) ? 1.0 : (::sin(PiF64 * sincX) / (PiF64 * sincX));
+
+				const f64 windowT = (distance / halfWindowWidth);
+				const f64 window = (windowT * windowT < 1.0) ? (BesselI0(KaiserWindowBeta * ::sqrt(1.0 - (windowT * windowT))) * windowNormalization) : 0.0;
+
+				phaseTapsF64[tap] = (2.0 * cutoff * sinc * window);
+				tapSum += phaseTapsF64[tap];
+			}
+
+			// NOTE: Normalize each phase individually for exact unity gain at DC, otherwise a constant input would come out with a slight ripple
+			f32* outTaps = &PhaseTaps[static_cast<size_t>(phase) * TapCount];
+			for (u32 tap = 0; tap < TapCount; tap++)
+				outTaps[tap] = static_cast<f32>(phaseTapsF64[tap] / tapSum);
+		}
+	}
+
+	// NOTE: Both paths accumulate in the exact same order (16 lanes, then a fixed reduction) so that their results are bit-identical.
+	//		 Using four independent accumulators hides the add latency that would otherwise serialize the entire loop
+	static __forceinline f32 DotProductF32(const f32* samples, const f32* taps, u32 tapCount)
+	{
+		assert(tapCount % PolyphaseFilterBank::TapCountAlignment == 0);
+#if AUDIO_RESAMPLER_USE_SSE2
+		__m128 accumulators[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+		for (u32 i = 0; i < tapCount; i += 16)
+		{
+			accumulators[0] = _mm_add_ps(accumulators[0], _mm_mul_ps(_mm_loadu_ps(&samples[i + 0]), _mm_loadu_ps(&taps[i + 0])));
+			accumulators[1] = _mm_add_ps(accumulators[1], _mm_mul_ps(_mm_loadu_ps(&samples[i + 4]), _mm_loadu_ps(&taps[i + 4])));
+			accumulators[2] = _mm_add_ps(accumulators[2], _mm_mul_ps(_mm_loadu_ps(&samples[i + 8]), _mm_loadu_ps(&taps[i + 8])));
+			accumulators[3] = _mm_add_ps(accumulators[3], _mm_mul_ps(_mm_loadu_ps(&samples[i + 12]), _mm_loadu_ps(&taps[i + 12])));
+		}
+
+		const __m128 lanes = _mm_add_ps(_mm_add_ps(accumulators[0], accumulators[1]), _mm_add_ps(accumulators[2], accumulators[3]));
+		const __m128 pairSums = _mm_add_ps(lanes, _mm_shuffle_ps(lanes, lanes, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtss_f32(_mm_add_ss(pairSums, _mm_movehl_ps(pairSums, pairSums)));
+#else
+		f32 accumulators[4][4] = {};
+		for (u32 i = 0; i < tapCount; i += 16)
+		{
+			for (u32 accumulator = 0; accumulator < 4; accumulator++)
+			{
+				for (u32 lane = 0; lane < 4; lane++)
+					accumulators[accumulator][lane] += (samples[i + (accumulator * 4) + lane] * taps[i + (accumulator * 4) + lane]);
+			}
+		}
+
+		f32 lanes[4];
+		for (u32 lane = 0; lane < 4; lane++)
+			lanes[lane] = ((accumulators[0][lane] + accumulators[1][lane]) + (accumulators[2][lane] + accumulators[3][lane]));
+		return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+#endif
+	}
+
+	// NOTE: Round to nearest even without branching on the sign, matching the default SSE rounding mode
+	static __forceinline i32 RoundF32ToI32(f32 value)
+	{
+#if AUDIO_RESAMPLER_USE_SSE2
+		return _mm_cvtss_si32(_mm_set_ss(value));
+#else
+		return static_cast<i32>(::nearbyintf(value));
+#endif
+	}
+
+	static constexpr i64 GetInputFrameForOutputFrame(const PolyphaseFilterBank& bank, i64 outFrame)
+	{
+		return static_cast<i64>((static_cast<u64>(outFrame) * bank.DownFactor) / bank.UpFactor);
+	}
+
+	// NOTE: Planar input samples are expected to be stored as f32 in the i16 value range, starting at input frame planarFirstFrame
+	static void ResamplePlanarChannel(const PolyphaseFilterBank& bank, const f32* planarSamples, i64 planarFirstFrame, i64 outFrameBegin, i64 outFrameEnd, i16* outSamples, u32 outSampleStride)
+	{
+		const u64 stepWhole = (bank.DownFactor / bank.UpFactor), stepFraction = (bank.DownFactor % bank.UpFactor);
+		const u64 startPosition = (static_cast<u64>(outFrameBegin) * bank.DownFactor);
+		i64 inFrame = static_cast<i64>(startPosition / bank.UpFactor);
+		u64 inFraction = (startPosition % bank.UpFactor);
+
+		for (i64 outFrame = outFrameBegin; outFrame < outFrameEnd; outFrame++)
+		{
+			const u32 phase = (bank.PhaseCount == bank.UpFactor) ? static_cast<u32>(inFraction) : static_cast<u32>((inFraction * bank.PhaseCount) / bank.UpFactor);
+			const f32* window = &planarSamples[(inFrame - bank.TapOffset) - planarFirstFrame];
+
+			const f32 result = DotProductF32(window, bank.GetTapsForPhase(phase), bank.TapCount);
+			*outSamples = ClampSampleI<i16, i32>(RoundF32ToI32(result));
+			outSamples += outSampleStride;
+
+			inFrame += static_cast<i64>(stepWhole);
+			inFraction += stepFraction;
+			if (inFraction >= bank.UpFactor) { inFraction -= bank.UpFactor; inFrame++; }
+		}
+	}
+
+	PolyphaseResampler::PolyphaseResampler(u32 channelCount, u32 sourceSampleRate, u32 targetSampleRate, i64 inFrameCount)
+		: channelCount(channelCount), filterBank(sourceSampleRate, targetSampleRate)
+	{
+		outFrameCount = static_cast<i64>(GetResampledFrameCount(static_cast<size_t>(inFrameCount), sourceSampleRate, targetSampleRate));
+
+		// NOTE: Leading silence for the first output frames whose filter window starts before the first input frame
+		historyFirstFrame = -filterBank.TapOffset;
+		historyFrameCount = filterBank.TapOffset;
+		planarHistory.resize(static_cast<size_t>(historyFrameCount) * channelCount, 0.0f);
+	}
+
+	i64 PolyphaseResampler::ResampleChunk(const i16* inSamples, i64 inFrameCount, b8 isLastChunk, i16* outSamples)
+	{
+		const i64 tapCount = filterBank.TapCount, tapOffset = filterBank.TapOffset;
+
+		// NOTE: On the last chunk pad with enough trailing silence for every remaining output frame, in case the input ended earlier than reported
+		i64 paddingFrameCount = 0;
+		if (isLastChunk && outFrameCount > 0)
+		{
+			const i64 lastWindowEnd = (GetInputFrameForOutputFrame(filterBank, outFrameCount - 1) - tapOffset + tapCount);
+			paddingFrameCount = Max<i64>(lastWindowEnd - (historyFirstFrame + historyFrameCount + inFrameCount), 0);
+		}
+
+		// NOTE: History is stored channel by channel, so grow each planar channel region to fit the new frames
+		const i64 newHistoryFrameCount = (historyFrameCount + inFrameCount + paddingFrameCount);
+		std::vector<f32> newPlanarHistory(static_cast<size_t>(newHistoryFrameCount) * channelCount, 0.0f);
+		for (u32 channel = 0; channel < channelCount; channel++)
+		{
+			const f32* oldChannel = &planarHistory[static_cast<size_t>(channel) * historyFrameCount];
+			f32* newChannel = &newPlanarHistory[static_cast<size_t>(channel) * newHistoryFrameCount];
+			std::copy(oldChannel, oldChannel + historyFrameCount, newChannel);
+			for (i64 frame = 0; frame < inFrameCount; frame++)
+				newChannel[historyFrameCount + frame] = static_cast<f32>(inSamples[(frame * channelCount) + channel]);
+		}
+		planarHistory = std::move(newPlanarHistory);
+		historyFrameCount = newHistoryFrameCount;
+
+		// NOTE: Every output frame whose entire filter window is already available can be written out now
+		const i64 availableFrameEnd = (historyFirstFrame + historyFrameCount);
+		const i64 lastComputableInFrame = (availableFrameEnd + tapOffset - tapCount);
+		i64 outFrameEnd = outFramesWritten;
+		if (lastComputableInFrame >= 0)
+			outFrameEnd = Min(outFrameCount, static_cast<i64>(((static_cast<u64>(lastComputableInFrame + 1) * filterBank.UpFactor) - 1) / filterBank.DownFactor) + 1);
+		outFrameEnd = Max(outFrameEnd, outFramesWritten);
+
+		if (outFrameEnd > outFramesWritten)
+		{
+			for (u32 channel = 0; channel < channelCount; channel++)
+			{
+				const f32* planarChannel = &planarHistory[static_cast<size_t>(channel) * historyFrameCount];
+				ResamplePlanarChannel(filterBank, planarChannel, historyFirstFrame, outFramesWritten, outFrameEnd, &outSamples[(outFramesWritten * channelCount) + channel], channelCount);
+			}
+			outFramesWritten = outFrameEnd;
+		}
+
+		// NOTE: Drop all input frames that no upcoming output frame is going to read from again
+		const i64 firstNeededFrame = Min(GetInputFrameForOutputFrame(filterBank, outFramesWritten) - tapOffset, availableFrameEnd);
+		if (const i64 framesToDrop = (firstNeededFrame - historyFirstFrame); framesToDrop > 0)
+		{
+			const i64 keptFrameCount = (historyFrameCount - framesToDrop);
+			for (u32 channel = 0; channel < channelCount; channel++)
+			{
+				const f32* oldChannel = &planarHistory[(static_cast<size_t>(channel) * historyFrameCount) + framesToDrop];
+				std::copy(oldChannel, oldChannel + keptFrameCount, &planarHistory[static_cast<size_t>(channel) * keptFrameCount]);
+			}
+			planarHistory.resize(static_cast<size_t>(keptFrameCount) * channelCount);
+			historyFirstFrame += framesToDrop;
+			historyFrameCount = keptFrameCount;
+		}
+
+		return outFramesWritten;
+	}
+
+	void PolyphaseResampleBuffer(PCMSampleStorage& inOutSamples, i64& inOutFrameCount, u32& inOutSampleRate, const u32 inChannelCount, const u32 targetSampleRate)
+	{
+		if (inOutSampleRate == targetSampleRate) { assert(false); return; }
+
+		const PolyphaseFilterBank filterBank(inOutSampleRate, targetSampleRate);
+		const i16* inSamples = inOutSamples.get();
+		const i64 inFrameCount = inOutFrameCount;
+		const i64 outFrameCount = static_cast<i64>(GetResampledFrameCount(static_cast<size_t>(inFrameCount), inOutSampleRate, targetSampleRate));
+		auto outSamples = std::unique_ptr<i16[]>(new i16[static_cast<size_t>(outFrameCount) * inChannelCount]);
+
+		// NOTE: Every job converts just the input range its own output frames need, which makes the jobs fully independent of one another
+		auto resampleOutputRange = [&](i64 outFrameBegin, i64 outFrameEnd)
+		{
+			if (outFrameBegin >= outFrameEnd)
+				return;
+
+			const i64 planarFirstFrame = (GetInputFrameForOutputFrame(filterBank, outFrameBegin) - filterBank.TapOffset);
+			const i64 planarFrameCount = (GetInputFrameForOutputFrame(filterBank, outFrameEnd - 1) - filterBank.TapOffset + filterBank.TapCount) - planarFirstFrame;
+			std::vector<f32> planarChannel(static_cast<size_t>(planarFrameCount));
+
+			for (u32 channel = 0; channel < inChannelCount; channel++)
+			{
+				for (i64 i = 0; i < planarFrameCount; i++)
+				{
+					const i64 inFrame = (planarFirstFrame + i);
+					planarChannel[i] = (inFrame >= 0 && inFrame < inFrameCount) ? static_cast<f32>(inSamples[(inFrame * inChannelCount) + channel]) : 0.0f;
+				}
+				ResamplePlanarChannel(filterBank, planarChannel.data(), planarFirstFrame, outFrameBegin, outFrameEnd, &outSamples[(outFrameBegin * inChannelCount) + channel], inChannelCount);
+			}
+		};
+
+		const i64 hardwareThreadCount = Max<i64>(static_cast<i64>(std::thread::hardware_concurrency()), 1);
+		const i64 jobCount = Clamp<i64>(outFrameCount / MinOutFramesPerResampleJob, 1, hardwareThreadCount);
+
+		std::vector<std::future<void>> jobFutures;
+		jobFutures.reserve(static_cast<size_t>(jobCount));
+		for (i64 jobIndex = 1; jobIndex < jobCount; jobIndex++)
+			jobFutures.push_back(std::async(std::launch::async, resampleOutputRange, (outFrameCount * jobIndex) / jobCount, (outFrameCount * (jobIndex + 1)) / jobCount));
+		resampleOutputRange(0, outFrameCount / jobCount);
+		for (auto& future : jobFutures)
+			future.get();
+
+		inOutSamples = std::move(outSamples);
+		inOutFrameCount = outFrameCount;
+		inOutSampleRate = targetSampleRate;
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "core_types.h"
+#include "audio_common.h"
+#include <memory>
+#include <vector>
+
+namespace Audio
+{
+	constexpr size_t GetResampledFrameCount(size_t inFrameCount, u32 sourceSampleRate, u32 targetSampleRate)
+	{
+		return static_cast<size_t>(inFrameCount * static_cast<f64>(targetSampleRate) / static_cast<f64>(sourceSampleRate) + 0.5);
+	}
+
+	// NOTE: Kaiser windowed-sinc low pass split into one sub-filter per output phase. The ratio is reduced to (UpFactor / DownFactor)
+	//		 so that every output frame maps onto an exact integer input frame plus phase without any accumulating floating point error
+	struct PolyphaseFilterBank
+	{
+		static constexpr u32 MaxPhaseCount = 1024;
+		static constexpr u32 BaseTapCount = 64;
+		static constexpr u32 TapCountAlignment = 16;
+
+		u32 UpFactor = 0, DownFactor = 0;
+		u32 PhaseCount = 0;
+		u32 TapCount = 0;
+		i64 TapOffset = 0;
+		std::vector<f32> PhaseTaps;
+
+		PolyphaseFilterBank() = default;
+		PolyphaseFilterBank(u32 sourceSampleRate, u32 targetSampleRate);
+
+		inline const f32* GetTapsForPhase(u32 phase) const { return &PhaseTaps[static_cast<size_t>(phase) * TapCount]; }
+	};
+
+	// NOTE: Same contract as feeding consecutive chunks of input frames into a streaming decoder, with the filter history kept in between.
+	//		 Output frames whose filter window reaches past the end of the current chunk are deferred until the next one unless this is the last chunk.
+	//		 The output is bit-exact regardless of how the input has been split up into chunks
+	class PolyphaseResampler : NonCopyable
+	{
+	public:
+		PolyphaseResampler(u32 channelCount, u32 sourceSampleRate, u32 targetSampleRate, i64 inFrameCount);
+
+		// NOTE: Writes to outSamples starting at GetOutFramesWritten() and returns the new number of total frames written
+		i64 ResampleChunk(const i16* inSamples, i64 inFrameCount, b8 isLastChunk, i16* outSamples);
+
+		inline i64 GetOutFrameCount() const { return outFrameCount; }
+		inline i64 GetOutFramesWritten() const { return outFramesWritten; }
+
+	private:
+		u32 channelCount = 0;
+		i64 outFrameCount = 0, outFramesWritten = 0;
+		PolyphaseFilterBank filterBank;
+
+		// NOTE: Planar f32 input frames still needed by upcoming output frames, starting at historyFirstFrame (which is negative for the leading zero padding)
+		i64 historyFirstFrame = 0;
+		i64 historyFrameCount = 0;
+		std::vector<f32> planarHistory;
+	};
+
+	// NOTE: Resamples an entire buffer at once, split up into independent output ranges across multiple threads for large buffers.
+	//		 Produces the exact same output as a PolyphaseResampler fed with the same input
+	void PolyphaseResampleBuffer(PCMSampleStorage& inOutSamples, i64& inOutFrameCount, u32& inOutSampleRate, const u32 inChannelCount, const u32 targetSampleRate);
+}
@@ -0,0 +1,568 @@
+#include "audio_waveform.h"
+#include <atomic>
+#include <thread>
+#include <future>
+
+// NOTE: SSE2 is always available on x64 so there is no need for any runtime CPU feature detection
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define AUDIO_WAVEFORM_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define AUDIO_WAVEFORM_USE_SSE2 0
+#endif
+
+namespace Audio
+{
+	// NOTE: Power of two so that every mip up to log2(BasePeaksPerMipJob) can be generated entirely within the job owning its base peaks
+	static constexpr size_t BasePeaksPerMipJob = 0x8000;
+	static_assert((BasePeaksPerMipJob >> WaveformMipChain::CoarseMipIndex) > 0 && (BasePeaksPerMipJob & (BasePeaksPerMipJob - 1)) == 0);
+
+	// NOTE: Max supported channel count for finding the peaks of all channels in a single pass over the interleaved samples
+	static constexpr size_t MaxPeakChannelCount = 8;
+
+	static constexpr WaveformPeak EmptyPeak = { I16Max, I16Min };
+	static constexpr WaveformPeak SilentPeak = { 0, 0 };
+
+	struct MipGenerationSource
+	{
+		const i16* InterleavedSamples;
+		size_t ChannelCount;
+		size_t FramesPerBasePeak;
+		// NOTE: Base peaks past this point (for padding the mip up to a power of two) are treated as silence
+		size_t ValidBasePeakCount;
+	};
+
+	static void InitializeMipChainLayout(WaveformMipChain& chain, const PCMSampleBuffer& inSampleBuffer, b8 includeFullSizeMip)
+	{
+		chain.Duration = FramesToTime(inSampleBuffer.FrameCount, inSampleBuffer.SampleRate);
+		for (auto& mip : chain.AllMips) mip.Clear();
+
+		WaveformMip& baseMip = chain.AllMips[0];
+		baseMip.PowerOfTwoSampleCount = RoundUpToPowerOfTwo(static_cast<u32>(inSampleBuffer.FrameCount));
+		baseMip.TimePerSample = Time::FromSec(1.0 / static_cast<f64>(inSampleBuffer.SampleRate));
+		baseMip.SamplesPerSecond = static_cast<f64>(inSampleBuffer.SampleRate);
+
+		// NOTE: No need to waste memory storing the full size mip if it won't even get sampled AND is already duplicated inside the source buffer
+		if (!includeFullSizeMip)
+		{
+			baseMip.PowerOfTwoSampleCount /= 2;
+			baseMip.TimePerSample = baseMip.TimePerSample * 2.0;
+			baseMip.SamplesPerSecond = baseMip.SamplesPerSecond / 2.0;
+		}
+
+		// NOTE: Padded with silence up to a power of two so that the peaks can be evenly split up into power of two sized jobs
+		baseMip.PeakCount = baseMip.PowerOfTwoSampleCount;
+
+		// NOTE: Compute all sample counts and offsets up front so that all mips can share a single allocation
+		size_t totalSampleCountAcrossAllMips = baseMip.PeakCount;
+		for (size_t i = 1; i < WaveformMipChain::MaxMipLevels; i++)
+		{
+			const WaveformMip& parentMip = chain.AllMips[i - 1];
+			if (parentMip.PowerOfTwoSampleCount <= WaveformMipChain::MinMipSampleCount)
+				break;
+
+			WaveformMip& newMip = chain.AllMips[i];
+			newMip.PowerOfTwoSampleCount = (parentMip.PowerOfTwoSampleCount / 2);
+			newMip.TimePerSample = (parentMip.TimePerSample * 2.0);
+			newMip.SamplesPerSecond = (parentMip.SamplesPerSecond / 2.0);
+			newMip.PeakOffset = totalSampleCountAcrossAllMips;
+			newMip.PeakCount = newMip.PowerOfTwoSampleCount;
+			totalSampleCountAcrossAllMips += newMip.PeakCount;
+		}
+
+		// NOTE: Every single peak gets written to by the generation jobs, which also means the pages are first touched in parallel
+		if (chain.PeakStorage == nullptr || chain.TotalPeakCount != totalSampleCountAcrossAllMips)
+			chain.PeakStorage = std::unique_ptr<WaveformPeak[]>(new WaveformPeak[totalSampleCountAcrossAllMips]);
+
+		chain.Peaks = chain.PeakStorage.get();
+		chain.TotalPeakCount = totalSampleCountAcrossAllMips;
+		chain.MappedPeakCacheFile = nullptr;
+	}
+
+	static void CopyMipsStartingAt(const WaveformMipChain& inChain, size_t firstMipIndex, WaveformMipChain& outChain)
+	{
+		const size_t firstPeakOffset = inChain.AllMips[firstMipIndex].PeakOffset;
+
+		outChain.Duration = inChain.Duration;
+		for (size_t i = 0; i < WaveformMipChain::MaxMipLevels; i++)
+		{
+			outChain.AllMips[i] = ((i + firstMipIndex) < WaveformMipChain::MaxMipLevels) ? inChain.AllMips[i + firstMipIndex] : WaveformMip {};
+			if (outChain.AllMips[i].PowerOfTwoSampleCount != 0)
+				outChain.AllMips[i].PeakOffset -= firstPeakOffset;
+		}
+		outChain.TotalPeakCount = (inChain.TotalPeakCount - firstPeakOffset);
+		outChain.PeakStorage = std::unique_ptr<WaveformPeak[]>(new WaveformPeak[outChain.TotalPeakCount]);
+		outChain.Peaks = outChain.PeakStorage.get();
+		outChain.MappedPeakCacheFile = nullptr;
+		std::copy(inChain.Peaks + firstPeakOffset, inChain.Peaks + inChain.TotalPeakCount, outChain.PeakStorage.get());
+	}
+
+	// NOTE: Min / max of each of the first outPeakCount channels across all of the interleaved frames.
+	//		 As long as the channel count evenly divides the vector width every lane always maps onto the same channel
+	static void FindInterleavedFramePeaks(const i16* inSamples, size_t frameCount, size_t channelCount, WaveformPeak* outPeaks, size_t outPeakCount)
+	{
+		assert(channelCount <= MaxPeakChannelCount && outPeakCount <= channelCount);
+		WaveformPeak channelPeaks[MaxPeakChannelCount];
+		for (size_t channel = 0; channel < channelCount; channel++)
+			channelPeaks[channel] = EmptyPeak;
+
+		size_t frameIndex = 0;
+#if AUDIO_WAVEFORM_USE_SSE2
+		if ((8 % channelCount) == 0)
+		{
+			const size_t sampleCount = (frameCount * channelCount);
+			size_t sampleIndex = 0;
+
+			__m128i laneMin = _mm_set1_epi16(I16Max);
+			__m128i laneMax = _mm_set1_epi16(I16Min);
+			for (; (sampleIndex + 8) <= sampleCount; sampleIndex += 8)
+			{
+				const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inSamples[sampleIndex]));
+				laneMin = _mm_min_epi16(laneMin, samples);
+				laneMax = _mm_max_epi16(laneMax, samples);
+			}
+
+			alignas(16) i16 laneMinArray[8], laneMaxArray[8];
+			_mm_store_si128(reinterpret_cast<__m128i*>(laneMinArray), laneMin);
+			_mm_store_si128(reinterpret_cast<__m128i*>(laneMaxArray), laneMax);
+			for (size_t lane = 0; lane < 8; lane++)
+				channelPeaks[lane % channelCount] = WaveformPeak::Combine(channelPeaks[lane % channelCount], WaveformPeak { laneMinArray[lane], laneMaxArray[lane] });
+			frameIndex = (sampleIndex / channelCount);
+		}
+#endif
+		for (; frameIndex < frameCount; frameIndex++)
+		{
+			for (size_t channel = 0; channel < channelCount; channel++)
+			{
+				const i16 sample = inSamples[(frameIndex * channelCount) + channel];
+				channelPeaks[channel] = WaveformPeak { Min(channelPeaks[channel].Min, sample), Max(channelPeaks[channel].Max, sample) };
+			}
+		}
+
+		for (size_t channel = 0; channel < outPeakCount; channel++)
+			outPeaks[channel] = channelPeaks[channel];
+	}
+
+	// NOTE: Each output peak combines two adjacent input peaks
+	static void CombinePeakPairs(const WaveformPeak* inPeaks, WaveformPeak* outPeaks, size_t outPeakCount)
+	{
+		size_t outIndex = 0;
+#if AUDIO_WAVEFORM_USE_SSE2
+		// NOTE: Every peak is a (min, max) i16 pair, so comparing against the input shifted by one peak leaves the pair results in every other 32-bit lane
+		const __m128i minLaneMask = _mm_set1_epi32(0x0000FFFF);
+		auto combinePairsInLanes = [minLaneMask](__m128i fourPeaks) -> __m128i
+		{
+			const __m128i nextPeaks = _mm_srli_si128(fourPeaks, 4);
+			const __m128i pairMin = _mm_min_epi16(fourPeaks, nextPeaks);
+			const __m128i pairMax = _mm_max_epi16(fourPeaks, nextPeaks);
+			const __m128i combined = _mm_or_si128(_mm_and_si128(minLaneMask, pairMin), _mm_andnot_si128(minLaneMask, pairMax));
+			return _mm_shuffle_epi32(combined, _MM_SHUFFLE(3, 1, 2, 0));
+		};
+
+		for (; (outIndex + 4) <= outPeakCount; outIndex += 4)
+		{
+			const __m128i peaksLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inPeaks[outIndex * 2 + 0]));
+			const __m128i peaksHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inPeaks[outIndex * 2 + 4]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&outPeaks[outIndex]), _mm_unpacklo_epi64(combinePairsInLanes(peaksLo), combinePairsInLanes(peaksHi)));
+		}
+#endif
+		for (; outIndex < outPeakCount; outIndex++)
+			outPeaks[outIndex] = WaveformPeak::Combine(inPeaks[outIndex * 2 + 0], inPeaks[outIndex * 2 + 1]);
+	}
+
+	static void GenerateBasePeaks(const MipGenerationSource& source, WaveformMipChain* chains, size_t chainCount, size_t basePeakBegin, size_t basePeakEnd)
+	{
+		const size_t validPeakEnd = Clamp(source.ValidBasePeakCount, basePeakBegin, basePeakEnd);
+		const size_t channelCount = source.ChannelCount;
+
+		size_t peakIndex = basePeakBegin;
+#if AUDIO_WAVEFORM_USE_SSE2
+		if (source.FramesPerBasePeak == 2 && channelCount == 2 && chainCount == 2)
+		{
+			// NOTE: Deinterleave (L0 R0 L1 R1 L2 R2 L3 R3) into the peaks of both channels at once, 8 frames resulting in 4 peaks per channel
+			auto findFramePairPeaks = [](__m128i fourFrames) -> __m128i
+			{
+				const __m128i nextFrames = _mm_srli_si128(fourFrames, 4);
+				const __m128i pairMin = _mm_min_epi16(fourFrames, nextFrames);
+				const __m128i pairMax = _mm_max_epi16(fourFrames, nextFrames);
+				return _mm_unpacklo_epi32(_mm_unpacklo_epi16(pairMin, pairMax), _mm_unpackhi_epi16(pairMin, pairMax));
+			};
+
+			WaveformPeak* peaksL = chains[0].PeakStorage.get();
+			WaveformPeak* peaksR = chains[1].PeakStorage.get();
+			for (; (peakIndex + 4) <= validPeakEnd; peakIndex += 4)
+			{
+				const i16* frames = &source.InterleavedSamples[peakIndex * 4];
+				const __m128i peaksA = findFramePairPeaks(_mm_loadu_si128(reinterpret_cast<const __m128i*>(frames + 0)));
+				const __m128i peaksB = findFramePairPeaks(_mm_loadu_si128(reinterpret_cast<const __m128i*>(frames + 8)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&peaksL[peakIndex]), _mm_unpacklo_epi64(peaksA, peaksB));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&peaksR[peakIndex]), _mm_unpackhi_epi64(peaksA, peaksB));
+			}
+		}
+		else if (source.FramesPerBasePeak == 2 && channelCount == 1 && chainCount == 1)
+		{
+			// NOTE: Same as CombinePeakPairs with every sample pair being treated as a peak
+			const __m128i minLaneMask = _mm_set1_epi32(0x0000FFFF);
+			WaveformPeak* peaks = chains[0].PeakStorage.get();
+			for (; (peakIndex + 4) <= validPeakEnd; peakIndex += 4)
+			{
+				const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source.InterleavedSamples[peakIndex * 2]));
+				const __m128i nextSamples = _mm_srli_si128(samples, 2);
+				const __m128i pairMin = _mm_min_epi16(samples, nextSamples);
+				const __m128i pairMax = _mm_slli_si128(_mm_max_epi16(samples, nextSamples), 2);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&peaks[peakIndex]), _mm_or_si128(_mm_and_si128(minLaneMask, pairMin), _mm_andnot_si128(minLaneMask, pairMax)));
+			}
+		}
+#endif
+		for (size_t chainIndex = 0; chainIndex < chainCount; chainIndex++)
+		{
+			WaveformPeak* peaks = chains[chainIndex].PeakStorage.get();
+			for (size_t i = peakIndex; i < validPeakEnd; i++)
+			{
+				const i16* frame = &source.InterleavedSamples[(i * source.FramesPerBasePeak * channelCount) + chainIndex];
+				if (source.FramesPerBasePeak == 1)
+					peaks[i] = WaveformPeak { frame[0], frame[0] };
+				else
+					peaks[i] = WaveformPeak { Min(frame[0], frame[channelCount]), Max(frame[0], frame[channelCount]) };
+			}
+
+			for (size_t i = validPeakEnd; i < basePeakEnd; i++)
+				peaks[i] = SilentPeak;
+		}
+	}
+
+	// NOTE: Generates the peaks of a single mip straight from the source samples without requiring any of its parent mips
+	static void GenerateMipPeaksFromSource(const MipGenerationSource& source, WaveformMipChain* chains, size_t chainCount, size_t mipIndex, size_t mipPeakBegin, size_t mipPeakEnd)
+	{
+		const size_t basePeaksPerMipPeak = (static_cast<size_t>(1) << mipIndex);
+		WaveformPeak framePeaks[MaxPeakChannelCount];
+
+		for (size_t mipPeakIndex = mipPeakBegin; mipPeakIndex < mipPeakEnd; mipPeakIndex++)
+		{
+			const size_t basePeakBegin = ClampTop(mipPeakIndex * basePeaksPerMipPeak, source.ValidBasePeakCount);
+			const size_t basePeakEnd = ClampTop((mipPeakIndex + 1) * basePeaksPerMipPeak, source.ValidBasePeakCount);
+			const size_t frameCount = (basePeakEnd - basePeakBegin) * source.FramesPerBasePeak;
+			const b8 includesSilentPadding = ((basePeakEnd - basePeakBegin) < basePeaksPerMipPeak);
+
+			FindInterleavedFramePeaks(&source.InterleavedSamples[basePeakBegin * source.FramesPerBasePeak * source.ChannelCount], frameCount, source.ChannelCount, framePeaks, chainCount);
+			for (size_t chainIndex = 0; chainIndex < chainCount; chainIndex++)
+			{
+				WaveformPeak peak = framePeaks[chainIndex];
+				if (includesSilentPadding)
+					peak = WaveformPeak::Combine(peak, SilentPeak);
+
+				WaveformMipChain& chain = chains[chainIndex];
+				chain.PeakStorage[chain.AllMips[mipIndex].PeakOffset + mipPeakIndex] = peak;
+			}
+		}
+	}
+
+	static void GenerateMipPeaksFromParent(WaveformMipChain& chain, size_t mipIndex, size_t mipPeakBegin, size_t mipPeakEnd)
+	{
+		const WaveformMip& parentMip = chain.AllMips[mipIndex - 1];
+		const WaveformMip& thisMip = chain.AllMips[mipIndex];
+		CombinePeakPairs(&chain.PeakStorage[parentMip.PeakOffset + (mipPeakBegin * 2)], &chain.PeakStorage[thisMip.PeakOffset + mipPeakBegin], (mipPeakEnd - mipPeakBegin));
+	}
+
+	// NOTE: Worker pool pulling fixed size chunks from a shared counter so that no thread ends up idling behind a slower one
+	template <typename ChunkFunc>
+	static void ForEachChunkInParallel(size_t chunkCount, ChunkFunc chunkFunc)
+	{
+		const size_t hardwareThreadCount = Max<size_t>(std::thread::hardware_concurrency(), 1);
+		const size_t workerCount = Clamp<size_t>(chunkCount, 1, hardwareThreadCount);
+
+		std::atomic<size_t> nextChunkIndex = 0;
+		auto workerFunc = [&]()
+		{
+			for (size_t chunkIndex = nextChunkIndex++; chunkIndex < chunkCount; chunkIndex = nextChunkIndex++)
+				chunkFunc(chunkIndex);
+		};
+
+		std::vector<std::future<void>> workerFutures;
+		workerFutures.reserve(workerCount);
+		for (size_t workerIndex = 1; workerIndex < workerCount; workerIndex++)
+			workerFutures.push_back(std::async(std::launch::async, workerFunc));
+		workerFunc();
+		for (auto& future : workerFutures)
+			future.get();
+	}
+
+	static MipGenerationSource GetMipGenerationSource(const PCMSampleBuffer& inSampleBuffer, b8 includeFullSizeMip)
+	{
+		return MipGenerationSource
+		{
+			inSampleBuffer.InterleavedSamples.get(),
+			inSampleBuffer.ChannelCount,
+			includeFullSizeMip ? static_cast<size_t>(1) : static_cast<size_t>(2),
+			static_cast<size_t>(inSampleBuffer.FrameCount) / (includeFullSizeMip ? 1 : 2),
+		};
+	}
+
+	// NOTE: Generates the base peaks and all mips below endMipIndex from them, with each job owning a fixed size chunk of base peaks
+	static void GenerateFineMipPeaks(const MipGenerationSource& source, WaveformMipChain* outChains, size_t chainCount, size_t endMipIndex)
+	{
+		const size_t basePeakCount = outChains[0].AllMips[0].PeakCount;
+		const size_t basePeaksPerJob = ClampTop(BasePeaksPerMipJob, basePeakCount);
+		const size_t jobCount = (basePeakCount / basePeaksPerJob);
+
+		// NOTE: Mips whose peaks are covered by a single job can be generated right after its base peaks while they are still hot in the cache
+		size_t jobLocalMipCount = 1;
+		while (jobLocalMipCount < endMipIndex && (basePeaksPerJob >> jobLocalMipCount) > 0)
+			jobLocalMipCount++;
+
+		ForEachChunkInParallel(jobCount, [&](size_t jobIndex)
+		{
+			const size_t basePeakBegin = (jobIndex * basePeaksPerJob);
+			GenerateBasePeaks(source, outChains, chainCount, basePeakBegin, basePeakBegin + basePeaksPerJob);
+
+			for (size_t chainIndex = 0; chainIndex < chainCount; chainIndex++)
+				for (size_t mipIndex = 1; mipIndex < jobLocalMipCount; mipIndex++)
+					GenerateMipPeaksFromParent(outChains[chainIndex], mipIndex, (basePeakBegin >> mipIndex), ((basePeakBegin + basePeaksPerJob) >> mipIndex));
+		});
+
+		for (size_t chainIndex = 0; chainIndex < chainCount; chainIndex++)
+			for (size_t mipIndex = jobLocalMipCount; mipIndex < endMipIndex; mipIndex++)
+				GenerateMipPeaksFromParent(outChains[chainIndex], mipIndex, 0, outChains[chainIndex].AllMips[mipIndex].PeakCount);
+	}
+
+	void GenerateMipChainsFromSampleBuffer(const PCMSampleBuffer& inSampleBuffer, WaveformMipChain* outChains, size_t chainCount, const WaveformCoarseMipsCallback& onCoarseMipsReady, b8 includeFullSizeMip)
+	{
+		assert(inSampleBuffer.InterleavedSamples != nullptr && chainCount <= inSampleBuffer.ChannelCount);
+		if (chainCount == 0 || inSampleBuffer.FrameCount <= 0)
+			return;
+
+		for (size_t chainIndex = 0; chainIndex < chainCount; chainIndex++)
+			InitializeMipChainLayout(outChains[chainIndex], inSampleBuffer, includeFullSizeMip);
+
+		const MipGenerationSource source = GetMipGenerationSource(inSampleBuffer, includeFullSizeMip);
+
+		// NOTE: Same layout for all chains
+		const WaveformMipChain& layout = outChains[0];
+		if (layout.IsEmpty())
+			return;
+
+		const size_t mipCount = static_cast<size_t>(layout.GetUsedMipCount());
+		const size_t basePeakCount = layout.AllMips[0].PeakCount;
+		const size_t basePeaksPerJob = ClampTop(BasePeaksPerMipJob, basePeakCount);
+		const size_t jobCount = (basePeakCount / basePeaksPerJob);
+
+		auto generateRemainingMipsFromParents = [&](size_t firstMipIndex, size_t endMipIndex)
+		{
+			for (size_t chainIndex = 0; chainIndex < chainCount; chainIndex++)
+				for (size_t mipIndex = firstMipIndex; mipIndex < endMipIndex; mipIndex++)
+					GenerateMipPeaksFromParent(outChains[chainIndex], mipIndex, 0, outChains[chainIndex].AllMips[mipIndex].PeakCount);
+		};
+
+		// NOTE: Only worth the extra pass over the source samples if there is enough data for the finer mips to take a noticeable amount of time
+		const b8 generateCoarseMipsFirst = (onCoarseMipsReady != nullptr && inSampleBuffer.ChannelCount <= MaxPeakChannelCount && mipCount > WaveformMipChain::CoarseMipIndex && jobCount > 1);
+		size_t fineMipCount = mipCount;
+
+		if (generateCoarseMipsFirst)
+		{
+			constexpr size_t coarseMipIndex = WaveformMipChain::CoarseMipIndex;
+			const size_t coarsePeaksPerJob = (basePeaksPerJob >> coarseMipIndex);
+
+			ForEachChunkInParallel(jobCount, [&](size_t jobIndex)
+			{
+				GenerateMipPeaksFromSource(source, outChains, chainCount, coarseMipIndex, (jobIndex * coarsePeaksPerJob), ((jobIndex + 1) * coarsePeaksPerJob));
+			});
+			generateRemainingMipsFromParents(coarseMipIndex + 1, mipCount);
+
+			WaveformMipChain coarseChains[MaxPeakChannelCount];
+			for (size_t chainIndex = 0; chainIndex < chainCount; chainIndex++)
+				CopyMipsStartingAt(outChains[chainIndex], coarseMipIndex, coarseChains[chainIndex]);
+			onCoarseMipsReady(coarseChains, chainCount);
+
+			fineMipCount = coarseMipIndex;
+		}
+
+		GenerateFineMipPeaks(source, outChains, chainCount, fineMipCount);
+	}
+
+	void CompleteMipChainsFromPeakCache(const PCMSampleBuffer& inSampleBuffer, const WaveformMipChain* cachedChains, WaveformMipChain* outChains, size_t chainCount)
+	{
+		assert(inSampleBuffer.InterleavedSamples != nullptr && chainCount <= inSampleBuffer.ChannelCount);
+		if (chainCount == 0 || inSampleBuffer.FrameCount <= 0)
+			return;
+
+		constexpr size_t firstCachedMipIndex = WaveformMipChain::PeakCacheFirstMipIndex;
+		for (size_t chainIndex = 0; chainIndex < chainCount; chainIndex++)
+			InitializeMipChainLayout(outChains[chainIndex], inSampleBuffer, false);
+
+		// NOTE: Should always line up given a matching cache key, but fall back to generating everything if it somehow doesn't
+		const WaveformMipChain& layout = outChains[0];
+		b8 cacheMatchesLayout = (!layout.IsEmpty() && layout.GetUsedMipCount() > static_cast<i32>(firstCachedMipIndex));
+		for (size_t chainIndex = 0; cacheMatchesLayout && chainIndex < chainCount; chainIndex++)
+		{
+			const WaveformMipChain& cachedChain = cachedChains[chainIndex];
+			const size_t firstCachedPeakOffset = layout.AllMips[firstCachedMipIndex].PeakOffset;
+			cacheMatchesLayout &= (cachedChain.TotalPeakCount == (layout.TotalPeakCount - firstCachedPeakOffset));
+			for (size_t i = firstCachedMipIndex; cacheMatchesLayout && i < WaveformMipChain::MaxMipLevels; i++)
+			{
+				const WaveformMip& mip = layout.AllMips[i];
+				const WaveformMip& cachedMip = cachedChain.AllMips[i - firstCachedMipIndex];
+				cacheMatchesLayout &= (mip.PowerOfTwoSampleCount == cachedMip.PowerOfTwoSampleCount && mip.PeakCount == cachedMip.PeakCount);
+				cacheMatchesLayout &= (mip.PowerOfTwoSampleCount == 0 || (mip.PeakOffset - firstCachedPeakOffset) == cachedMip.PeakOffset);
+			}
+		}
+
+		if (!cacheMatchesLayout)
+		{
+			GenerateMipChainsFromSampleBuffer(inSampleBuffer, outChains, chainCount);
+			return;
+		}
+
+		for (size_t chainIndex = 0; chainIndex < chainCount; chainIndex++)
+		{
+			WaveformMipChain& chain = outChains[chainIndex];
+			std::copy(cachedChains[chainIndex].Peaks, cachedChains[chainIndex].Peaks + cachedChains[chainIndex].TotalPeakCount, chain.PeakStorage.get() + chain.AllMips[firstCachedMipIndex].PeakOffset);
+		}
+
+		GenerateFineMipPeaks(GetMipGenerationSource(inSampleBuffer, false), outChains, chainCount, firstCachedMipIndex);
+	}
+
+	// NOTE: Written out as is (little endian) and followed by the peaks of each chain, so that they can be used straight out of the mapped file.
+	//		 The version has to be bumped whenever the generated peaks or this layout change
+	struct WaveformPeakCacheFileHeader
+	{
+		static constexpr char CurrentMagic[8] = { 'P', 'D', 'K', 'P', 'E', 'A', 'K', 'S', };
+		static constexpr u32 CurrentVersion = 1;
+		static constexpr size_t PeakDataAlignment = 16;
+
+		struct MipEntry
+		{
+			u64 PowerOfTwoSampleCount;
+			f64 TimePerSampleSeconds;
+			f64 SamplesPerSecond;
+			u64 PeakOffset;
+			u64 PeakCount;
+		};
+
+		char Magic[8];
+		u32 Version;
+		u32 ChainCount;
+		u64 SourceContentHash;
+		u64 SourceFileSize;
+		u32 MaxMipLevels;
+		u32 MinMipSampleCount;
+		u32 FirstMipIndex;
+		u32 MipCount;
+		f64 DurationSeconds;
+		u64 PeaksPerChain;
+		u64 PeakDataOffset;
+		MipEntry Mips[WaveformMipChain::MaxMipLevels];
+	};
+
+	static_assert(std::is_trivially_copyable_v<WaveformPeak> && sizeof(WaveformPeak) == sizeof(i16[2]));
+	static constexpr size_t WaveformPeakCacheFilePeakDataOffset = (sizeof(WaveformPeakCacheFileHeader) + WaveformPeakCacheFileHeader::PeakDataAlignment - 1) & ~(WaveformPeakCacheFileHeader::PeakDataAlignment - 1);
+
+	b8 WriteWaveformPeakCacheFile(std::string_view filePath, const SourceCacheKey& key, const WaveformMipChain* chains, size_t chainCount)
+	{
+		constexpr size_t firstMipIndex = WaveformMipChain::PeakCacheFirstMipIndex;
+		if (filePath.empty() || chainCount == 0 || chains[0].GetUsedMipCount() <= static_cast<i32>(firstMipIndex))
+			return false;
+
+		const WaveformMipChain& layout = chains[0];
+		const size_t firstPeakOffset = layout.AllMips[firstMipIndex].PeakOffset;
+		const size_t peaksPerChain = (layout.TotalPeakCount - firstPeakOffset);
+
+		WaveformPeakCacheFileHeader header = {};
+		memcpy(header.Magic, WaveformPeakCacheFileHeader::CurrentMagic, sizeof(header.Magic));
+		header.Version = WaveformPeakCacheFileHeader::CurrentVersion;
+		header.ChainCount = static_cast<u32>(chainCount);
+		header.SourceContentHash = key.SourceContentHash;
+		header.SourceFileSize = key.SourceFileSize;
+		header.MaxMipLevels = static_cast<u32>(WaveformMipChain::MaxMipLevels);
+		header.MinMipSampleCount = static_cast<u32>(WaveformMipChain::MinMipSampleCount);
+		header.FirstMipIndex = static_cast<u32>(firstMipIndex);
+		header.MipCount = static_cast<u32>(layout.GetUsedMipCount() - firstMipIndex);
+		header.DurationSeconds = layout.Duration.Seconds;
+		header.PeaksPerChain = peaksPerChain;
+		header.PeakDataOffset = WaveformPeakCacheFilePeakDataOffset;
+		for (size_t i = 0; i < header.MipCount; i++)
+		{
+			const WaveformMip& mip = layout.AllMips[firstMipIndex + i];
+			header.Mips[i] = { mip.PowerOfTwoSampleCount, mip.TimePerSample.Seconds, mip.SamplesPerSecond, (mip.PeakOffset - firstPeakOffset), mip.PeakCount };
+		}
+
+		const size_t peakDataByteSizePerChain = (peaksPerChain * sizeof(WaveformPeak));
+		const size_t fileSize = WaveformPeakCacheFilePeakDataOffset + (peakDataByteSizePerChain * chainCount);
+		auto fileContent = std::unique_ptr<u8[]>(new u8[fileSize]);
+		memset(fileContent.get(), 0, WaveformPeakCacheFilePeakDataOffset);
+		memcpy(fileContent.get(), &header, sizeof(header));
+
+		for (size_t chainIndex = 0; chainIndex < chainCount; chainIndex++)
+		{
+			assert(chains[chainIndex].TotalPeakCount == layout.TotalPeakCount);
+			memcpy(&fileContent[WaveformPeakCacheFilePeakDataOffset + (peakDataByteSizePerChain * chainIndex)], chains[chainIndex].Peaks + firstPeakOffset, peakDataByteSizePerChain);
+		}
+
+		std::string tempFilePath { filePath };
+		tempFilePath += ".tmp";
+		if (!File::WriteAllBytes(tempFilePath, fileContent.get(), fileSize))
+			return false;
+
+		return File::Move(tempFilePath, filePath, true);
+	}
+
+	size_t MapWaveformPeakCacheFile(std::string_view filePath, const SourceCacheKey& key, WaveformMipChain* outChains, size_t maxChainCount)
+	{
+		std::unique_ptr<File::MemoryMappedFile> mappedFile = File::MapReadOnly(filePath);
+		if (mappedFile == nullptr || mappedFile->Size < sizeof(WaveformPeakCacheFileHeader))
+			return 0;
+
+		WaveformPeakCacheFileHeader header;
+		memcpy(&header, mappedFile->Content, sizeof(header));
+
+		const b8 isUpToDate =
+			memcmp(header.Magic, WaveformPeakCacheFileHeader::CurrentMagic, sizeof(header.Magic)) == 0 &&
+			header.Version == WaveformPeakCacheFileHeader::CurrentVersion &&
+			header.SourceContentHash == key.SourceContentHash &&
+			header.SourceFileSize == key.SourceFileSize &&
+			header.MaxMipLevels == WaveformMipChain::MaxMipLevels &&
+			header.MinMipSampleCount == WaveformMipChain::MinMipSampleCount &&
+			header.FirstMipIndex == WaveformMipChain::PeakCacheFirstMipIndex;
+		if (!isUpToDate)
+			return 0;
+
+		// NOTE: Guard against truncated or otherwise corrupted files before pointing anything into the mapped peak data
+		const u64 peakDataByteSizePerChain = (header.PeaksPerChain * sizeof(WaveformPeak));
+		if (header.ChainCount == 0 || header.MipCount == 0 || header.MipCount > WaveformMipChain::MaxMipLevels || header.PeakDataOffset != WaveformPeakCacheFilePeakDataOffset || header.PeakDataOffset > mappedFile->Size)
+			return 0;
+		if (header.PeaksPerChain > (mappedFile->Size / sizeof(WaveformPeak)) || ((mappedFile->Size - header.PeakDataOffset) / header.ChainCount) < peakDataByteSizePerChain)
+			return 0;
+		for (size_t i = 0; i < header.MipCount; i++)
+		{
+			if (header.Mips[i].PeakOffset > header.PeaksPerChain || header.Mips[i].PeakCount > (header.PeaksPerChain - header.Mips[i].PeakOffset))
+				return 0;
+		}
+
+		const std::shared_ptr<const File::MemoryMappedFile> sharedMappedFile = std::move(mappedFile);
+		const size_t chainCount = Min<size_t>(header.ChainCount, maxChainCount);
+		for (size_t chainIndex = 0; chainIndex < chainCount; chainIndex++)
+		{
+			WaveformMipChain& chain = outChains[chainIndex];
+			for (size_t i = 0; i < WaveformMipChain::MaxMipLevels; i++)
+			{
+				WaveformMip& mip = chain.AllMips[i];
+				mip.Clear();
+				if (i < header.MipCount)
+				{
+					mip.PowerOfTwoSampleCount = static_cast<size_t>(header.Mips[i].PowerOfTwoSampleCount);
+					mip.TimePerSample = Time::FromSec(header.Mips[i].TimePerSampleSeconds);
+					mip.SamplesPerSecond = header.Mips[i].SamplesPerSecond;
+					mip.PeakOffset = static_cast<size_t>(header.Mips[i].PeakOffset);
+					mip.PeakCount = static_cast<size_t>(header.Mips[i].PeakCount);
+				}
+			}
+
+			chain.Duration = Time::FromSec(header.DurationSeconds);
+			chain.PeakStorage = nullptr;
+			chain.Peaks = reinterpret_cast<const WaveformPeak*>(sharedMappedFile->Content + header.PeakDataOffset + (peakDataByteSizePerChain * chainIndex));
+			chain.TotalPeakCount = static_cast<size_t>(header.PeaksPerChain);
+			chain.MappedPeakCacheFile = sharedMappedFile;
+		}
+
+		return chainCount;
+	}
+}
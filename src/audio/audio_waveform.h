@@ -1,57 +1,37 @@
 #pragma once
 #include "core_types.h"
 #include "audio_common.h"
+#include "core_io.h"
+#include <functional>
 
 // TODO: Texture cache (create interface for uploading texture pixels to have a clean separation from the actual rendering?)
 
 namespace Audio
 {
-	constexpr i16 AverageTwoI16SamplesTogether(i16 a, i16 b) { return static_cast<i16>((static_cast<i32>(a) + static_cast<i32>(b)) / 2); };
+	// NOTE: Smallest and largest signed sample value within the time span covered by a single mip sample.
+	//		 Intentionally left uninitialized so that the peak storage can be allocated without first having to clear it
+	struct WaveformPeak
+	{
+		i16 Min;
+		i16 Max;
+
+		constexpr i32 GetAbsoluteMax() const { return ::Max(-static_cast<i32>(Min), static_cast<i32>(Max)); }
+		static constexpr WaveformPeak Combine(WaveformPeak a, WaveformPeak b) { return WaveformPeak { ::Min(a.Min, b.Min), ::Max(a.Max, b.Max) }; }
+	};
 
 	struct WaveformMip
 	{
 		size_t PowerOfTwoSampleCount = {};
 		Time TimePerSample = {};
 		f64 SamplesPerSecond = {};
-		std::vector<i16> AbsoluteSamples {};
-
-		inline Time GetDuration() const
-		{
-			return Time::FromSec(static_cast<f64>(AbsoluteSamples.size()) / SamplesPerSecond);
-		}
-
-		inline i16 SampleAtIndexOrZero(size_t sampleIndex) const
-		{
-			return (sampleIndex < AbsoluteSamples.size()) ? AbsoluteSamples[sampleIndex] : static_cast<i16>(0);
-		}
-
-		inline i16 LinearSampleAtTimeOrZero(Time time) const
-		{
-			const f32 sampleIndexF32 = static_cast<f32>(time.Seconds * SamplesPerSecond);
-			const f32 sampleIndexFraction = sampleIndexF32 - static_cast<i32>(sampleIndexF32);
-
-			const size_t sampleIndexLo = (sampleIndexF32 <= 0.0f) ? 0 : static_cast<size_t>(sampleIndexF32);
-			const size_t sampleIndexHi = (sampleIndexLo + 1);
 
-			const i16 sampleLo = SampleAtIndexOrZero(sampleIndexLo);
-			const i16 sampleHi = SampleAtIndexOrZero(sampleIndexHi);
+		// NOTE: View into WaveformMipChain::Peaks, stored as an offset so the chain can be freely moved around
+		size_t PeakOffset = {};
+		size_t PeakCount = {};
 
-			const f32 normalizedSampleLo = static_cast<f32>(sampleLo / static_cast<f32>(I16Max));
-			const f32 normalizedSampleHi = static_cast<f32>(sampleHi / static_cast<f32>(I16Max));
-			const f32 normalizedSample = Lerp(normalizedSampleLo, normalizedSampleHi, sampleIndexFraction);
-
-			return static_cast<i16>(normalizedSample * static_cast<f32>(I16Max));
-		}
-
-		f32 AverageNormalizedSampleInTimeRange(Time startTime, Time endTime) const
+		inline Time GetDuration() const
 		{
-			if (TimePerSample.Seconds <= 0.0) { assert(false); return 0.0f; }
-
-			i32 sampleSum = 0, sampleCount = 0;
-			for (Time timeIt = startTime; timeIt < endTime; timeIt += TimePerSample) { sampleSum += LinearSampleAtTimeOrZero(timeIt); sampleCount++; }
-
-			const i32 sampleAverage = (sampleSum / Max(sampleCount, 1));
-			return sampleAverage / static_cast<f32>(I16Max);
+			return Time::FromSec(static_cast<f64>(PeakCount) / SamplesPerSecond);
 		}
 
 		void Clear()
@@ -59,7 +39,8 @@ namespace Audio
 			PowerOfTwoSampleCount = {};
 			TimePerSample = {};
 			SamplesPerSecond = {};
-			AbsoluteSamples.clear();
+			PeakOffset = {};
+			PeakCount = {};
 		}
 	};
 
@@ -67,8 +48,18 @@ namespace Audio
 	{
 		static constexpr size_t MaxMipLevels = 24;
 		static constexpr size_t MinMipSampleCount = 256;
+		// NOTE: Each of its peaks covers 256 base mip peaks (~10ms at 48kHz), plenty for a zoomed out timeline while being quick to generate straight from the source samples
+		static constexpr size_t CoarseMipIndex = 8;
+		// NOTE: Each of its peaks covers 32 base mip peaks (~1.3ms at 48kHz), only storing the mips from here onwards keeps the peak cache file
+		//		 at a fraction of the size of the decoded audio (which the finer mips would otherwise roughly double) while still covering most zoom levels
+		static constexpr size_t PeakCacheFirstMipIndex = 5;
 
 		WaveformMip AllMips[MaxMipLevels] {};
+		// NOTE: The peaks of all mips, either owned by PeakStorage or pointing into the memory mapped MappedPeakCacheFile
+		const WaveformPeak* Peaks = nullptr;
+		size_t TotalPeakCount = {};
+		std::unique_ptr<WaveformPeak[]> PeakStorage {};
+		std::shared_ptr<const File::MemoryMappedFile> MappedPeakCacheFile {};
 		Time Duration {};
 
 		inline b8 IsEmpty() const
@@ -86,95 +77,94 @@ namespace Audio
 			return static_cast<i32>(MaxMipLevels);
 		}
 
-		inline const WaveformMip& FindClosestMip(Time timePerPixel) const
+		inline const WaveformPeak* GetMipPeaks(const WaveformMip& mip) const
 		{
-			const WaveformMip* closestMip = &AllMips[0];
-			for (size_t i = 1; i < MaxMipLevels; i++)
-			{
-				if (AllMips[i].PowerOfTwoSampleCount == 0)
-					break;
-				if (Absolute((AllMips[i].TimePerSample - timePerPixel).Seconds < Absolute((closestMip->TimePerSample - timePerPixel).Seconds)))
-					closestMip = &AllMips[i];
-			}
-			return *closestMip;
+			return Peaks + mip.PeakOffset;
 		}
 
-		inline f32 GetAmplitudeAt(const WaveformMip& mip, Time time, Time timePerPixel) const
+		inline i32 AbsolutePeakAtIndexOrZero(const WaveformMip& mip, i64 peakIndex) const
 		{
-			return mip.AverageNormalizedSampleInTimeRange(time, time + timePerPixel);
+			return (peakIndex >= 0 && peakIndex < static_cast<i64>(mip.PeakCount)) ? GetMipPeaks(mip)[peakIndex].GetAbsoluteMax() : 0;
 		}
 
-		inline void GenerateEntireMipChainFromSampleBuffer(const PCMSampleBuffer& inSampleBuffer, u32 channelIndex, b8 includeFullSizeMip = false)
+		// NOTE: Coarsest mip that still has at least one peak per pixel, so that no transient can fall in between two pixels
+		inline const WaveformMip& FindMipForTimePerPixel(Time timePerPixel) const
 		{
-			assert(inSampleBuffer.InterleavedSamples != nullptr && channelIndex < inSampleBuffer.ChannelCount);
-
-			Duration = FramesToTime(inSampleBuffer.FrameCount, inSampleBuffer.SampleRate);
-			if (AllMips[0].PowerOfTwoSampleCount != 0)
-				for (auto& mip : AllMips) mip.Clear();
-
-			WaveformMip& baseMip = AllMips[0];
-			baseMip.PowerOfTwoSampleCount = RoundUpToPowerOfTwo(static_cast<u32>(inSampleBuffer.FrameCount));
-			baseMip.TimePerSample = Time::FromSec(1.0 / static_cast<f64>(inSampleBuffer.SampleRate));
-			baseMip.SamplesPerSecond = static_cast<f64>(inSampleBuffer.SampleRate);
-
-			if (includeFullSizeMip)
+			const WaveformMip* bestMip = &AllMips[0];
+			for (size_t i = 1; i < MaxMipLevels; i++)
 			{
-				baseMip.AbsoluteSamples.resize(inSampleBuffer.FrameCount);
-				for (size_t frameIndex = 0; frameIndex < static_cast<size_t>(inSampleBuffer.FrameCount); frameIndex++)
-					baseMip.AbsoluteSamples[frameIndex] = Absolute(inSampleBuffer.InterleavedSamples[(frameIndex * inSampleBuffer.ChannelCount) + channelIndex]);
+				if (AllMips[i].PowerOfTwoSampleCount == 0 || AllMips[i].TimePerSample > timePerPixel)
+					break;
+				bestMip = &AllMips[i];
 			}
-			else // NOTE: No need to waste memory storing the full size mip if it won't even get sampled AND is already duplicated inside the source buffer
+			return *bestMip;
+		}
+
+		// NOTE: Writes the normalized peak amplitude of each pixel covering [startTime + (i * timePerPixel), startTime + ((i + 1) * timePerPixel)).
+		//       Because the selected mip never holds more than two peaks per pixel the cost is linear in the pixel count regardless of the zoom level
+		void GetPeakAmplitudeRow(Time startTime, Time timePerPixel, i32 pixelCount, f32* outAmplitudes) const
+		{
+			if (IsEmpty() || timePerPixel.Seconds <= 0.0)
 			{
-				baseMip.PowerOfTwoSampleCount /= 2;
-				baseMip.TimePerSample = baseMip.TimePerSample * 2.0;
-				baseMip.SamplesPerSecond = baseMip.SamplesPerSecond / 2.0;
-				baseMip.AbsoluteSamples.resize(baseMip.PowerOfTwoSampleCount);
-				const size_t samplesToFill = ClampTop(baseMip.AbsoluteSamples.size(), static_cast<size_t>(inSampleBuffer.FrameCount / 2));
-				for (size_t frameIndex = 0; frameIndex < samplesToFill; frameIndex++)
-				{
-					baseMip.AbsoluteSamples[frameIndex] = AverageTwoI16SamplesTogether(
-						Absolute(inSampleBuffer.InterleavedSamples[(((frameIndex * 2 + 0) * inSampleBuffer.ChannelCount) + channelIndex)]),
-						Absolute(inSampleBuffer.InterleavedSamples[(((frameIndex * 2 + 1) * inSampleBuffer.ChannelCount) + channelIndex)]));
-				}
+				for (i32 pixel = 0; pixel < pixelCount; pixel++)
+					outAmplitudes[pixel] = 0.0f;
+				return;
 			}
 
-			// NOTE: First loop (separated) to compute sample counts
-			for (size_t i = 1; i < MaxMipLevels; i++)
+			const WaveformMip& mip = FindMipForTimePerPixel(timePerPixel);
+			const WaveformPeak* peaks = GetMipPeaks(mip);
+			const i64 peakCount = static_cast<i64>(mip.PeakCount);
+			const f64 samplesPerPixel = (timePerPixel.Seconds * mip.SamplesPerSecond);
+			const f64 firstPixelSample = (startTime.Seconds * mip.SamplesPerSecond);
+			constexpr f32 normalizeFactor = (1.0f / static_cast<f32>(I16Max));
+
+			if (samplesPerPixel < 1.0)
 			{
-				const WaveformMip& parentMip = AllMips[i - 1];
-				if (parentMip.PowerOfTwoSampleCount <= MinMipSampleCount)
-					break;
+				// NOTE: Zoomed in beyond the base mip so interpolate between the two closest peaks instead
+				for (i32 pixel = 0; pixel < pixelCount; pixel++)
+				{
+					const f64 sampleIndexF64 = firstPixelSample + (samplesPerPixel * pixel);
+					const f64 sampleIndexFloor = Floor(sampleIndexF64);
+					const i64 sampleIndex = static_cast<i64>(sampleIndexFloor);
 
-				WaveformMip& newMip = AllMips[i];
-				newMip.PowerOfTwoSampleCount = (parentMip.PowerOfTwoSampleCount / 2);
-				newMip.TimePerSample = (parentMip.TimePerSample * 2.0);
-				newMip.SamplesPerSecond = (parentMip.SamplesPerSecond / 2.0);
+					const f32 peakLo = static_cast<f32>(AbsolutePeakAtIndexOrZero(mip, sampleIndex)) * normalizeFactor;
+					const f32 peakHi = static_cast<f32>(AbsolutePeakAtIndexOrZero(mip, sampleIndex + 1)) * normalizeFactor;
+					outAmplitudes[pixel] = ClampTop(Lerp(peakLo, peakHi, static_cast<f32>(sampleIndexF64 - sampleIndexFloor)), 1.0f);
+				}
+				return;
 			}
 
-			// TODO: Consider having single continuous sample buffer and store view pointer (or start index) inside each WaveformMip
-			[[maybe_unused]] size_t totalSampleCountAcrossAllMips = 0;
-			for (const WaveformMip& mip : AllMips)
-				totalSampleCountAcrossAllMips += (&mip == &baseMip) ? baseMip.AbsoluteSamples.size() : mip.PowerOfTwoSampleCount;
-
-			// NOTE: Second loop to then generate the actual mip sample buffers
-			for (size_t i = 1; i < MaxMipLevels; i++)
+			for (i32 pixel = 0; pixel < pixelCount; pixel++)
 			{
-				const WaveformMip& parentMip = AllMips[i - 1];
-				if (parentMip.PowerOfTwoSampleCount == 0)
-					break;
-				const size_t parentSampleCount = parentMip.AbsoluteSamples.size();
-				const i16* parentSamples = parentMip.AbsoluteSamples.data();
+				const f64 pixelStartSample = firstPixelSample + (samplesPerPixel * pixel);
+				const i64 sampleBegin = Max<i64>(static_cast<i64>(Floor(pixelStartSample)), 0);
+				const i64 sampleEnd = Min<i64>(static_cast<i64>(Ceil(pixelStartSample + samplesPerPixel)), peakCount);
 
-				WaveformMip& thisMip = AllMips[i];
-				thisMip.AbsoluteSamples.resize(thisMip.PowerOfTwoSampleCount);
-				const size_t samplesToFill = ClampTop(thisMip.AbsoluteSamples.size(), (parentSampleCount / 2));
-				for (size_t sampleIndex = 0; sampleIndex < samplesToFill; sampleIndex++)
-				{
-					// ... assert(parentSamples >= &parentMip.AbsoluteSamples.front() && parentSamples <= &parentMip.AbsoluteSamples.back());
-					thisMip.AbsoluteSamples[sampleIndex] = AverageTwoI16SamplesTogether(parentSamples[0], parentSamples[1]);
-					parentSamples += 2;
-				}
+				i32 pixelPeak = 0;
+				for (i64 sampleIndex = sampleBegin; sampleIndex < sampleEnd; sampleIndex++)
+					pixelPeak = Max(pixelPeak, peaks[sampleIndex].GetAbsoluteMax());
+
+				outAmplitudes[pixel] = ClampTop(static_cast<f32>(pixelPeak) * normalizeFactor, 1.0f);
 			}
 		}
 	};
+
+	// NOTE: Invoked from within the generating thread as soon as the coarse mips of every channel are ready, while the finer ones are still being generated.
+	//		 The coarse chains only contain the mips from WaveformMipChain::CoarseMipIndex onwards (so their first mip is already of a lower resolution)
+	//		 and are separate copies that can be moved out of
+	using WaveformCoarseMipsCallback = std::function<void(WaveformMipChain* coarseChains, size_t chainCount)>;
+
+	// NOTE: Generates one mip chain for each of the first chainCount channels, split up into fixed size chunks across multiple threads
+	void GenerateMipChainsFromSampleBuffer(const PCMSampleBuffer& inSampleBuffer, WaveformMipChain* outChains, size_t chainCount, const WaveformCoarseMipsCallback& onCoarseMipsReady = nullptr, b8 includeFullSizeMip = false);
+
+	// NOTE: Fills in the finer mips the peak cache doesn't store in front of its mapped chains (see MapWaveformPeakCacheFile()),
+	//		 copying over the cached mips as is instead of generating the whole chain all over again
+	void CompleteMipChainsFromPeakCache(const PCMSampleBuffer& inSampleBuffer, const WaveformMipChain* cachedChains, WaveformMipChain* outChains, size_t chainCount);
+
+	// NOTE: Writes all mips starting at WaveformMipChain::PeakCacheFirstMipIndex, going through a temporary file so that a half written cache file can never be mapped
+	b8 WriteWaveformPeakCacheFile(std::string_view filePath, const SourceCacheKey& key, const WaveformMipChain* chains, size_t chainCount);
+
+	// NOTE: Maps the cache file and points the chains directly at its peaks without any copying, with their first mip being WaveformMipChain::PeakCacheFirstMipIndex.
+	//		 Returns the number of chains read, which is zero if the file doesn't exist, is stale or was written using different mip parameters
+	size_t MapWaveformPeakCacheFile(std::string_view filePath, const SourceCacheKey& key, WaveformMipChain* outChains, size_t maxChainCount);
 }
@@ -1,193 +1,123 @@
 #include "core_beat.h"
 #include <algorithm>
 
-Time TempoMapAccelerationStructure::ConvertBeatToTimeUsingLookupTableIndexing(Beat beat) const
+size_t TempoMapAccelerationStructure::FindSegmentIndexAtTick(i32 tick) const
 {
-	const i32 beatTickToTimesCount = static_cast<i32>(BeatTickToTimes.size());
-	const i32 totalBeatTicks = beat.Ticks;
+	assert(!Segments.empty() && "Rebuild() must have been called at least once");
 
-	if (totalBeatTicks < 0) // NOTE: Negative tick (tempo changes are assumed to only be positive)
-	{
-		// NOTE: Calculate the duration of a Beat at the first tempo
-		const Time firstTickDuration = Time::FromSec((60.0 / abs(FirstTempoBPM)) / Beat::TicksPerBeat);
-
-		// NOTE: Then scale by the negative tick
-		return firstTickDuration * totalBeatTicks;
-	}
-	else if (totalBeatTicks >= beatTickToTimesCount) // NOTE: Tick is outside the defined tempo map
-	{
-		// NOTE: Take the last calculated time
-		const Time lastTime = GetLastCalculatedTime();
+	// NOTE: Find the last segment starting at or before the tick, with negative ticks falling back to the first segment
+	const auto it = std::upper_bound(Segments.begin(), Segments.end(), tick, [](i32 tick, const TempoSegment& segment) { return tick < segment.StartTick; });
+	return (it == Segments.begin()) ? 0 : static_cast<size_t>(std::distance(Segments.begin(), it) - 1);
+}
 
-		// NOTE: Calculate the duration of a Beat at the last used tempo
-		const Time lastTickDuration = Time::FromSec((60.0 / abs(LastTempoBPM)) / Beat::TicksPerBeat);
+size_t TempoMapAccelerationStructure::FindSegmentIndexAtTime(Time time) const
+{
+	assert(!Segments.empty() && "Rebuild() must have been called at least once");
 
-		// NOTE: Then scale by the remaining ticks
-		const i32 remainingTicks = (totalBeatTicks - beatTickToTimesCount) + 1;
-		return lastTime + (lastTickDuration * remainingTicks);
-	}
-	else // NOTE: Use the pre calculated lookup table directly
-	{
-		return BeatTickToTimes.at(totalBeatTicks);
-	}
+	const auto it = std::upper_bound(Segments.begin(), Segments.end(), time.Seconds, [](f64 time, const TempoSegment& segment) { return time < segment.StartTime; });
+	return (it == Segments.begin()) ? 0 : static_cast<size_t>(std::distance(Segments.begin(), it) - 1);
 }
 
-Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingLookupTableBinarySearch(Time time) const
+Time TempoMapAccelerationStructure::ConvertBeatToTime(Beat beat) const
 {
-	return ConvertTimeToBeatUsingLookupTableBinarySearch(time, false);
+	// NOTE: Negative ticks are extrapolated using the first tempo and ticks past the last tempo change using the last tempo
+	//		 (tempo changes are assumed to only be positive), both of which naturally fall out of the segment math
+	const TempoSegment& segment = Segments[FindSegmentIndexAtTick(beat.Ticks)];
+	return Time::FromSec((segment.TickDuration * (beat.Ticks - segment.StartTick)) + segment.StartTime);
 }
 
-Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingLookupTableBinarySearch(Time time, bool truncTo0) const
+Beat TempoMapAccelerationStructure::ConvertTimeToBeat(Time time) const
 {
-	const i32 beatTickToTimesCount = static_cast<i32>(BeatTickToTimes.size());
-	const Time lastTime = GetLastCalculatedTime();
+	return ConvertTimeToBeat(time, false);
+}
 
+Beat TempoMapAccelerationStructure::ConvertTimeToBeat(Time time, bool truncTo0) const
+{
 	if (time < Time::FromSec(0.0)) // NOTE: Negative time
 	{
-		// NOTE: Calculate the duration of a Beat at the first tempo
-		const Time firstTickDuration = Time::FromSec((60.0 / abs(FirstTempoBPM)) / Beat::TicksPerBeat);
-
-		// NOTE: Then the time by the negative tick, this is assuming all tempo changes happen on positive ticks
-		return Beat(static_cast<i32>(time / firstTickDuration));
+		// NOTE: Scale by the duration of a tick at the first tempo, this is assuming all tempo changes happen on positive ticks
+		return Beat(static_cast<i32>(time.Seconds / Segments.front().TickDuration));
 	}
-	else if (time >= lastTime) // NOTE: Tick is outside the defined tempo map
-	{
-		const Time timePastLast = (time - lastTime);
 
-		// NOTE: Each tick past the end has a duration of this value
-		const Time lastTickDuration = Time::FromSec((60.0 / abs(LastTempoBPM)) / Beat::TicksPerBeat);
+	const size_t segmentIndex = FindSegmentIndexAtTime(time);
+	const TempoSegment& segment = Segments[segmentIndex];
+	const f64 ticksIntoSegment = (time.Seconds - segment.StartTime) / segment.TickDuration;
 
-		// NOTE: So we just have to divide the remaining ticks by the duration
-		const f64 ticks = (timePastLast / lastTickDuration);
-
-		// NOTE: And add it to the last tick
-		return Beat(static_cast<i32>(beatTickToTimesCount + ticks - 1));
+	if ((segmentIndex + 1) == Segments.size()) // NOTE: Time is past the last tempo change
+	{
+		// NOTE: Each tick past the end has the duration of the last tempo so just add the (truncated) remaining ticks
+		return Beat(static_cast<i32>(segment.StartTick + ticksIntoSegment));
 	}
-	else // NOTE: Perform a binary search
+	else // NOTE: Snap to one of the two surrounding ticks
 	{
-		i32 left = 0, right = beatTickToTimesCount - 1;
-
-		while (left <= right)
-		{
-			const i32 mid = (left + right) / 2;
-
-			if (time < BeatTickToTimes[mid])
-				right = mid - 1;
-			else if (time > BeatTickToTimes[mid])
-				left = mid + 1;
-			else
-				return Beat::FromTicks(mid);
-		}
-
-		// left > right
-		return Beat::FromTicks((truncTo0) ? right
-			: (BeatTickToTimes[left] - time) < (time - BeatTickToTimes[right]) ? left : right);
+		const auto tickToTime = [&segment](i32 tick) { return (segment.TickDuration * (tick - segment.StartTick)) + segment.StartTime; };
+
+		// NOTE: Correct for floating point error so that times exactly on a tick always map back to that same tick
+		i32 tickLeft = segment.StartTick + static_cast<i32>(Floor(ticksIntoSegment));
+		if (tickToTime(tickLeft + 1) <= time.Seconds)
+			tickLeft++;
+		else if (tickToTime(tickLeft) > time.Seconds)
+			tickLeft--;
+
+		const i32 tickRight = (tickLeft + 1);
+		return Beat::FromTicks((truncTo0) ? tickLeft
+			: (tickToTime(tickRight) - time.Seconds) < (time.Seconds - tickToTime(tickLeft)) ? tickRight : tickLeft);
 	}
 }
 
-// find the integer HBScroll beat tick by `beat`, and then interpolate or extrapolate to `time`
+// find the HBScroll beat tick at the start of the tempo segment containing `beat`, and then extrapolate to `time`
 // allow over-extrapolating for reproducing TaikoJiro "time offset over tempo change" behavior
-f64 TempoMapAccelerationStructure::ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(Beat beat, Time time) const
+f64 TempoMapAccelerationStructure::ConvertBeatAndTimeToHBScrollBeatTick(Beat beat, Time time) const
 {
-	const i32 beatTickToTimesCount = static_cast<i32>(BeatTickToTimes.size());
-	const i32 totalBeatTicks = beat.Ticks;
-
-	if (totalBeatTicks < 0) // NOTE: Negative tick (tempo changes are assumed to only be positive)
-	{
-		// NOTE: Calculate the duration of a Beat at the first tempo
-		const Time firstTickDuration = Time::FromSec((60.0 / FirstTempoBPM) / Beat::TicksPerBeat);
-
-		// NOTE: Then the time by the negative tick, this is assuming all tempo changes happen on positive ticks
-		return time / firstTickDuration;
-	}
-	else if (totalBeatTicks + 1 >= beatTickToTimesCount) // NOTE: Next tick is outside the defined tempo map
-	{
-		const f64 lastHBScrollBeatTick = GetLastCalculatedHBScrollBeatTick();
-		const Time lastTime = GetLastCalculatedTime();
-		const Time timePastLast = (time - lastTime);
-
-		// NOTE: Each tick past the end has a duration of this value
-		const Time lastTickDuration = Time::FromSec((60.0 / LastTempoBPM) / Beat::TicksPerBeat);
-
-		// NOTE: So we just have to divide the remaining ticks by the duration
-		const f64 ticks = (timePastLast / lastTickDuration);
-
-		// NOTE: And add it to the last tick
-		return (lastHBScrollBeatTick + ticks);
-	}
-	else // NOTE: Use the pre calculated lookup table directly
-	{
-		// find the integer HBScroll beat tick using `beat`, and then interpolate by `time`
-		const i32 totalBeatTicks = beat.Ticks;
-		const f64 timeLeft = BeatTickToTimes.at(totalBeatTicks).Seconds;
-		const f64 timeRight = BeatTickToTimes.at(totalBeatTicks + 1).Seconds;
-		const f64 ticksLeft = BeatTickToHBScrollBeatTicks.at(totalBeatTicks);
-		const f64 ticksRight = BeatTickToHBScrollBeatTicks.at(totalBeatTicks + 1);
-
-		return ConvertRange(timeLeft, timeRight, ticksLeft, ticksRight, time.Seconds);
-	}
+	const TempoSegment& segment = Segments[FindSegmentIndexAtTick(beat.Ticks)];
+	return segment.StartHBScrollBeatTick + (segment.TickSign * (time.Seconds - segment.StartTime) / segment.TickDuration);
 }
 
 Time TempoMapAccelerationStructure::GetLastCalculatedTime() const
 {
-	return BeatTickToTimes.empty() ? Time::Zero() : BeatTickToTimes.back();
+	return Segments.empty() ? Time::Zero() : Time::FromSec(Segments.back().StartTime);
 }
 
 f64 TempoMapAccelerationStructure::GetLastCalculatedHBScrollBeatTick() const
 {
-	return BeatTickToHBScrollBeatTicks.empty() ? 0.0 : BeatTickToHBScrollBeatTicks.back();
+	return Segments.empty() ? 0.0 : Segments.back().StartHBScrollBeatTick;
 }
 
 void TempoMapAccelerationStructure::Rebuild(const TempoChange* inTempoChanges, size_t inTempoCount)
 {
-	const TempoChange* tempoChanges = inTempoChanges;
-	size_t tempoCount = inTempoCount;
+	// NOTE: Implicitly start with the fallback tempo if there isn't any tempo change defined at the very first beat
+	const b8 startsWithFallbackTempo = (inTempoCount < 1 || inTempoChanges[0].Beat > Beat::Zero());
+	const size_t tempoCount = inTempoCount + (startsWithFallbackTempo ? 1 : 0);
+	const auto getTempoChange = [&](size_t index) { return startsWithFallbackTempo ? ((index == 0) ? TempoChange(Beat::Zero(), FallbackTempo) : inTempoChanges[index - 1]) : inTempoChanges[index]; };
 
-	// HACK: Handle this special case here by creating an adjusted copy instead of changing the algorithm itself to not risk accidentally messing anything up
-	if (inTempoCount < 1 || inTempoChanges[0].Beat > Beat::Zero())
-	{
-		TempoBuffer.resize(inTempoCount + 1);
-		TempoBuffer[0] = TempoChange(Beat::Zero(), FallbackTempo);
-		memcpy(TempoBuffer.data() + 1, inTempoChanges, sizeof(TempoChange) * inTempoCount);
-
-		tempoChanges = TempoBuffer.data();
-		tempoCount = TempoBuffer.size();
-	}
-
-	size_t nTickValues = (tempoCount > 0) ? tempoChanges[tempoCount - 1].Beat.Ticks + 1 : 0;
-	BeatTickToTimes.resize(nTickValues);
-	BeatTickToHBScrollBeatTicks.resize(nTickValues);
-
-	f64 lastEndTime = 0.0;
-	i32 lastEndHBScrollBeatTick = 0;
+	Segments.resize(tempoCount);
 	for (size_t tempoChangeIndex = 0; tempoChangeIndex < tempoCount; tempoChangeIndex++)
 	{
-		const TempoChange& tempoChange = tempoChanges[tempoChangeIndex];
+		const TempoChange tempoChange = getTempoChange(tempoChangeIndex);
 
 		const f64 bpm = SafetyCheckTempo(tempoChange.Tempo).BPM;
 		const f64 beatDuration = (60.0 / bpm);
-		const f64 tickDuration = abs(beatDuration / Beat::TicksPerBeat);
-		const f64 tickSign = Sign(beatDuration);
 
-		const b8 isSingleOrLastTempo = (tempoCount == 1) || (tempoChangeIndex == (tempoCount - 1));
-		const size_t timesCount = isSingleOrLastTempo ? BeatTickToTimes.size() : (tempoChanges[tempoChangeIndex + 1].Beat.Ticks);
+		TempoSegment& segment = Segments[tempoChangeIndex];
+		segment.StartTick = tempoChange.Beat.Ticks;
+		segment.TickDuration = abs(beatDuration / Beat::TicksPerBeat);
+		segment.TickSign = Sign(beatDuration);
 
-		for (size_t i = 0, t = tempoChange.Beat.Ticks; t < timesCount; i++, t++)
+		if (tempoChangeIndex == 0)
 		{
-			BeatTickToTimes[t] = Time::FromSec((tickDuration * i) + lastEndTime);
-			BeatTickToHBScrollBeatTicks[t] = ((tickSign * i) + lastEndHBScrollBeatTick);
+			segment.StartTime = 0.0;
+			segment.StartHBScrollBeatTick = 0;
 		}
-
-		if (tempoCount > 1)
+		else
 		{
-			lastEndTime = BeatTickToTimes[timesCount - 1].ToSec() + tickDuration;
-			lastEndHBScrollBeatTick = BeatTickToHBScrollBeatTicks[timesCount - 1] + tickSign;
+			// NOTE: Continue from the end of the previous segment, accumulating in the same order as a per-tick loop would
+			const TempoSegment& previous = Segments[tempoChangeIndex - 1];
+			const i32 previousTickCount = (segment.StartTick - previous.StartTick);
+			segment.StartTime = ((previous.TickDuration * (previousTickCount - 1)) + previous.StartTime) + previous.TickDuration;
+			segment.StartHBScrollBeatTick = previous.StartHBScrollBeatTick + static_cast<i32>(previous.TickSign * previousTickCount);
 		}
 
 		FirstTempoBPM = (tempoChangeIndex == 0) ? bpm : FirstTempoBPM;
 		LastTempoBPM = bpm;
 	}
-
-	if (!TempoBuffer.empty())
-		TempoBuffer.clear();
 }
@@ -175,12 +175,57 @@ struct BeatSortedForwardIterator
 	inline T* Next(std::vector<T>& sortedList, Beat nextBeat) { return const_cast<T*>(Next(std::as_const(sortedList), nextBeat)); }
 };
 
+// NOTE: Augmented max-end tree over the items of a sorted list (by index) to find the items overlapping a beat range in O(log n + k)
+//		 even when there are long items starting way before it. Stored as an implicit complete binary tree with the item end ticks as leaves.
+//		 Kept up to date incrementally: changing a single item in place updates its leaf and ancestors in O(log n), while inserting or removing
+//		 (which shifts all following items) only marks the leaves from there on to be rebuilt by the next overlap query
+struct BeatIntervalIndex
+{
+	static constexpr size_t UpToDate = SIZE_MAX;
+
+	std::vector<i32> MaxEndTicks;
+	size_t LeafCount = 0;
+	// NOTE: Bounds of the time offsets of all items (for the items that have one) by which they are displayed away from the time of their beat.
+	//		 Only ever widened by the incremental updates so they may stay looser than necessary after removals until the next full rebuild
+	Time MinTimeOffset = {}, MaxTimeOffset = {};
+	// NOTE: All leaves starting at this index are outdated, with 0 meaning a full rebuild
+	size_t OutdatedFromIndex = 0;
+	// NOTE: As a cheap extra check for changes done directly to the underlying vector instead of through the list functions
+	const void* BuiltForData = nullptr;
+	size_t BuiltForSize = 0;
+
+	BeatIntervalIndex() = default;
+	BeatIntervalIndex(const BeatIntervalIndex&) {}
+	BeatIntervalIndex(BeatIntervalIndex&&) = default;
+	BeatIntervalIndex& operator=(const BeatIntervalIndex&) { OutdatedFromIndex = 0; return *this; }
+	BeatIntervalIndex& operator=(BeatIntervalIndex&&) = default;
+
+	template <typename T> void RebuildIfOutdated(const std::vector<T>& sortedList);
+	// NOTE: To be called after changing the item at index in place
+	template <typename T> void UpdateAt(const std::vector<T>& sortedList, size_t index);
+	// NOTE: To be called right *before* inserting or removing items at index, shifting all the items after it
+	template <typename T> void InvalidateFrom(const std::vector<T>& sortedList, size_t index);
+	inline void InvalidateAll() { OutdatedFromIndex = 0; }
+
+	// NOTE: Highest index below indexEnd with an item ending at or after minEndTick, or indexEnd if there is none
+	size_t FindLastIndexBefore(size_t indexEnd, i32 minEndTick) const;
+	// NOTE: All indices below indexEnd with an item ending at or after minEndTick, in ascending order
+	template <typename Func> void ForEachIndexBefore(size_t indexEnd, i32 minEndTick, Func perIndexFunc) const;
+
+private:
+	template <typename T> void WidenTimeOffsetBounds(const T& item);
+	inline void InvalidateIfChangedDirectly(const void* data, size_t size) { if (OutdatedFromIndex == UpToDate && (BuiltForData != data || BuiltForSize != size)) OutdatedFromIndex = 0; }
+	size_t FindLastIndexBeforeInSubtree(size_t node, size_t nodeFirstIndex, size_t nodeIndexCount, size_t indexEnd, i32 minEndTick) const;
+	template <typename Func> void ForEachIndexBeforeInSubtree(size_t node, size_t nodeFirstIndex, size_t nodeIndexCount, size_t indexEnd, i32 minEndTick, Func& perIndexFunc) const;
+};
+
 template <typename T>
 struct BeatSortedList
 {
 	using value_type = T;
 
 	std::vector<T> Sorted;
+	mutable BeatIntervalIndex OverlapIndex;
 
 public:
 	T* TryFindLastAtBeat(Beat beat);
@@ -194,6 +239,15 @@ struct BeatSortedList
 	// bypass sanity check, for untrusted inputs
 	T* TryFindOverlappingBeatUntrusted(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck = true);
 	const T* TryFindOverlappingBeatUntrusted(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck = true) const;
+	// NOTE: Same overlap rules as above but for every overlapping item, in ascending beat order
+	template <typename Func> void ForEachOverlappingBeat(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck, Func perItemFunc) const;
+	// NOTE: Min / max time offset of all items, as tracked by the overlap index
+	void GetTimeOffsetBounds(Time& outMin, Time& outMax) const { OverlapIndex.RebuildIfOutdated(Sorted); outMin = OverlapIndex.MinTimeOffset; outMax = OverlapIndex.MaxTimeOffset; }
+
+	// NOTE: Must manually be called after editing the beat, duration or time offset of an item in place (all insert / remove functions already take care of this),
+	//		 preferably the single item version which doesn't require rebuilding the entire index
+	inline void UpdateOverlapIndexAt(size_t index) { OverlapIndex.UpdateAt(Sorted, index); }
+	inline void InvalidateOverlapIndex() { OverlapIndex.InvalidateAll(); }
 
 	// return the to-insert index
 	template <typename Func> size_t InsertOrFunc(const T& valueToInsert, Func funcExist);
@@ -202,8 +256,14 @@ struct BeatSortedList
 	// return the insertion or update index
 	size_t InsertOrUpdate(const T& valueToInsertOrUpdate);
 
+	// NOTE: Merge a run of values (which must already be sorted by beat) in a single pass, equivalent to calling InsertOrFunc() for each value in order
+	template <typename Func> void InsertManyOrFunc(const T* sortedValuesToInsert, size_t valueCount, Func funcExist);
+	void InsertManyOrUpdate(const T* sortedValuesToInsertOrUpdate, size_t valueCount);
+
 	void RemoveAtBeat(Beat beatToFindAndRemove);
 	void RemoveAtIndex(size_t indexToRemove);
+	// NOTE: Remove the items at each of the (sorted) beats in a single pass, equivalent to calling RemoveAtBeat() for each beat
+	void RemoveManyAtBeats(const Beat* sortedBeatsToRemove, size_t beatCount);
 
 	int CountIf(std::function<bool(const T&)> predicate) const { return std::count_if(Sorted.begin(), Sorted.end(), predicate); }
 	std::vector<T> Filter(std::function<bool(const T&)> predicate) const {
@@ -226,20 +286,32 @@ struct BeatSortedList
 
 struct TempoMapAccelerationStructure
 {
-	// NOTE: Pre calculated beat times up to the last tempo change
-	std::vector<Time> BeatTickToTimes;
-	std::vector<i32> BeatTickToHBScrollBeatTicks;
-	std::vector<TempoChange> TempoBuffer;
+	// NOTE: One segment per tempo change, each spanning until the start of the next one (or indefinitely for the last one)
+	//		 so that memory and rebuild time scale with the number of tempo changes instead of the chart length
+	struct TempoSegment
+	{
+		i32 StartTick;
+		i32 StartHBScrollBeatTick;
+		f64 StartTime;
+		f64 TickDuration;
+		f64 TickSign;
+	};
+
+	std::vector<TempoSegment> Segments;
 	f64 FirstTempoBPM = 0.0, LastTempoBPM = 0.0;
 
-	Time ConvertBeatToTimeUsingLookupTableIndexing(Beat beat) const;
-	Beat ConvertTimeToBeatUsingLookupTableBinarySearch(Time time) const;
-	Beat ConvertTimeToBeatUsingLookupTableBinarySearch(Time time, bool truncTo0) const;
-	f64 ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(Beat beat, Time time) const;
+	Time ConvertBeatToTime(Beat beat) const;
+	Beat ConvertTimeToBeat(Time time) const;
+	Beat ConvertTimeToBeat(Time time, bool truncTo0) const;
+	f64 ConvertBeatAndTimeToHBScrollBeatTick(Beat beat, Time time) const;
 
 	Time GetLastCalculatedTime() const;
 	f64 GetLastCalculatedHBScrollBeatTick() const;
 	void Rebuild(const TempoChange* inTempoChanges, size_t inTempoCount);
+
+private:
+	size_t FindSegmentIndexAtTick(i32 tick) const;
+	size_t FindSegmentIndexAtTime(Time time) const;
 };
 
 // NOTE: Used when no other tempo / time signature change is defined (empty list or pre-first beat)
@@ -261,10 +333,10 @@ struct SortedTempoMap
 
 	// NOTE: Must manually be called every time a TempoChange has been edited otherwise Beat <-> Time conversions will be incorrect
 	inline void RebuildAccelerationStructure() { AccelerationStructure.Rebuild(Tempo.data(), Tempo.size()); }
-	inline Time BeatToTime(Beat beat) const { return AccelerationStructure.ConvertBeatToTimeUsingLookupTableIndexing(beat); }
+	inline Time BeatToTime(Beat beat) const { return AccelerationStructure.ConvertBeatToTime(beat); }
 	inline Beat TimeToBeat(Time time) const { return TimeToBeat(time, false); }
-	inline Beat TimeToBeat(Time time, bool truncTo0) const { return AccelerationStructure.ConvertTimeToBeatUsingLookupTableBinarySearch(time, truncTo0); }
-	inline f64 BeatAndTimeToHBScrollBeatTick(Beat beat, Time time) const { return AccelerationStructure.ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(beat, time); }
+	inline Beat TimeToBeat(Time time, bool truncTo0) const { return AccelerationStructure.ConvertTimeToBeat(time, truncTo0); }
+	inline f64 BeatAndTimeToHBScrollBeatTick(Beat beat, Time time) const { return AccelerationStructure.ConvertBeatAndTimeToHBScrollBeatTick(beat, time); }
 
 	struct ForEachBeatBarData { TimeSignature Signature; Beat Beat; i32 BarIndex; b8 IsBar; };
 	template <typename Func>
@@ -331,34 +403,50 @@ T* BeatSortedList<T>::TryFindExactAtBeat(Beat beat)
 	return const_cast<T*>(static_cast<const BeatSortedList<T>*>(this)->TryFindExactAtBeat(beat));
 }
 
+// NOTE: Index of the first item at or after the beat, or the list size if there is none (std::lower_bound)
 template <typename T>
-const T* BeatSortedList<T>::TryFindLastAtBeat(Beat beat) const
+inline size_t SearchForFirstIndexAtOrAfterBeat(const std::vector<T>& sortedList, Beat beat, size_t searchStartIndex = 0)
+{
+	const auto it = std::lower_bound(sortedList.begin() + searchStartIndex, sortedList.end(), beat, [](const T& v, Beat beat) { return GetBeat(v) < beat; });
+	return static_cast<size_t>(std::distance(sortedList.begin(), it));
+}
+
+// NOTE: Index of the first item after the beat, or the list size if there is none (std::upper_bound)
+template <typename T>
+inline size_t SearchForFirstIndexAfterBeat(const std::vector<T>& sortedList, Beat beat, size_t searchStartIndex = 0)
 {
-	// TODO: Optimize using binary search
-	if (Sorted.size() == 0)
-		return nullptr;
-	if (Sorted.size() == 1)
-		return (GetBeat(Sorted[0]) <= beat) ? &Sorted[0] : nullptr;
-	if (beat < GetBeat(Sorted[0]))
-		return nullptr;
-	for (size_t i = 0; i < Sorted.size() - 1; i++)
+	const auto it = std::upper_bound(sortedList.begin() + searchStartIndex, sortedList.end(), beat, [](Beat beat, const T& v) { return beat < GetBeat(v); });
+	return static_cast<size_t>(std::distance(sortedList.begin(), it));
+}
+
+// NOTE: Same as SearchForFirstIndexAtOrAfterBeat() but expanding exponentially from the start index first,
+//		 so that a sequence of searches for increasing beats only costs logarithmic in the distance advanced each
+template <typename T>
+inline size_t GallopForFirstIndexAtOrAfterBeat(const std::vector<T>& sortedList, Beat beat, size_t searchStartIndex)
+{
+	size_t rangeStart = searchStartIndex, rangeEnd = searchStartIndex;
+	for (size_t step = 1; rangeEnd < sortedList.size() && GetBeat(sortedList[rangeEnd]) < beat; step *= 2)
 	{
-		if (GetBeat(Sorted[i]) <= beat && GetBeat(Sorted[i + 1]) > beat)
-			return &Sorted[i];
+		rangeStart = (rangeEnd + 1);
+		rangeEnd = (searchStartIndex + step);
 	}
-	return &Sorted.back();
+	rangeEnd = Min(rangeEnd, sortedList.size());
+	const auto it = std::lower_bound(sortedList.begin() + rangeStart, sortedList.begin() + rangeEnd, beat, [](const T& v, Beat beat) { return GetBeat(v) < beat; });
+	return static_cast<size_t>(std::distance(sortedList.begin(), it));
+}
+
+template <typename T>
+const T* BeatSortedList<T>::TryFindLastAtBeat(Beat beat) const
+{
+	const size_t indexAfter = SearchForFirstIndexAfterBeat(Sorted, beat);
+	return (indexAfter > 0) ? &Sorted[indexAfter - 1] : nullptr;
 }
 
 template <typename T>
 const T* BeatSortedList<T>::TryFindExactAtBeat(Beat beat) const
 {
-	// TODO: Optimize using binary search
-	for (const T& v : Sorted)
-	{
-		if (GetBeat(v) == beat)
-			return &v;
-	}
-	return nullptr;
+	const size_t index = SearchForFirstIndexAtOrAfterBeat(Sorted, beat);
+	return (index < Sorted.size() && GetBeat(Sorted[index]) == beat) ? &Sorted[index] : nullptr;
 }
 
 template <typename T>
@@ -383,40 +471,152 @@ T* BeatSortedList<T>::TryFindOverlappingBeatUntrusted(Beat beatStart, Beat beatE
 template <typename T>
 const T* BeatSortedList<T>::TryFindOverlappingBeatUntrusted(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck) const
 {
-	// TODO: Optimize using binary search
-	const T* found = nullptr;
-	if (inclusiveBeatCheck)
+	// NOTE: Nothing starting past the end of the range can overlap so only the items before it have to be considered
+	const size_t candidateEndIndex = inclusiveBeatCheck ? SearchForFirstIndexAfterBeat(Sorted, beatEnd) : SearchForFirstIndexAtOrAfterBeat(Sorted, beatEnd);
+
+	// NOTE: Of those find the last one still ending inside the range. Long notes may also have other notes "inside"
+	//		 (even if they should't be placable in the first place) so this can't simply stop at the first item ending before the range
+	OverlapIndex.RebuildIfOutdated(Sorted);
+	const i32 minEndTick = inclusiveBeatCheck ? beatStart.Ticks : ClampTop(beatStart.Ticks, I32Max - 1) + 1;
+	const size_t foundIndex = OverlapIndex.FindLastIndexBefore(candidateEndIndex, minEndTick);
+	return (foundIndex < candidateEndIndex) ? &Sorted[foundIndex] : nullptr;
+}
+
+template <typename T> template <typename Func>
+void BeatSortedList<T>::ForEachOverlappingBeat(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck, Func perItemFunc) const
+{
+	const size_t candidateEndIndex = inclusiveBeatCheck ? SearchForFirstIndexAfterBeat(Sorted, beatEnd) : SearchForFirstIndexAtOrAfterBeat(Sorted, beatEnd);
+
+	OverlapIndex.RebuildIfOutdated(Sorted);
+	const i32 minEndTick = inclusiveBeatCheck ? beatStart.Ticks : ClampTop(beatStart.Ticks, I32Max - 1) + 1;
+	OverlapIndex.ForEachIndexBefore(candidateEndIndex, minEndTick, [&](size_t index) { perItemFunc(Sorted[index]); });
+}
+
+template <typename T>
+void BeatIntervalIndex::RebuildIfOutdated(const std::vector<T>& sortedList)
+{
+	InvalidateIfChangedDirectly(sortedList.data(), sortedList.size());
+	if (OutdatedFromIndex == UpToDate)
+		return;
+
+	// NOTE: Leaves are stored at [LeafCount, LeafCount * 2) with the children of node i being at (i * 2) and (i * 2 + 1).
+	//		 Only reallocated once the list no longer fits, otherwise just the outdated leaves (including those of since removed items) are rebuilt
+	size_t firstLeaf = OutdatedFromIndex, endLeaf = Max(sortedList.size(), BuiltForSize);
+	if (firstLeaf == 0 || sortedList.size() > LeafCount)
 	{
-		for (const T& v : Sorted)
+		LeafCount = 1;
+		while (LeafCount < sortedList.size())
+			LeafCount *= 2;
+		MaxEndTicks.resize(LeafCount * 2);
+		MinTimeOffset = MaxTimeOffset = Time::Zero();
+		firstLeaf = 0;
+		endLeaf = LeafCount;
+	}
+
+	for (size_t i = firstLeaf; i < endLeaf; i++)
+	{
+		if (i < sortedList.size())
+		{
+			MaxEndTicks[LeafCount + i] = (GetBeat(sortedList[i]) + GetBeatDuration(sortedList[i])).Ticks;
+			WidenTimeOffsetBounds(sortedList[i]);
+		}
+		else
 		{
-			// NOTE: Only break after a large beat has been found to correctly handle long notes with other notes "inside"
-			//		 (even if they should't be placable in the first place)
-			if (GetBeat(v) <= beatEnd && beatStart <= (GetBeat(v) + GetBeatDuration(v)))
-				found = &v;
-			else if ((GetBeat(v) + GetBeatDuration(v)) > beatEnd)
-				break;
+			MaxEndTicks[LeafCount + i] = I32Min;
 		}
 	}
-	else
+
+	if (firstLeaf < endLeaf)
 	{
-		for (const T& v : Sorted)
+		for (size_t firstNode = (LeafCount + firstLeaf) / 2, lastNode = (LeafCount + endLeaf - 1) / 2; firstNode > 0; firstNode /= 2, lastNode /= 2)
 		{
-			if (GetBeat(v) < beatEnd && beatStart < (GetBeat(v) + GetBeatDuration(v)))
-				found = &v;
-			else if ((GetBeat(v) + GetBeatDuration(v)) > beatEnd)
-				break;
+			for (size_t node = firstNode; node <= lastNode; node++)
+				MaxEndTicks[node] = Max(MaxEndTicks[node * 2], MaxEndTicks[node * 2 + 1]);
 		}
 	}
-	return found;
+
+	OutdatedFromIndex = UpToDate;
+	BuiltForData = static_cast<const void*>(sortedList.data());
+	BuiltForSize = sortedList.size();
+}
+
+template <typename T>
+void BeatIntervalIndex::UpdateAt(const std::vector<T>& sortedList, size_t index)
+{
+	// NOTE: Leaves that are going to be rebuilt anyway can be skipped, while the ones before that still hold the same items
+	InvalidateIfChangedDirectly(sortedList.data(), sortedList.size());
+	if (index >= OutdatedFromIndex || index >= sortedList.size())
+		return;
+
+	size_t node = (LeafCount + index);
+	MaxEndTicks[node] = (GetBeat(sortedList[index]) + GetBeatDuration(sortedList[index])).Ticks;
+	for (node /= 2; node > 0; node /= 2)
+		MaxEndTicks[node] = Max(MaxEndTicks[node * 2], MaxEndTicks[node * 2 + 1]);
+	WidenTimeOffsetBounds(sortedList[index]);
+}
+
+template <typename T>
+void BeatIntervalIndex::InvalidateFrom(const std::vector<T>& sortedList, size_t index)
+{
+	InvalidateIfChangedDirectly(sortedList.data(), sortedList.size());
+	OutdatedFromIndex = Min(OutdatedFromIndex, index);
+}
+
+template <typename T>
+void BeatIntervalIndex::WidenTimeOffsetBounds(const T& item)
+{
+	const Time timeOffset = GetTimeOffset(item);
+	MinTimeOffset = Min(MinTimeOffset, timeOffset);
+	MaxTimeOffset = Max(MaxTimeOffset, timeOffset);
+}
+
+inline size_t BeatIntervalIndex::FindLastIndexBefore(size_t indexEnd, i32 minEndTick) const
+{
+	const size_t foundIndex = (BuiltForSize > 0) ? FindLastIndexBeforeInSubtree(1, 0, LeafCount, Min(indexEnd, BuiltForSize), minEndTick) : BuiltForSize;
+	return (foundIndex < Min(indexEnd, BuiltForSize)) ? foundIndex : indexEnd;
+}
+
+inline size_t BeatIntervalIndex::FindLastIndexBeforeInSubtree(size_t node, size_t nodeFirstIndex, size_t nodeIndexCount, size_t indexEnd, i32 minEndTick) const
+{
+	if (nodeFirstIndex >= indexEnd || MaxEndTicks[node] < minEndTick)
+		return indexEnd;
+	if (nodeIndexCount == 1)
+		return nodeFirstIndex;
+
+	// NOTE: Prefer the right child to find the highest index first
+	const size_t halfCount = (nodeIndexCount / 2);
+	if (const size_t found = FindLastIndexBeforeInSubtree(node * 2 + 1, nodeFirstIndex + halfCount, halfCount, indexEnd, minEndTick); found < indexEnd)
+		return found;
+	return FindLastIndexBeforeInSubtree(node * 2, nodeFirstIndex, halfCount, indexEnd, minEndTick);
+}
+
+template <typename Func>
+void BeatIntervalIndex::ForEachIndexBefore(size_t indexEnd, i32 minEndTick, Func perIndexFunc) const
+{
+	if (BuiltForSize > 0)
+		ForEachIndexBeforeInSubtree(1, 0, LeafCount, Min(indexEnd, BuiltForSize), minEndTick, perIndexFunc);
+}
+
+template <typename Func>
+void BeatIntervalIndex::ForEachIndexBeforeInSubtree(size_t node, size_t nodeFirstIndex, size_t nodeIndexCount, size_t indexEnd, i32 minEndTick, Func& perIndexFunc) const
+{
+	if (nodeFirstIndex >= indexEnd || MaxEndTicks[node] < minEndTick)
+		return;
+	if (nodeIndexCount == 1)
+	{
+		perIndexFunc(nodeFirstIndex);
+		return;
+	}
+
+	const size_t halfCount = (nodeIndexCount / 2);
+	ForEachIndexBeforeInSubtree(node * 2, nodeFirstIndex, halfCount, indexEnd, minEndTick, perIndexFunc);
+	ForEachIndexBeforeInSubtree(node * 2 + 1, nodeFirstIndex + halfCount, halfCount, indexEnd, minEndTick, perIndexFunc);
 }
 
 template <typename T>
-inline size_t LinearlySearchForInsertionIndex(const BeatSortedList<T>& sortedList, Beat beat)
+inline size_t SearchForInsertionIndex(const BeatSortedList<T>& sortedList, Beat beat)
 {
-	// TODO: Optimize using binary search
-	for (size_t i = 0; i < sortedList.size(); i++)
-		if (beat <= GetBeat(sortedList[i])) return i;
-	return sortedList.size();
+	return SearchForFirstIndexAtOrAfterBeat(sortedList.Sorted, beat);
 }
 
 template <typename T>
@@ -428,16 +628,23 @@ inline b8 ValidateIsSortedByBeat(const BeatSortedList<T>& sortedList)
 template <typename T> template <typename Func>
 size_t BeatSortedList<T>::InsertOrFunc(const T& valueToInsert, Func funcExist)
 {
-	const size_t insertionIndex = LinearlySearchForInsertionIndex(*this, GetBeat(valueToInsert));
+	const size_t insertionIndex = SearchForInsertionIndex(*this, GetBeat(valueToInsert));
 	if (InBounds(insertionIndex, Sorted))
 	{
 		if (T& existing = Sorted[insertionIndex]; GetBeat(existing) == GetBeat(valueToInsert))
+		{
 			funcExist(existing, valueToInsert);
+			OverlapIndex.UpdateAt(Sorted, insertionIndex);
+		}
 		else
+		{
+			OverlapIndex.InvalidateFrom(Sorted, insertionIndex);
 			Sorted.insert(Sorted.begin() + insertionIndex, valueToInsert);
+		}
 	}
 	else
 	{
+		OverlapIndex.InvalidateFrom(Sorted, insertionIndex);
 		Sorted.push_back(valueToInsert);
 	}
 
@@ -462,6 +669,52 @@ size_t BeatSortedList<T>::InsertOrUpdate(const T& valueToInsertOrUpdate)
 	return InsertOrFunc(valueToInsertOrUpdate, [&](T& existing, ...) { existing = valueToInsertOrUpdate; });
 }
 
+template <typename T> template <typename Func>
+void BeatSortedList<T>::InsertManyOrFunc(const T* sortedValuesToInsert, size_t valueCount, Func funcExist)
+{
+	if (valueCount == 0)
+		return;
+
+	std::vector<T> merged;
+	merged.reserve(Sorted.size() + valueCount);
+	// NOTE: All existing items before the first value to insert keep their index
+	OverlapIndex.InvalidateFrom(Sorted, SearchForInsertionIndex(*this, GetBeat(sortedValuesToInsert[0])));
+
+	size_t existingIndex = 0;
+	for (size_t i = 0; i < valueCount; i++)
+	{
+		const T& valueToInsert = sortedValuesToInsert[i];
+		assert(i == 0 || GetBeat(sortedValuesToInsert[i - 1]) <= GetBeat(valueToInsert));
+
+		// NOTE: Bulk move over all existing items before the value to insert
+		const size_t existingEndIndex = GallopForFirstIndexAtOrAfterBeat(Sorted, GetBeat(valueToInsert), existingIndex);
+		merged.insert(merged.end(), std::make_move_iterator(Sorted.begin() + existingIndex), std::make_move_iterator(Sorted.begin() + existingEndIndex));
+		existingIndex = existingEndIndex;
+
+		if (InBounds(existingIndex, Sorted) && GetBeat(Sorted[existingIndex]) == GetBeat(valueToInsert))
+			merged.push_back(std::move(Sorted[existingIndex++]));
+
+		// NOTE: Also catches duplicate beats within the inserted values themselves, the same as inserting them one by one would
+		if (!merged.empty() && GetBeat(merged.back()) == GetBeat(valueToInsert))
+			funcExist(merged.back(), valueToInsert);
+		else
+			merged.push_back(valueToInsert);
+	}
+	merged.insert(merged.end(), std::make_move_iterator(Sorted.begin() + existingIndex), std::make_move_iterator(Sorted.end()));
+	Sorted = std::move(merged);
+
+#if PEEPO_DEBUG
+	assert(GetBeat(sortedValuesToInsert[0]).Ticks >= 0);
+	assert(ValidateIsSortedByBeat(*this));
+#endif
+}
+
+template <typename T>
+void BeatSortedList<T>::InsertManyOrUpdate(const T* sortedValuesToInsertOrUpdate, size_t valueCount)
+{
+	InsertManyOrFunc(sortedValuesToInsertOrUpdate, valueCount, [&](T& existing, const T& valueToInsertOrUpdate) { existing = valueToInsertOrUpdate; });
+}
+
 template <typename T>
 void BeatSortedList<T>::RemoveAtBeat(Beat beatToFindAndRemove)
 {
@@ -473,5 +726,38 @@ template <typename T>
 void BeatSortedList<T>::RemoveAtIndex(size_t indexToRemove)
 {
 	if (InBounds(indexToRemove, Sorted))
+	{
+		OverlapIndex.InvalidateFrom(Sorted, indexToRemove);
 		Sorted.erase(Sorted.begin() + indexToRemove);
+	}
+}
+
+template <typename T>
+void BeatSortedList<T>::RemoveManyAtBeats(const Beat* sortedBeatsToRemove, size_t beatCount)
+{
+	// NOTE: Compact all remaining items towards the front in place, skipping over the ones to remove
+	size_t readIndex = 0, writeIndex = 0, firstRemovedIndex = 0;
+	for (size_t i = 0; i < beatCount; i++)
+	{
+		assert(i == 0 || sortedBeatsToRemove[i - 1] <= sortedBeatsToRemove[i]);
+
+		const size_t foundIndex = GallopForFirstIndexAtOrAfterBeat(Sorted, sortedBeatsToRemove[i], readIndex);
+		if (!InBounds(foundIndex, Sorted))
+			break;
+		if (GetBeat(Sorted[foundIndex]) != sortedBeatsToRemove[i])
+			continue;
+		if (readIndex == writeIndex)
+			firstRemovedIndex = foundIndex;
+
+		std::move(Sorted.begin() + readIndex, Sorted.begin() + foundIndex, Sorted.begin() + writeIndex);
+		writeIndex += (foundIndex - readIndex);
+		readIndex = (foundIndex + 1);
+	}
+
+	if (readIndex == writeIndex)
+		return;
+
+	OverlapIndex.InvalidateFrom(Sorted, firstRemovedIndex);
+	std::move(Sorted.begin() + readIndex, Sorted.end(), Sorted.begin() + writeIndex);
+	Sorted.erase(Sorted.end() - (readIndex - writeIndex), Sorted.end());
 }
@@ -160,7 +160,16 @@ namespace File
 
 	b8 WriteAllBytes(std::string_view filePath, const void* fileContent, size_t fileSize)
 	{
-		if (filePath.empty() || fileContent == nullptr)
+		if (fileContent == nullptr)
+			return false;
+
+		const ByteSpan fileContentSpan = { fileContent, fileSize };
+		return WriteAllBytes(filePath, &fileContentSpan, 1);
+	}
+
+	b8 WriteAllBytes(std::string_view filePath, const ByteSpan* fileContentSpans, size_t spanCount)
+	{
+		if (filePath.empty() || fileContentSpans == nullptr)
 			return false;
 
 		const HANDLE fileHandle = ::CreateFileW(UTF8::WideArg(filePath).c_str(), GENERIC_WRITE, (FILE_SHARE_READ | FILE_SHARE_WRITE), NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
@@ -169,14 +178,53 @@ namespace File
 
 		defer { ::CloseHandle(fileHandle); };
 
-		// HACK: Assume the entire file fits inside a single DWORD for now
-		DWORD bytesWritten = 0;
-		if (::WriteFile(fileHandle, fileContent, static_cast<DWORD>(fileSize), &bytesWritten, nullptr) == FALSE)
-			return false;
+		for (size_t i = 0; i < spanCount; i++)
+		{
+			// HACK: Assume each span fits inside a single DWORD for now
+			DWORD bytesWritten = 0;
+			if (::WriteFile(fileHandle, fileContentSpans[i].Data, static_cast<DWORD>(fileContentSpans[i].Size), &bytesWritten, nullptr) == FALSE)
+				return false;
+		}
 
 		return true;
 	}
 
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		if (Content != nullptr) ::UnmapViewOfFile(Content);
+		if (MappingHandle != nullptr) ::CloseHandle(MappingHandle);
+		if (FileHandle != nullptr) ::CloseHandle(FileHandle);
+	}
+
+	std::unique_ptr<MemoryMappedFile> MapReadOnly(std::string_view filePath)
+	{
+		if (filePath.empty())
+			return nullptr;
+
+		const HANDLE fileHandle = ::CreateFileW(UTF8::WideArg(filePath).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+			return nullptr;
+
+		// NOTE: Owning the file handle from here on out so that every early return closes it again
+		auto mappedFile = std::make_unique<MemoryMappedFile>();
+		mappedFile->FileHandle = fileHandle;
+
+		LARGE_INTEGER largeIntegerFileSize = {};
+		if (::GetFileSizeEx(fileHandle, &largeIntegerFileSize) == 0 || largeIntegerFileSize.QuadPart <= 0)
+			return nullptr;
+
+		mappedFile->MappingHandle = ::CreateFileMappingW(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mappedFile->MappingHandle == nullptr)
+			return nullptr;
+
+		mappedFile->Content = static_cast<const u8*>(::MapViewOfFile(mappedFile->MappingHandle, FILE_MAP_READ, 0, 0, 0));
+		if (mappedFile->Content == nullptr)
+			return nullptr;
+
+		mappedFile->Size = static_cast<size_t>(largeIntegerFileSize.QuadPart);
+		return mappedFile;
+	}
+
 	b8 WriteAllBytes(std::string_view filePath, const UniqueFileContent& uniqueFileContent)
 	{
 		return WriteAllBytes(filePath, uniqueFileContent.Content.get(), uniqueFileContent.Size);
@@ -197,6 +245,47 @@ namespace File
 	{
 		return ::CopyFileW(UTF8::WideArg(source).c_str(), UTF8::WideArg(destination).c_str(), !overwriteExisting);
 	}
+
+	b8 Move(std::string_view source, std::string_view destination, b8 overwriteExisting)
+	{
+		return ::MoveFileExW(UTF8::WideArg(source).c_str(), UTF8::WideArg(destination).c_str(), MOVEFILE_COPY_ALLOWED | (overwriteExisting ? MOVEFILE_REPLACE_EXISTING : 0));
+	}
+
+	b8 Delete(std::string_view filePath)
+	{
+		return ::DeleteFileW(UTF8::WideArg(filePath).c_str());
+	}
+
+	u64 HashContent(const void* fileContent, size_t fileSize, u64 seed)
+	{
+		constexpr u64 m = 0xC6A4A7935BD1E995ull;
+		constexpr i32 r = 47;
+
+		const u8* data = static_cast<const u8*>(fileContent);
+		const u8* dataWordsEnd = data + (fileSize & ~static_cast<size_t>(7));
+		u64 h = seed ^ (fileSize * m);
+
+		for (; data != dataWordsEnd; data += sizeof(u64))
+		{
+			u64 k; memcpy(&k, data, sizeof(k));
+			k *= m; k ^= k >> r; k *= m;
+			h ^= k; h *= m;
+		}
+
+		switch (fileSize & 7)
+		{
+		case 7: h ^= static_cast<u64>(data[6]) << 48; [[fallthrough]];
+		case 6: h ^= static_cast<u64>(data[5]) << 40; [[fallthrough]];
+		case 5: h ^= static_cast<u64>(data[4]) << 32; [[fallthrough]];
+		case 4: h ^= static_cast<u64>(data[3]) << 24; [[fallthrough]];
+		case 3: h ^= static_cast<u64>(data[2]) << 16; [[fallthrough]];
+		case 2: h ^= static_cast<u64>(data[1]) << 8; [[fallthrough]];
+		case 1: h ^= static_cast<u64>(data[0]); h *= m;
+		}
+
+		h ^= h >> r; h *= m; h ^= h >> r;
+		return h;
+	}
 }
 
 namespace CommandLine
@@ -50,13 +50,42 @@ namespace File
 		inline std::string_view AsString() const { return std::string_view(reinterpret_cast<const char*>(Content.get()), Size); }
 	};
 
+	// NOTE: Read-only view of the entire file content, paged in by the OS on demand instead of being copied into a heap allocation
+	struct MemoryMappedFile : NonCopyable
+	{
+		const u8* Content = nullptr;
+		size_t Size = 0;
+		void* FileHandle = nullptr;
+		void* MappingHandle = nullptr;
+
+		~MemoryMappedFile();
+		inline std::string_view AsString() const { return std::string_view(reinterpret_cast<const char*>(Content), Size); }
+	};
+
+	// NOTE: A separate piece of memory to be written as part of a larger file
+	struct ByteSpan
+	{
+		const void* Data;
+		size_t Size;
+	};
+
 	UniqueFileContent ReadAllBytes(std::string_view filePath);
 	b8 WriteAllBytes(std::string_view filePath, const void* fileContent, size_t fileSize);
+	// NOTE: Writes all spans back to back, without first having to copy them into a single contiguous buffer
+	b8 WriteAllBytes(std::string_view filePath, const ByteSpan* fileContentSpans, size_t spanCount);
 	b8 WriteAllBytes(std::string_view filePath, const UniqueFileContent& uniqueFileContent);
 	b8 WriteAllBytes(std::string_view filePath, const std::string_view textFileContent);
 
+	// NOTE: Returns null if the file can't be opened or is empty (which can't be mapped)
+	std::unique_ptr<MemoryMappedFile> MapReadOnly(std::string_view filePath);
+
 	b8 Exists(std::string_view filePath);
 	b8 Copy(std::string_view source, std::string_view destination, b8 overwriteExisting = false);
+	b8 Move(std::string_view source, std::string_view destination, b8 overwriteExisting = false);
+	b8 Delete(std::string_view filePath);
+
+	// NOTE: Fast non-cryptographic 64-bit hash (MurmurHash64A), for keying cache files by the content of their source file
+	u64 HashContent(const void* fileContent, size_t fileSize, u64 seed = 0);
 }
 
 namespace Directory
@@ -1,7 +1,19 @@
 #include "core_string.h"
+#include "core_string_cp932.h"
 #include <charconv>
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
+// NOTE: SSE2 is always available on x64 so there is no need for any runtime CPU feature detection
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define CORE_STRING_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define CORE_STRING_USE_SSE2 0
+#endif
+
+#ifdef _WIN32
 static std::string Win32NarrowStdStringWithCodePage(std::wstring_view input, UINT win32CodePage)
 {
 	std::string output;
@@ -29,9 +41,147 @@ static std::wstring Win32WidenStdStringWithCodePage(std::string_view input, UINT
 
 	return utf16Output;
 }
+#endif
+
+// NOTE: Copies over the leading run of 7-bit ASCII bytes as is, which both Shift-JIS and UTF-8 encode identically
+static inline void CopyLeadingASCIIRun(const u8*& in, const u8* inEnd, char*& out)
+{
+#if CORE_STRING_USE_SSE2
+	while ((inEnd - in) >= 16)
+	{
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+		if (_mm_movemask_epi8(chunk) != 0)
+			break;
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), chunk);
+		in += 16; out += 16;
+	}
+#endif
+	while (in < inEnd && *in < 0x80)
+		*out++ = static_cast<char>(*in++);
+}
+
+namespace ShiftJIS
+{
+	// NOTE: KATAKANA MIDDLE DOT, the default character MultiByteToWideChar(932, ...) substitutes for invalid byte sequences
+	static constexpr u16 CP932UTF16ReplacementCharacter = 0x30FB;
+	static constexpr char CP932ReplacementCharacter = '?';
+
+	static constexpr b8 IsCP932LeadByte(u8 byte) { return (byte >= 0x81 && byte <= 0x9F) || (byte >= 0xE0 && byte <= 0xFC); }
+	static constexpr b8 IsCP932TrailByte(u8 byte) { return (byte >= 0x40 && byte <= 0xFC && byte != 0x7F); }
+	static constexpr size_t CP932LeadByteToIndex(u8 leadByte) { return (leadByte <= 0x9F) ? (leadByte - 0x81) : (leadByte - 0xE0 + 0x1F); }
+	static constexpr u8 CP932LeadByteFromIndex(size_t index) { return static_cast<u8>((index < 0x1F) ? (index + 0x81) : (index - 0x1F + 0xE0)); }
+
+	// NOTE: Expects a non-ASCII, non-lead byte
+	static constexpr u16 CP932SingleByteToUTF16(u8 byte)
+	{
+		if (byte >= 0xA1 && byte <= 0xDF) return static_cast<u16>(0xFF61 + (byte - 0xA1)); // NOTE: Half-width katakana
+		if (byte == 0x80) return 0x0080;
+		if (byte == 0xA0) return 0xF8F0;
+		if (byte >= 0xFD) return static_cast<u16>(0xF8F1 + (byte - 0xFD));
+		return CP932UTF16ReplacementCharacter;
+	}
+
+#if PEEPO_DEBUG
+	// NOTE: Every decodable single and double-byte sequence has to re-encode to a code that decodes back to the same character.
+	//		 Byte-identical for all characters that are only mapped once, while duplicates re-encode to their one preferred code instead
+	static b8 ValidateCP932RoundTrip(const u16* utf16ToCP932)
+	{
+		static constexpr auto decode = [](u16 code) -> u16
+		{
+			if (code <= 0xFF)
+				return IsCP932LeadByte(static_cast<u8>(code)) ? 0x0000 : CP932SingleByteToUTF16(static_cast<u8>(code));
+			if (!IsCP932LeadByte(static_cast<u8>(code >> 8)) || !IsCP932TrailByte(static_cast<u8>(code & 0xFF)))
+				return 0x0000;
+			return CP932DoubleByteToUTF16Table[CP932LeadByteToIndex(static_cast<u8>(code >> 8))][(code & 0xFF) - 0x40];
+		};
+
+		for (u32 byte = 0x80; byte <= 0xFF; byte++)
+		{
+			if (!IsCP932LeadByte(static_cast<u8>(byte)) && utf16ToCP932[CP932SingleByteToUTF16(static_cast<u8>(byte))] != byte)
+				return false;
+		}
+
+		for (size_t leadIndex = 0; leadIndex < CP932LeadByteCount; leadIndex++)
+		{
+			for (size_t trailIndex = 0; trailIndex < CP932TrailByteCount; trailIndex++)
+			{
+				const u16 utf16 = CP932DoubleByteToUTF16Table[leadIndex][trailIndex];
+				if (utf16 == 0x0000)
+					continue;
+
+				const u16 code = utf16ToCP932[utf16];
+				if (code == 0x0000 || decode(code) != utf16)
+					return false;
+			}
+		}
+
+		return true;
+	}
+#endif
+
+	// NOTE: Inverse of the decode table, built once on first use. Holds the single or double-byte CP932 code of each UTF-16 code unit or 0x0000 if unmappable.
+	//		 Characters that are mapped more than once prefer the lowest code, except for the NEC-selected IBM extensions (0xED40-0xEEFC)
+	//		 which are only used as a last resort in favor of the IBM extensions (0xFA40-0xFC4B), same as WideCharToMultiByte(932, ...)
+	static const u16* GetUTF16ToCP932Table()
+	{
+		static const std::unique_ptr<u16[]> table = []
+		{
+			std::unique_ptr<u16[]> result = std::make_unique<u16[]>(0x10000);
+			for (u32 byte = 0x80; byte <= 0xFF; byte++)
+			{
+				if (!IsCP932LeadByte(static_cast<u8>(byte)))
+					result[CP932SingleByteToUTF16(static_cast<u8>(byte))] = static_cast<u16>(byte);
+			}
+
+			static constexpr auto isNECSelectedIBMExtension = [](u16 code) { return (code >= 0xED00 && code <= 0xEEFF); };
+			for (size_t leadIndex = 0; leadIndex < CP932LeadByteCount; leadIndex++)
+			{
+				for (size_t trailIndex = 0; trailIndex < CP932TrailByteCount; trailIndex++)
+				{
+					const u16 utf16 = CP932DoubleByteToUTF16Table[leadIndex][trailIndex];
+					const u16 code = static_cast<u16>((CP932LeadByteFromIndex(leadIndex) << 8) | (trailIndex + 0x40));
+					if (utf16 == 0x0000)
+						continue;
+
+					u16& existing = result[utf16];
+					if (existing == 0x0000 || (isNECSelectedIBMExtension(existing) && !isNECSelectedIBMExtension(code)))
+						existing = code;
+				}
+			}
+
+			// NOTE: One-way mappings of the JIS X 0208 variants of characters that CP932 decodes to their fullwidth or Microsoft specific forms instead
+			static constexpr struct { u16 UTF16, Code; } oneWayMappings[] =
+			{
+				{ 0x00A2, 0x8191 }, // CENT SIGN -> FULLWIDTH CENT SIGN
+				{ 0x00A3, 0x8192 }, // POUND SIGN -> FULLWIDTH POUND SIGN
+				{ 0x00AC, 0x81CA }, // NOT SIGN -> FULLWIDTH NOT SIGN
+				{ 0x2016, 0x8161 }, // DOUBLE VERTICAL LINE -> PARALLEL TO
+				{ 0x2212, 0x817C }, // MINUS SIGN -> FULLWIDTH HYPHEN-MINUS
+				{ 0x301C, 0x8160 }, // WAVE DASH -> FULLWIDTH TILDE
+			};
+			for (const auto& mapping : oneWayMappings)
+				result[mapping.UTF16] = mapping.Code;
+
+#if PEEPO_DEBUG
+			assert(ValidateCP932RoundTrip(result.get()));
+#endif
+			return result;
+		}();
+		return table.get();
+	}
+
+	static inline char* WriteUTF16CodeUnitAsUTF8(char* out, u16 codeUnit)
+	{
+		if (codeUnit < 0x80) { *out++ = static_cast<char>(codeUnit); }
+		else if (codeUnit < 0x800) { *out++ = static_cast<char>(0xC0 | (codeUnit >> 6)); *out++ = static_cast<char>(0x80 | (codeUnit & 0x3F)); }
+		else { *out++ = static_cast<char>(0xE0 | (codeUnit >> 12)); *out++ = static_cast<char>(0x80 | ((codeUnit >> 6) & 0x3F)); *out++ = static_cast<char>(0x80 | (codeUnit & 0x3F)); }
+		return out;
+	}
+}
 
 namespace UTF8
 {
+#ifdef _WIN32
 	std::string Narrow(std::wstring_view utf16Input)
 	{
 		return Win32NarrowStdStringWithCodePage(utf16Input, CP_UTF8);
@@ -41,13 +191,52 @@ namespace UTF8
 	{
 		return Win32WidenStdStringWithCodePage(utf8Input, CP_UTF8);
 	}
+#endif
 
 	std::string FromShiftJIS(std::string_view shiftJISInput)
 	{
-		// HACK: Quite inefficient of course but should work just fine for converting small amounts of text here and there
-		return UTF8::Narrow(ShiftJIS::Widen(shiftJISInput));
+		// NOTE: Every CP932 character is within the BMP so a single input byte never turns into more than 3 UTF-8 bytes
+		std::string output;
+		output.resize(shiftJISInput.size() * 3);
+
+		const u8* in = reinterpret_cast<const u8*>(shiftJISInput.data());
+		const u8* const inEnd = in + shiftJISInput.size();
+		char* out = output.data();
+
+		while (in < inEnd)
+		{
+			CopyLeadingASCIIRun(in, inEnd, out);
+			if (in >= inEnd)
+				break;
+
+			const u8 byte = *in;
+			if (ShiftJIS::IsCP932LeadByte(byte))
+			{
+				// NOTE: A lead byte followed by an invalid trail byte only consumes the lead byte itself so that the trail byte can still be decoded on its own
+				if ((in + 1) < inEnd && ShiftJIS::IsCP932TrailByte(in[1]))
+				{
+					const u16 utf16 = ShiftJIS::CP932DoubleByteToUTF16Table[ShiftJIS::CP932LeadByteToIndex(byte)][in[1] - 0x40];
+					out = ShiftJIS::WriteUTF16CodeUnitAsUTF8(out, (utf16 != 0x0000) ? utf16 : ShiftJIS::CP932UTF16ReplacementCharacter);
+					in += 2;
+				}
+				else
+				{
+					out = ShiftJIS::WriteUTF16CodeUnitAsUTF8(out, ShiftJIS::CP932UTF16ReplacementCharacter);
+					in += 1;
+				}
+			}
+			else
+			{
+				out = ShiftJIS::WriteUTF16CodeUnitAsUTF8(out, ShiftJIS::CP932SingleByteToUTF16(byte));
+				in += 1;
+			}
+		}
+
+		output.resize(out - output.data());
+		return output;
 	}
 
+#ifdef _WIN32
 	WideArg::WideArg(std::string_view utf8Input)
 	{
 		// NOTE: Length **without** null terminator
@@ -76,10 +265,12 @@ namespace UTF8
 	{
 		return (convertedLength < ArrayCount(stackBuffer)) ? stackBuffer : heapBuffer.get();
 	}
+#endif
 }
 
 namespace ShiftJIS
 {
+#ifdef _WIN32
 	// NOTE: According to https://docs.microsoft.com/en-us/windows/win32/intl/code-page-identifiers
 	//		 932 | shift_jis | ANSI/OEM Japanese; Japanese (Shift-JIS)
 	static constexpr UINT CP_SHIFT_JIS = 932;
@@ -93,11 +284,64 @@ namespace ShiftJIS
 	{
 		return Win32WidenStdStringWithCodePage(utf8Input, CP_SHIFT_JIS);
 	}
+#endif
 
 	std::string FromUTF8(std::string_view utf8Input)
 	{
-		// HACK: Same problem as UTF8::FromShiftJIS() ...
-		return ShiftJIS::Narrow(UTF8::WideArg(utf8Input).c_str());
+		// NOTE: A single CP932 character never takes up more bytes than its UTF-8 encoding
+		std::string output;
+		output.resize(utf8Input.size());
+
+		const u16* const utf16ToCP932 = GetUTF16ToCP932Table();
+		const u8* in = reinterpret_cast<const u8*>(utf8Input.data());
+		const u8* const inEnd = in + utf8Input.size();
+		char* out = output.data();
+
+		static constexpr auto isContinuation = [](u8 byte) { return (byte & 0xC0) == 0x80; };
+		while (in < inEnd)
+		{
+			CopyLeadingASCIIRun(in, inEnd, out);
+			if (in >= inEnd)
+				break;
+
+			// NOTE: Malformed sequences and code points outside the BMP (none of which exist in CP932) are each replaced by a single '?'
+			const u8 byte = *in;
+			const size_t remaining = static_cast<size_t>(inEnd - in);
+			u32 codePoint = 0xFFFFFFFF;
+			if (byte >= 0xC2 && byte <= 0xDF && remaining >= 2 && isContinuation(in[1]))
+			{
+				codePoint = ((byte & 0x1F) << 6) | (in[1] & 0x3F);
+				in += 2;
+			}
+			else if (byte >= 0xE0 && byte <= 0xEF && remaining >= 3 && isContinuation(in[1]) && isContinuation(in[2]) &&
+				!(byte == 0xE0 && in[1] < 0xA0) && !(byte == 0xED && in[1] >= 0xA0))
+			{
+				codePoint = ((byte & 0x0F) << 12) | ((in[1] & 0x3F) << 6) | (in[2] & 0x3F);
+				in += 3;
+			}
+			else if (byte >= 0xF0 && byte <= 0xF4 && remaining >= 4 && isContinuation(in[1]) && isContinuation(in[2]) && isContinuation(in[3]))
+			{
+				in += 4;
+			}
+			else
+			{
+				in += 1;
+			}
+
+			const u16 code = (codePoint <= 0xFFFF) ? utf16ToCP932[codePoint] : 0x0000;
+			if (code == 0x0000)
+				*out++ = CP932ReplacementCharacter;
+			else if (code <= 0xFF)
+				*out++ = static_cast<char>(code);
+			else
+			{
+				*out++ = static_cast<char>(code >> 8);
+				*out++ = static_cast<char>(code & 0xFF);
+			}
+		}
+
+		output.resize(out - output.data());
+		return output;
 	}
 }
 
@@ -2,6 +2,7 @@
 #include "core_types.h"
 #include <string>
 #include <string_view>
+#include <string.h>
 
 // NOTE: Runs the danger of double evaluating the string expression but I'm starting to get really tired of manually typing out the size cast
 #define StrViewFmtString "%.*s"
@@ -45,6 +46,7 @@ namespace UTF8
 	constexpr b8 HasBOM(std::string_view input) { return (input.size() >= sizeof(BOM_UTF8)) && (input.substr(0, sizeof(BOM_UTF8)) == std::string_view(BOM_UTF8, sizeof(BOM_UTF8))); }
 	constexpr std::string_view TrimBOM(std::string_view inputWithBOM) { return inputWithBOM.substr(sizeof(BOM_UTF8)); }
 
+#ifdef _WIN32
 	// NOTE: Convert UTF-16 to UTF-8
 	std::string Narrow(std::wstring_view utf16Input);
 
@@ -64,17 +66,20 @@ namespace UTF8
 		wchar_t stackBuffer[260];
 		int convertedLength;
 	};
+#endif
 
 	std::string FromShiftJIS(std::string_view shiftJISInput);
 }
 
 namespace ShiftJIS
 {
+#ifdef _WIN32
 	// NOTE: Convert UTF-16 to Shift-JIS
 	std::string Narrow(std::wstring_view utf16Input);
 
 	// NOTE: Convert SHIFT-JIS to UTF-16
 	std::wstring Widen(std::string_view shiftJISInput);
+#endif
 
 	std::string FromUTF8(std::string_view utf8Input);
 }
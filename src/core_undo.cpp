@@ -32,6 +32,9 @@ namespace Undo
 
 			CommandsToExecutedAtEndOfFrame.clear();
 		}
+
+		if (OnEndOfFrameFlush)
+			OnEndOfFrameFlush();
 	}
 
 	void UndoHistory::TryMergeOrExecute(std::unique_ptr<Command> commandToExecute)
@@ -78,6 +81,8 @@ namespace Undo
 		{
 			UndoStack.emplace_back(std::move(commandToExecute))->Redo();
 		}
+
+		UpdateMemoryUsageAndEnforceBudget();
 	}
 
 	void UndoHistory::Undo(size_t count)
@@ -88,8 +93,10 @@ namespace Undo
 				break;
 
 			HasPendingChanges = true;
+			NumberOfChangesMade++;
 			RedoStack.emplace_back(VectorPop(UndoStack))->Undo();
 		}
+		UpdateMemoryUsageAndEnforceBudget();
 	}
 
 	void UndoHistory::Redo(size_t count)
@@ -100,8 +107,10 @@ namespace Undo
 				break;
 
 			HasPendingChanges = true;
+			NumberOfChangesMade++;
 			UndoStack.emplace_back(VectorPop(RedoStack))->Redo();
 		}
+		UpdateMemoryUsageAndEnforceBudget();
 	}
 
 	void UndoHistory::ClearAll()
@@ -110,5 +119,29 @@ namespace Undo
 		if (!CommandsToExecutedAtEndOfFrame.empty()) CommandsToExecutedAtEndOfFrame.clear();
 		if (!UndoStack.empty()) UndoStack.clear();
 		if (!RedoStack.empty()) RedoStack.clear();
+		MemoryUsage = 0;
+		NumberOfDroppedCommands = 0;
+	}
+
+	void UndoHistory::UpdateMemoryUsageAndEnforceBudget()
+	{
+		// NOTE: Summed up again every time because commands are free to grow or shrink whenever they are merged, undone or redone
+		MemoryUsage = 0;
+		for (const auto& command : UndoStack) MemoryUsage += command->GetMemoryUsage();
+		for (const auto& command : RedoStack) MemoryUsage += command->GetMemoryUsage();
+
+		if (MemoryBudget == 0 || MemoryUsage <= MemoryBudget)
+			return;
+
+		// NOTE: Both stacks are ordered from the oldest / furthest away command at the front to the one closest to the current state at the back
+		size_t undoDropCount = 0, redoDropCount = 0;
+		while (MemoryUsage > MemoryBudget && (undoDropCount + 1) < UndoStack.size())
+			MemoryUsage -= UndoStack[undoDropCount++]->GetMemoryUsage();
+		while (MemoryUsage > MemoryBudget && redoDropCount < RedoStack.size())
+			MemoryUsage -= RedoStack[redoDropCount++]->GetMemoryUsage();
+
+		UndoStack.erase(UndoStack.begin(), UndoStack.begin() + undoDropCount);
+		RedoStack.erase(RedoStack.begin(), RedoStack.begin() + redoDropCount);
+		NumberOfDroppedCommands += static_cast<i32>(undoDropCount + redoDropCount);
 	}
 }
@@ -3,6 +3,7 @@
 #include <type_traits>
 #include <string_view>
 #include <vector>
+#include <functional>
 
 namespace Undo
 {
@@ -31,6 +32,9 @@ namespace Undo
 		// NOTE: To be displayed to the user
 		virtual CommandInfo GetInfo() const = 0;
 
+		// NOTE: Rough estimate of the memory held onto by this command, which should be overridden by any command storing its values on the heap
+		virtual size_t GetMemoryUsage() const { return sizeof(Command); }
+
 		// NOTE: Automatically set by the parent UndoHistory, only meant to potentially be displayed to the user
 		CPUTime CreationTime;
 		CPUTime LastMergeTime;
@@ -46,10 +50,16 @@ namespace Undo
 		CommandInfo GetInfo() const override { return { "Unimplemented Command" }; }
 	};
 
+	template <typename T>
+	constexpr size_t GetVectorMemoryUsage(const std::vector<T>& vector) { return vector.capacity() * sizeof(T); }
+
 	struct UndoHistory
 	{
 		std::vector<std::unique_ptr<Command>> UndoStack, RedoStack;
 		std::vector<std::unique_ptr<Command>> CommandsToExecutedAtEndOfFrame;
+		// NOTE: Called once at the end of every frame after all end of frame commands have been executed,
+		//		 for the host application to resolve any expensive updates the commands executed during the frame have deferred
+		std::function<void()> OnEndOfFrameFlush;
 		b8 HasPendingChanges = false;
 		i32 NumberOfChangesMade = 0;
 
@@ -57,6 +67,12 @@ namespace Undo
 		Time CommandMergeTimeThreshold = Time::FromSec(2.0);
 		CPUStopwatch LastExecutedCommandStopwatch = CPUStopwatch::StartNew();
 
+		// NOTE: Once the combined memory usage of both stacks exceeds the budget the oldest undo commands are dropped first, followed by the redo commands furthest away.
+		//		 The most recently executed command is always kept so that it can at least be undone. Zero to disable
+		size_t MemoryBudget = (64 * 1024 * 1024);
+		size_t MemoryUsage = 0;
+		i32 NumberOfDroppedCommands = 0;
+
 	public:
 		template<typename CommandType, typename... Args>
 		void Execute(Args&&... args)
@@ -87,5 +103,8 @@ namespace Undo
 
 		inline void DisallowMergeForLastCommand() { NumberOfCommandsToDisallowMergesFor = 1; }
 		inline void ResetMergeTimeThresholdStopwatch() { LastExecutedCommandStopwatch.Restart(); }
+
+	private:
+		void UpdateMemoryUsageAndEnforceBudget();
 	};
 }
@@ -2,6 +2,10 @@
 #include <algorithm>
 #include <array>
 #include <numeric>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <charconv>
 
 namespace TJA
 {
@@ -165,15 +169,36 @@ namespace TJA
 		return outLines;
 	}
 
-	std::vector<Token> TokenizeLines(const std::vector<std::string_view>& lines)
+	// NOTE: Only worth paying the thread startup cost once there is enough work to split up
+	static constexpr size_t MinLinesPerTokenizeJob = 0x2000;
+	static constexpr size_t MinTokensPerChartBodySegment = 0x400;
+
+	static size_t GetParallelJobCount(size_t workItemCount, size_t minWorkItemsPerJob)
 	{
-		std::vector<Token> outTokens;
-		outTokens.reserve(lines.size());
+		const size_t hardwareThreadCount = Max<size_t>(std::thread::hardware_concurrency(), 1);
+		return Clamp<size_t>(workItemCount / minWorkItemsPerJob, 1, hardwareThreadCount);
+	}
 
-		b8 currentlyBetweenChartStartAndEnd = false;
-		b8 currentlyAfterFirstCourse = false;
+	// NOTE: Runs all jobs across the calling thread plus up to (jobCount - 1) worker threads and waits for them to finish
+	template <typename Func>
+	static void RunParallelJobs(size_t jobCount, Func perJobFunc)
+	{
+		std::vector<std::future<void>> workerFutures;
+		workerFutures.reserve(jobCount);
+		for (size_t jobIndex = 1; jobIndex < jobCount; jobIndex++)
+			workerFutures.push_back(std::async(std::launch::async, [&perJobFunc, jobIndex] { perJobFunc(jobIndex); }));
+
+		if (jobCount > 0)
+			perJobFunc(0);
+		for (auto& future : workerFutures)
+			future.get();
+	}
 
-		for (size_t lineIndex = 0; lineIndex < lines.size(); lineIndex++)
+	// NOTE: Every line is tokenized on its own, without knowing what came before it. Data lines are always output as TokenType::ChartData
+	//		 and unknown headers keep their unscoped key, both of which are then fixed up by ResolveTokenScopes() in a single (cheap) serial pass
+	static void TokenizeLineRange(const std::vector<std::string_view>& lines, size_t lineBegin, size_t lineEnd, std::vector<Token>& outTokens)
+	{
+		for (size_t lineIndex = lineBegin; lineIndex < lineEnd; lineIndex++)
 		{
 			const std::string_view lineFull = lines[lineIndex];
 			std::string_view lineTrimmed = ASCII::Trim(lineFull);
@@ -182,7 +207,7 @@ namespace TJA
 			{
 				Token& newToken = outTokens.emplace_back();
 				newToken.Type = TokenType::EmptyLine;
-				newToken.LineIndex = static_cast<i16>(lineIndex);
+				newToken.LineIndex = static_cast<i32>(lineIndex);
 				newToken.Line = lineTrimmed;
 			}
 			else
@@ -195,7 +220,7 @@ namespace TJA
 				{
 					Token& newToken = outTokens.emplace_back();
 					newToken.Type = TokenType::Unknown;
-					newToken.LineIndex = static_cast<i16>(lineIndex);
+					newToken.LineIndex = static_cast<i32>(lineIndex);
 					newToken.Line = lineTrimmed;
 
 					if (lineTrimmed[0] == '#')
@@ -213,33 +238,17 @@ namespace TJA
 						}
 
 						newToken.Key = GetHashCommandTokenKey(newToken.KeyString);
-						if (newToken.Key == Key::Chart_START)
-							currentlyBetweenChartStartAndEnd = true;
-						else if (newToken.Key == Key::Chart_END)
-							currentlyBetweenChartStartAndEnd = false;
 					}
 					else if (const size_t colonSeparator = lineTrimmed.find_first_of(':'); colonSeparator != std::string_view::npos)
 					{
 						newToken.Type = TokenType::KeyColonValue;
 						newToken.KeyString = lineTrimmed.substr(0, colonSeparator);
 						newToken.ValueString = lineTrimmed.substr(colonSeparator + sizeof(':'));
-
 						newToken.Key = GetKeyColonValueTokenKey(newToken.KeyString);
-						if (newToken.Key == Key::Course_COURSE) {
-							currentlyAfterFirstCourse = true;
-						} else if (currentlyAfterFirstCourse) {
-							// treat unknown headers after first COURSE: as course-scope header
-							if (newToken.Key == Key::Main_Invalid)
-								newToken.Key = Key::Course_Invalid;
-						} else {
-							// treat unknown headers before first COURSE: as file-scope header
-							if (newToken.Key == Key::Course_Unknown)
-								newToken.Key = Key::Main_Unknown;
-						}
 					}
 					else
 					{
-						newToken.Type = currentlyBetweenChartStartAndEnd ? TokenType::ChartData : TokenType::Unknown;
+						newToken.Type = TokenType::ChartData;
 						newToken.KeyString = {};
 						newToken.ValueString = lineTrimmed;
 					}
@@ -249,204 +258,286 @@ namespace TJA
 				{
 					Token& newCommentToken = outTokens.emplace_back();
 					newCommentToken.Type = TokenType::Comment;
-					newCommentToken.LineIndex = static_cast<i16>(lineIndex);
+					newCommentToken.LineIndex = static_cast<i32>(lineIndex);
 					newCommentToken.Line = lineTrimmed;
 					newCommentToken.ValueString = ASCII::Trim(lineCommentSplit.CommentSuffix.substr(sizeof('/') * 2));
 				}
 			}
 		}
-
-		// end-of-file token as implicit `#END`
-		if (!lines.empty())
-			outTokens.push_back({ TokenType::HashChartCommand, Key::Chart_END, static_cast<i16>(size(lines) - 1) });
-
-		return outTokens;
 	}
 
-	ParsedTJA ParseTokens(const std::vector<Token>& tokens, ErrorList& outErrors)
+	static void ResolveTokenScopes(std::vector<Token>& inOutTokens)
 	{
-		static constexpr auto tryParseDefaultForEmpty = [](std::string_view in, auto* out, auto dflt) -> b8 { if (in.empty()) { *out = dflt; return true; } else { return ASCII::TryParse(in, *out); } };
-		static constexpr auto tryParseCommaSeparatedValues = [](std::string_view in, auto* out) -> b8
+		b8 currentlyBetweenChartStartAndEnd = false;
+		b8 currentlyAfterFirstCourse = false;
+
+		for (Token& token : inOutTokens)
 		{
-			i32 count = 0;
-			ASCII::ForEachInCommaSeparatedList(in, [&](std::string_view) { count++; });
-			std::remove_reference_t<decltype(*out)> tmp = {};
-			tmp.reserve(count);
-			b8 allSuccessful = true;
-			ASCII::ForEachInCommaSeparatedList(in, [&](std::string_view valueString)
+			if (token.Type == TokenType::HashChartCommand)
 			{
-				i32 v = 0;
-				allSuccessful &= ASCII::TryParse(ASCII::Trim(valueString), v);
-				tmp.push_back(v);
-			});
-			if (allSuccessful)
-				*out = std::move(tmp);
-			return allSuccessful;
-		};
-		static constexpr auto tryParseDifficultyType = [](std::string_view in, DifficultyType* out) -> b8
-		{
-			if (i32 v; ASCII::TryParse(in, v)) {
-				if (v >= 0 && v < EnumCount<DifficultyType>) { *out = DifficultyType(v); return true; }
-				return false;
+				if (token.Key == Key::Chart_START)
+					currentlyBetweenChartStartAndEnd = true;
+				else if (token.Key == Key::Chart_END)
+					currentlyBetweenChartStartAndEnd = false;
 			}
-			if (ASCII::MatchesInsensitive(in, "easy")) { *out = DifficultyType::Easy; return true; }
-			if (ASCII::MatchesInsensitive(in, "normal")) { *out = DifficultyType::Normal; return true; }
-			if (ASCII::MatchesInsensitive(in, "hard")) { *out = DifficultyType::Hard; return true; }
-			if (ASCII::MatchesInsensitive(in, "oni")) { *out = DifficultyType::Oni; return true; }
-			if (ASCII::MatchesInsensitive(in, "edit")) { *out = DifficultyType::OniUra; return true; }
-			if (ASCII::MatchesInsensitive(in, "tower")) { *out = DifficultyType::Tower; return true; }
-			if (ASCII::MatchesInsensitive(in, "dan")) { *out = DifficultyType::Dan; return true; }
-			if (ASCII::MatchesInsensitive(in, "ura")) { *out = DifficultyType::OniUra; return true; }
-			return false;
-		};
-		static constexpr auto tryParseTime = [](std::string_view in, Time* out) -> b8
-		{
-			if (f32 v; ASCII::TryParse(in, v)) { *out = Time::FromSec(v); return true; }
-			return false;
-		};
-		static constexpr auto tryParseTempo = [](std::string_view in, Tempo* out) -> b8
-		{
-			if (f32 v; ASCII::TryParse(in, v)) { *out = Tempo(v); return true; }
-			return false;
-		};
-		static constexpr auto tryParsePercent = [](std::string_view in, f32* out) -> b8
-		{
-			if (f32 v; ASCII::TryParse(in, v)) { *out = FromPercent(v); return true; }
-			return false;
-		};
-		static constexpr auto tryParseTimeSignature = [](std::string_view in, TimeSignature* out) -> b8
-		{
-			const size_t splitIndex = in.find_first_of("/");
-			if (splitIndex == std::string_view::npos)
-				return false;
-
-			const std::string_view inNum = ASCII::Trim(in.substr(0, splitIndex));
-			const std::string_view inDen = ASCII::Trim(in.substr(splitIndex + 1));
-			if (i32 outNum, outDen; ASCII::TryParse(inNum, outNum) && ASCII::TryParse(inDen, outDen)) {
-				*out = TimeSignature(outNum, outDen);
-				return true;
-			} else {
-				return false;
+			else if (token.Type == TokenType::KeyColonValue)
+			{
+				if (token.Key == Key::Course_COURSE) {
+					currentlyAfterFirstCourse = true;
+				} else if (currentlyAfterFirstCourse) {
+					// treat unknown headers after first COURSE: as course-scope header
+					if (token.Key == Key::Main_Invalid)
+						token.Key = Key::Course_Invalid;
+				} else {
+					// treat unknown headers before first COURSE: as file-scope header
+					if (token.Key == Key::Course_Unknown)
+						token.Key = Key::Main_Unknown;
+				}
 			}
-		};
-		static constexpr auto tryParseNoteTypeChar = [](char in, NoteType* out) -> b8
-		{
-			switch (in)
+			else if (token.Type == TokenType::ChartData && !currentlyBetweenChartStartAndEnd)
 			{
-			case '0': *out = NoteType::None; return true;
-			case '1': *out = NoteType::Don; return true;
-			case '2': *out = NoteType::Ka; return true;
-			case '3': *out = NoteType::DonBig; return true;
-			case '4': *out = NoteType::KaBig; return true;
-			case '5': *out = NoteType::Start_Drumroll; return true;
-			case '6': *out = NoteType::Start_DrumrollBig; return true;
-			case '7': *out = NoteType::Start_Balloon; return true;
-			case '8': *out = NoteType::End_BalloonOrDrumroll; return true;
-			case '9': *out = NoteType::Start_BaloonSpecial; return true;
-			case 'A': *out = NoteType::DonBigBoth; return true;
-			case 'B': *out = NoteType::KaBigBoth; return true;
-			case 'C': *out = NoteType::Bomb; return true;
-			case 'D': *out = NoteType::Fuse; return true;
-			case 'F': *out = NoteType::Hidden; return true;
-			case 'G': *out = NoteType::KaDon; return true;
-			default: return false;
+				token.Type = TokenType::Unknown;
 			}
-		};
-		static constexpr auto tryParseScoreMode = [](std::string_view in, ScoreMode* out) -> b8
-		{
-			if (in == "0") { *out = ScoreMode::AC2_To_AC7_Oni; return true; }
-			if (in == "1") { *out = ScoreMode::AC1_To_AC14; return true; }
-			if (in == "2") { *out = ScoreMode::AC15; return true; }
-			return false;
-		};
-		static constexpr auto tryParseSongSelectSide = [](std::string_view in, SongSelectSide* out) -> b8
-		{
-			if (ASCII::MatchesInsensitive(in, "Normal") || in == "1") { *out = SongSelectSide::Normal; return true; }
-			if (ASCII::MatchesInsensitive(in, "Ex") || in == "2") { *out = SongSelectSide::Ex; return true; }
-			if (ASCII::MatchesInsensitive(in, "Both") || in == "3") { *out = SongSelectSide::Both; return true; }
-			return false;
-		};
-		static constexpr auto tryParseGameType = [](std::string_view in, GameType* out) -> b8
-		{
-			if (ASCII::MatchesInsensitive(in, "Taiko")) { *out = GameType::Taiko; return true; }
-			if (ASCII::MatchesInsensitive(in, "Konga")) { *out = GameType::Konga; return true; }
-			if (ASCII::MatchesInsensitive(in, "Bongo")) { *out = GameType::Konga; return true; } // Alias for Konga
-			return false;
-		};
-		static constexpr auto tryParseScrollDirection = [](std::string_view in, ScrollDirection* out) -> b8
-		{
-			if (i32 v; ASCII::TryParse(in, v)) { *out = static_cast<ScrollDirection>(v); return true; }
-			return false;
-		};
-		static constexpr auto tryParseBranchCondition = [](std::string_view in, BranchCondition* out) -> b8
+		}
+	}
+
+	std::vector<Token> TokenizeLines(const std::vector<std::string_view>& lines)
+	{
+		std::vector<Token> outTokens;
+
+		const size_t jobCount = GetParallelJobCount(lines.size(), MinLinesPerTokenizeJob);
+		if (jobCount <= 1)
 		{
-			if (ASCII::MatchesInsensitive(in, "r")) { *out = BranchCondition::Roll; return true; }
-			if (ASCII::MatchesInsensitive(in, "p")) { *out = BranchCondition::Precise; return true; }
-			if (ASCII::MatchesInsensitive(in, "s")) { *out = BranchCondition::Score; return true; }
-			return false;
-		};
-		static constexpr auto tryParseStyleMode = [](std::string_view in, i32* out) -> b8
+			outTokens.reserve(lines.size() + 1);
+			TokenizeLineRange(lines, 0, lines.size(), outTokens);
+		}
+		else
 		{
-			if (ASCII::MatchesInsensitive(in, "Single")) { *out = 1; return true; }
-			if (ASCII::MatchesInsensitive(in, "Double") || ASCII::MatchesInsensitive(in, "Couple")) { *out = 2; return true; }
-			if (ASCII::TryParse(in, *out) && *out > 0) { return true; }
-			return false;
-		};
-		static constexpr auto tryParsePlayerSide = [](std::string_view in, i32* out) -> b8
+			std::vector<std::vector<Token>> perJobTokens(jobCount);
+			RunParallelJobs(jobCount, [&](size_t jobIndex)
+			{
+				const size_t lineBegin = (lines.size() * (jobIndex + 0)) / jobCount;
+				const size_t lineEnd = (lines.size() * (jobIndex + 1)) / jobCount;
+				perJobTokens[jobIndex].reserve(lineEnd - lineBegin);
+				TokenizeLineRange(lines, lineBegin, lineEnd, perJobTokens[jobIndex]);
+			});
+
+			size_t totalTokenCount = 1;
+			for (const auto& jobTokens : perJobTokens)
+				totalTokenCount += jobTokens.size();
+
+			outTokens.reserve(totalTokenCount);
+			for (const auto& jobTokens : perJobTokens)
+				outTokens.insert(outTokens.end(), jobTokens.begin(), jobTokens.end());
+		}
+
+		ResolveTokenScopes(outTokens);
+
+		// end-of-file token as implicit `#END`
+		if (!lines.empty())
+			outTokens.push_back({ TokenType::HashChartCommand, Key::Chart_END, static_cast<i32>(size(lines) - 1) });
+
+		return outTokens;
+	}
+
+	static constexpr auto tryParseDefaultForEmpty = [](std::string_view in, auto* out, auto dflt) -> b8 { if (in.empty()) { *out = dflt; return true; } else { return ASCII::TryParse(in, *out); } };
+	static constexpr auto tryParseCommaSeparatedValues = [](std::string_view in, auto* out) -> b8
+	{
+		i32 count = 0;
+		ASCII::ForEachInCommaSeparatedList(in, [&](std::string_view) { count++; });
+		std::remove_reference_t<decltype(*out)> tmp = {};
+		tmp.reserve(count);
+		b8 allSuccessful = true;
+		ASCII::ForEachInCommaSeparatedList(in, [&](std::string_view valueString)
 		{
-			if (in.empty()) { *out = 0; return true; }
-			if (ASCII::MatchesInsensitive(in.substr(0, 1), "P") && ASCII::TryParse(in.substr(1), *out) && *out > 0) { return true; }
+			i32 v = 0;
+			allSuccessful &= ASCII::TryParse(ASCII::Trim(valueString), v);
+			tmp.push_back(v);
+		});
+		if (allSuccessful)
+			*out = std::move(tmp);
+		return allSuccessful;
+	};
+	static constexpr auto tryParseDifficultyType = [](std::string_view in, DifficultyType* out) -> b8
+	{
+		if (i32 v; ASCII::TryParse(in, v)) {
+			if (v >= 0 && v < EnumCount<DifficultyType>) { *out = DifficultyType(v); return true; }
 			return false;
-		};
-		static constexpr auto tryParseGaugeIncrementMethod = [](std::string_view in, GaugeIncrementMethod* out) -> b8
-		{
-			if (ASCII::MatchesInsensitive(in, "NORMAL")) { *out = GaugeIncrementMethod::Normal; return true; }
-			if (ASCII::MatchesInsensitive(in, "FLOOR")) { *out = GaugeIncrementMethod::Floor; return true; }
-			if (ASCII::MatchesInsensitive(in, "ROUND")) { *out = GaugeIncrementMethod::Round; return true; }
-			if (ASCII::MatchesInsensitive(in, "NOTFIX")) { *out = GaugeIncrementMethod::NotFix; return true; }
-			if (ASCII::MatchesInsensitive(in, "CEILING")) { *out = GaugeIncrementMethod::Ceiling; return true; }
+		}
+		if (ASCII::MatchesInsensitive(in, "easy")) { *out = DifficultyType::Easy; return true; }
+		if (ASCII::MatchesInsensitive(in, "normal")) { *out = DifficultyType::Normal; return true; }
+		if (ASCII::MatchesInsensitive(in, "hard")) { *out = DifficultyType::Hard; return true; }
+		if (ASCII::MatchesInsensitive(in, "oni")) { *out = DifficultyType::Oni; return true; }
+		if (ASCII::MatchesInsensitive(in, "edit")) { *out = DifficultyType::OniUra; return true; }
+		if (ASCII::MatchesInsensitive(in, "tower")) { *out = DifficultyType::Tower; return true; }
+		if (ASCII::MatchesInsensitive(in, "dan")) { *out = DifficultyType::Dan; return true; }
+		if (ASCII::MatchesInsensitive(in, "ura")) { *out = DifficultyType::OniUra; return true; }
+		return false;
+	};
+	static constexpr auto tryParseTime = [](std::string_view in, Time* out) -> b8
+	{
+		if (f32 v; ASCII::TryParse(in, v)) { *out = Time::FromSec(v); return true; }
+		return false;
+	};
+	static constexpr auto tryParseTempo = [](std::string_view in, Tempo* out) -> b8
+	{
+		if (f32 v; ASCII::TryParse(in, v)) { *out = Tempo(v); return true; }
+		return false;
+	};
+	static constexpr auto tryParsePercent = [](std::string_view in, f32* out) -> b8
+	{
+		if (f32 v; ASCII::TryParse(in, v)) { *out = FromPercent(v); return true; }
+		return false;
+	};
+	static constexpr auto tryParseTimeSignature = [](std::string_view in, TimeSignature* out) -> b8
+	{
+		const size_t splitIndex = in.find_first_of("/");
+		if (splitIndex == std::string_view::npos)
 			return false;
-		};
-		static constexpr auto tryParseLocaleSuffix = [](std::string_view in, std::string_view prefix, std::string_view* out) -> b8
-		{
-			*out = ASCII::TrimPrefix(in, prefix);
-			return std::regex_match(begin(*out), end(*out), ASCII::PatIETFLangTagForTJA);
-		};
-		static constexpr auto tryParseNotesDesignerSuffix = [](std::string_view in, std::string_view prefix, std::string* outString, DifficultyType* out) -> b8
-		{
-			*outString = ASCII::TrimPrefix(in, prefix);
-			if (outString->empty()) { *out = DifficultyType::Count; return true; }
-			if (i32 v; ASCII::TryParse(*outString, v)) { *out = static_cast<DifficultyType>(v); return (*out >= DifficultyType{ 0 } && *out < DifficultyType::Count); }
+
+		const std::string_view inNum = ASCII::Trim(in.substr(0, splitIndex));
+		const std::string_view inDen = ASCII::Trim(in.substr(splitIndex + 1));
+		if (i32 outNum, outDen; ASCII::TryParse(inNum, outNum) && ASCII::TryParse(inDen, outDen)) {
+			*out = TimeSignature(outNum, outDen);
+			return true;
+		} else {
 			return false;
-		};
-		static constexpr auto tryParseExamSuffix = [](std::string_view in, std::string_view prefix, std::string* outString, i32* out) -> b8
+		}
+	};
+	static constexpr auto tryParseNoteTypeChar = [](char in, NoteType* out) -> b8
+	{
+		switch (in)
 		{
-			*outString = ASCII::TrimPrefix(in, prefix);
-			if (i32 v; ASCII::TryParse(*outString, v) && v > 0) { *out = v; return true; }
-			if (*outString == "GAUGE") { *out = 0; return true; }
-			return false;
-		};
+		case '0': *out = NoteType::None; return true;
+		case '1': *out = NoteType::Don; return true;
+		case '2': *out = NoteType::Ka; return true;
+		case '3': *out = NoteType::DonBig; return true;
+		case '4': *out = NoteType::KaBig; return true;
+		case '5': *out = NoteType::Start_Drumroll; return true;
+		case '6': *out = NoteType::Start_DrumrollBig; return true;
+		case '7': *out = NoteType::Start_Balloon; return true;
+		case '8': *out = NoteType::End_BalloonOrDrumroll; return true;
+		case '9': *out = NoteType::Start_BaloonSpecial; return true;
+		case 'A': *out = NoteType::DonBigBoth; return true;
+		case 'B': *out = NoteType::KaBigBoth; return true;
+		case 'C': *out = NoteType::Bomb; return true;
+		case 'D': *out = NoteType::Fuse; return true;
+		case 'F': *out = NoteType::Hidden; return true;
+		case 'G': *out = NoteType::KaDon; return true;
+		default: return false;
+		}
+	};
+	static constexpr auto tryParseScoreMode = [](std::string_view in, ScoreMode* out) -> b8
+	{
+		if (in == "0") { *out = ScoreMode::AC2_To_AC7_Oni; return true; }
+		if (in == "1") { *out = ScoreMode::AC1_To_AC14; return true; }
+		if (in == "2") { *out = ScoreMode::AC15; return true; }
+		return false;
+	};
+	static constexpr auto tryParseSongSelectSide = [](std::string_view in, SongSelectSide* out) -> b8
+	{
+		if (ASCII::MatchesInsensitive(in, "Normal") || in == "1") { *out = SongSelectSide::Normal; return true; }
+		if (ASCII::MatchesInsensitive(in, "Ex") || in == "2") { *out = SongSelectSide::Ex; return true; }
+		if (ASCII::MatchesInsensitive(in, "Both") || in == "3") { *out = SongSelectSide::Both; return true; }
+		return false;
+	};
+	static constexpr auto tryParseGameType = [](std::string_view in, GameType* out) -> b8
+	{
+		if (ASCII::MatchesInsensitive(in, "Taiko")) { *out = GameType::Taiko; return true; }
+		if (ASCII::MatchesInsensitive(in, "Konga")) { *out = GameType::Konga; return true; }
+		if (ASCII::MatchesInsensitive(in, "Bongo")) { *out = GameType::Konga; return true; } // Alias for Konga
+		return false;
+	};
+	static constexpr auto tryParseScrollDirection = [](std::string_view in, ScrollDirection* out) -> b8
+	{
+		if (i32 v; ASCII::TryParse(in, v)) { *out = static_cast<ScrollDirection>(v); return true; }
+		return false;
+	};
+	static constexpr auto tryParseBranchCondition = [](std::string_view in, BranchCondition* out) -> b8
+	{
+		if (ASCII::MatchesInsensitive(in, "r")) { *out = BranchCondition::Roll; return true; }
+		if (ASCII::MatchesInsensitive(in, "p")) { *out = BranchCondition::Precise; return true; }
+		if (ASCII::MatchesInsensitive(in, "s")) { *out = BranchCondition::Score; return true; }
+		return false;
+	};
+	static constexpr auto tryParseStyleMode = [](std::string_view in, i32* out) -> b8
+	{
+		if (ASCII::MatchesInsensitive(in, "Single")) { *out = 1; return true; }
+		if (ASCII::MatchesInsensitive(in, "Double") || ASCII::MatchesInsensitive(in, "Couple")) { *out = 2; return true; }
+		if (ASCII::TryParse(in, *out) && *out > 0) { return true; }
+		return false;
+	};
+	static constexpr auto tryParsePlayerSide = [](std::string_view in, i32* out) -> b8
+	{
+		if (in.empty()) { *out = 0; return true; }
+		if (ASCII::MatchesInsensitive(in.substr(0, 1), "P") && ASCII::TryParse(in.substr(1), *out) && *out > 0) { return true; }
+		return false;
+	};
+	static constexpr auto tryParseGaugeIncrementMethod = [](std::string_view in, GaugeIncrementMethod* out) -> b8
+	{
+		if (ASCII::MatchesInsensitive(in, "NORMAL")) { *out = GaugeIncrementMethod::Normal; return true; }
+		if (ASCII::MatchesInsensitive(in, "FLOOR")) { *out = GaugeIncrementMethod::Floor; return true; }
+		if (ASCII::MatchesInsensitive(in, "ROUND")) { *out = GaugeIncrementMethod::Round; return true; }
+		if (ASCII::MatchesInsensitive(in, "NOTFIX")) { *out = GaugeIncrementMethod::NotFix; return true; }
+		if (ASCII::MatchesInsensitive(in, "CEILING")) { *out = GaugeIncrementMethod::Ceiling; return true; }
+		return false;
+	};
+	static constexpr auto tryParseLocaleSuffix = [](std::string_view in, std::string_view prefix, std::string_view* out) -> b8
+	{
+		*out = ASCII::TrimPrefix(in, prefix);
+		return std::regex_match(begin(*out), end(*out), ASCII::PatIETFLangTagForTJA);
+	};
+	static constexpr auto tryParseNotesDesignerSuffix = [](std::string_view in, std::string_view prefix, std::string* outString, DifficultyType* out) -> b8
+	{
+		*outString = ASCII::TrimPrefix(in, prefix);
+		if (outString->empty()) { *out = DifficultyType::Count; return true; }
+		if (i32 v; ASCII::TryParse(*outString, v)) { *out = static_cast<DifficultyType>(v); return (*out >= DifficultyType{ 0 } && *out < DifficultyType::Count); }
+		return false;
+	};
+	static constexpr auto tryParseExamSuffix = [](std::string_view in, std::string_view prefix, std::string* outString, i32* out) -> b8
+	{
+		*outString = ASCII::TrimPrefix(in, prefix);
+		if (i32 v; ASCII::TryParse(*outString, v) && v > 0) { *out = v; return true; }
+		if (*outString == "GAUGE") { *out = 0; return true; }
+		return false;
+	};
 
-		static constexpr auto validateEndOfMeasureNoteCount = [](i32 noteCountAtEndOfMeasure, i32 lineIndex, ErrorList& outErrors)
-		{
-			if (noteCountAtEndOfMeasure <= 1)
-				return;
+	static constexpr auto validateEndOfMeasureNoteCount = [](i32 noteCountAtEndOfMeasure, i32 lineIndex, ErrorList& outErrors)
+	{
+		if (noteCountAtEndOfMeasure <= 1)
+			return;
 
 #if 0 // TODO: JUMP HERE
-			static constexpr i32 supported4By4BarDivisions[] = { 1, 2, 4, 8, 12, 16, 24, 32, 48, 64, 96, 192 };
-			for (const i32 supportedDivision : supported4By4BarDivisions)
-			{
-				if (noteCountAtEndOfMeasure == supportedDivision)
-					return;
-			}
+		static constexpr i32 supported4By4BarDivisions[] = { 1, 2, 4, 8, 12, 16, 24, 32, 48, 64, 96, 192 };
+		for (const i32 supportedDivision : supported4By4BarDivisions)
+		{
+			if (noteCountAtEndOfMeasure == supportedDivision)
+				return;
+		}
 
-			// TODO: Also needs to take time signature into account..?
-			// TODO: Report error if measure note count not nicely divisible assuming max 1/192nd (?)
-			outErrors.Push(lineIndex, "Unusual note count measure division (?)");
+		// TODO: Also needs to take time signature into account..?
+		// TODO: Report error if measure note count not nicely divisible assuming max 1/192nd (?)
+		outErrors.Push(lineIndex, "Unusual note count measure division (?)");
 #endif
+	};
+
+	// NOTE: All parser state that carries over from one token to the next
+	struct TokenParser
+	{
+		// NOTE: Subset of the state that a #START / #END chart body reads from and leaves behind
+		struct ChartBodyState
+		{
+			i32 MeasureNoteCount;
+			b8 BetweenGoGoStartAndEnd;
+			b8 InBetweenMeasure;
+			Complex ScrollSpeed;
+
+			constexpr b8 operator==(const ChartBodyState& other) const { return (MeasureNoteCount == other.MeasureNoteCount) && (BetweenGoGoStartAndEnd == other.BetweenGoGoStartAndEnd) && (InBetweenMeasure == other.InBetweenMeasure) && (ScrollSpeed == other.ScrollSpeed); }
+			constexpr b8 operator!=(const ChartBodyState& other) const { return !(*this == other); }
 		};
 
-		ParsedTJA outTJA = {};
+		ParsedTJA& outTJA;
+		ErrorList& outErrors;
 
 		i32 currentMeasureNoteCount = 0;
 		b8 currentlyBetweenFirstCommandAndEnd = false;
@@ -457,12 +548,27 @@ namespace TJA
 
 		// chart scope handler
 		DifficultyType currentCourseScope = DifficultyType::Count; // default course scope
-		auto idxLastCourses = InitializedArray<i32, EnumCount<DifficultyType> + 1>(-1);
+		std::array<i32, EnumCount<DifficultyType> + 1> idxLastCourses = InitializedArray<i32, EnumCount<DifficultyType> + 1>(-1);
 		std::string notesDesigners[EnumCount<DifficultyType>] = {};
 
 		ParsedCourse* currentCourse = nullptr;
 
-		auto initCurrentCourse = [&]()
+		TokenParser(ParsedTJA& outTJA, ErrorList& outErrors) : outTJA(outTJA), outErrors(outErrors) {}
+
+		ChartBodyState GetChartBodyState() const
+		{
+			return ChartBodyState { currentMeasureNoteCount, currentlyBetweenGoGoStartAndEnd, currentlyInBetweenMeasure, cachedScrollSpeed };
+		}
+
+		void SetChartBodyState(const ChartBodyState& state)
+		{
+			currentMeasureNoteCount = state.MeasureNoteCount;
+			currentlyBetweenGoGoStartAndEnd = state.BetweenGoGoStartAndEnd;
+			currentlyInBetweenMeasure = state.InBetweenMeasure;
+			cachedScrollSpeed = state.ScrollSpeed;
+		}
+
+		b8 initCurrentCourse()
 		{
 			for (auto courseScope : { currentCourseScope, DifficultyType::Count }) {
 				if (auto idx = idxLastCourses[EnumToIndex(courseScope)]; idx >= 0) {
@@ -475,26 +581,27 @@ namespace TJA
 		set_up_course:
 			currentCourse->HasChart = false;
 			b8 fromScratch = (idxLastCourses[EnumToIndex(currentCourseScope)] == -1);
-			idxLastCourses[EnumToIndex(currentCourseScope)] = outTJA.Courses.size() - 1;
+			idxLastCourses[EnumToIndex(currentCourseScope)] = static_cast<i32>(outTJA.Courses.size() - 1);
 			return fromScratch;
-		};
-		auto getCurrentCourse = [&]()
+		}
+
+		ParsedCourse* getCurrentCourse()
 		{
 			if (currentCourse == nullptr)
 				initCurrentCourse();
 			return currentCourse;
-		};
+		}
 
-		auto pushChartCommand = [&](ParsedChartCommandType type) -> ParsedChartCommand&
+		ParsedChartCommand& pushChartCommand(ParsedChartCommandType type)
 		{
 			auto& newCommand = getCurrentCourse()->ChartCommands.emplace_back();
 			newCommand.Type = type;
 			return newCommand;
-		};
+		}
 
-		for (const Token& token : tokens)
+		void ParseToken(const Token& token)
 		{
-			const i16 lineIndex = token.LineIndex;
+			const i32 lineIndex = token.LineIndex;
 			switch (token.Type)
 			{
 			case TokenType::Unknown:
@@ -846,7 +953,7 @@ namespace TJA
 						pushChartCommand(ParsedChartCommandType::BranchEnd);
 					} break;
 					case Key::Chart_SECTION: { pushChartCommand(ParsedChartCommandType::ResetAccuracyValues); } break;
-					case Key::Chart_LYRIC: { pushChartCommand(ParsedChartCommandType::SetLyricLine).Param.SetLyricLine.Value = in; } break;
+					case Key::Chart_LYRIC: { pushChartCommand(ParsedChartCommandType::SetLyricLine).Param.SetLyricLine.Value = outTJA.Strings.Push(in); } break;
 					case Key::Chart_LEVELHOLD: { pushChartCommand(ParsedChartCommandType::BranchLevelHold); } break;
 					case Key::Chart_BMSCROLL: { pushChartCommand(ParsedChartCommandType::BMScroll); } break;
 					case Key::Chart_HBSCROLL: { pushChartCommand(ParsedChartCommandType::HBScroll); } break;
@@ -857,7 +964,7 @@ namespace TJA
 						else
 							pushChartCommand(ParsedChartCommandType::SENoteChange).Param.SENoteChange.Type = v;
 						break;
-					case Key::Chart_NEXTSONG: { pushChartCommand(ParsedChartCommandType::SetNextSong).Param.SetNextSong.CommaSeparatedList = in; } break;
+					case Key::Chart_NEXTSONG: { pushChartCommand(ParsedChartCommandType::SetNextSong).Param.SetNextSong.CommaSeparatedList = outTJA.Strings.Push(in); } break;
 					case Key::Chart_DIRECTION: 
 					{
 						f32 scrollspeed = cachedScrollSpeed.GetRealPart();
@@ -994,8 +1101,9 @@ namespace TJA
 					b8 hasSpaces = false;
 					currentlyInBetweenMeasure = true;
 
+					std::vector<NoteType>& courseNotes = getCurrentCourse()->Notes;
 					ParsedChartCommand& newCommand = pushChartCommand(ParsedChartCommandType::MeasureNotes);
-					newCommand.Param.MeasureNotes.Notes.reserve(token.ValueString.size());
+					newCommand.Param.MeasureNotes.Index = static_cast<u32>(courseNotes.size());
 					for (const char& c : token.ValueString)
 					{
 						if (c == ',')
@@ -1021,7 +1129,8 @@ namespace TJA
 							if (!tryParseNoteTypeChar(c, &parsedNoteTypeOrNone))
 								outErrors.Push(lineIndex, "Unknown note type '%c'", c);
 
-							newCommand.Param.MeasureNotes.Notes.push_back(parsedNoteTypeOrNone);
+							courseNotes.push_back(parsedNoteTypeOrNone);
+							newCommand.Param.MeasureNotes.Count++;
 							currentMeasureNoteCount++;
 						}
 					}
@@ -1038,6 +1147,149 @@ namespace TJA
 			} break;
 			}
 		}
+	};
+
+	// NOTE: Run of tokens strictly inside a #START / #END pair that only contains chart data, chart commands and comments.
+	//		 Given the parser state at its #START it doesn't depend on anything else and can therefore be parsed on a worker thread
+	struct ChartBodySegment
+	{
+		size_t TokenBegin, TokenEnd;
+		TokenParser::ChartBodyState EntryState;
+		TokenParser::ChartBodyState ExitState;
+		ParsedCourse Course;
+		StringPool Strings;
+		ErrorList Errors;
+		b8 HasPeepoDrumKitComment;
+		Date PeepoDrumKitCommentDate;
+	};
+
+	static std::vector<ChartBodySegment> FindParallelChartBodySegments(const std::vector<Token>& tokens)
+	{
+		std::vector<ChartBodySegment> outSegments;
+
+		// NOTE: The scroll speed is the only chart body state that is expected to carry over between courses of a well-formed file
+		//		 and since it is always set the same way no matter the surrounding state it can be tracked here without doing a full parse
+		Complex cachedScrollSpeed = Complex(1.f, 0.f), segmentEntryScrollSpeed = cachedScrollSpeed;
+		size_t segmentBegin = 0;
+		b8 segmentOpen = false, segmentValid = false;
+
+		for (size_t tokenIndex = 0; tokenIndex < tokens.size(); tokenIndex++)
+		{
+			const Token& token = tokens[tokenIndex];
+			if (token.Type == TokenType::HashChartCommand && (token.Key == Key::Chart_START || token.Key == Key::Chart_END))
+			{
+				if (segmentOpen && segmentValid && (tokenIndex - segmentBegin) >= MinTokensPerChartBodySegment)
+				{
+					ChartBodySegment& newSegment = outSegments.emplace_back();
+					newSegment.TokenBegin = segmentBegin;
+					newSegment.TokenEnd = tokenIndex;
+					newSegment.EntryState = TokenParser::ChartBodyState { 0, false, false, segmentEntryScrollSpeed };
+				}
+
+				segmentOpen = segmentValid = (token.Key == Key::Chart_START);
+				segmentBegin = (tokenIndex + 1);
+				segmentEntryScrollSpeed = cachedScrollSpeed;
+			}
+			else if (token.Type == TokenType::KeyColonValue)
+			{
+				segmentValid = false;
+			}
+			else if (token.Type == TokenType::HashChartCommand && token.Key == Key::Chart_SCROLL)
+			{
+				ASCII::TryParse(ASCII::Trim(token.ValueString), cachedScrollSpeed);
+			}
+		}
+
+		return outSegments;
+	}
+
+	ParsedTJA ParseTokens(const std::vector<Token>& tokens, ErrorList& outErrors)
+	{
+		// NOTE: Parse the body of each course on its own worker thread first and then splice the results back in while doing the (now cheap) serial pass.
+		//		 A segment can only be used as is if the serial parser arrives at it in the same state it was parsed with, which is always the case
+		//		 for well-formed files. Otherwise (say a missing #END) just parse it again in place so the output is identical to a fully serial parse
+		std::vector<ChartBodySegment> segments = FindParallelChartBodySegments(tokens);
+		if (const size_t jobCount = GetParallelJobCount(segments.size(), 1); jobCount > 1)
+		{
+			std::atomic<size_t> nextSegmentIndex = 0;
+			RunParallelJobs(jobCount, [&](size_t)
+			{
+				for (size_t segmentIndex = nextSegmentIndex++; segmentIndex < segments.size(); segmentIndex = nextSegmentIndex++)
+				{
+					ChartBodySegment& segment = segments[segmentIndex];
+					ParsedTJA segmentTJA = {};
+
+					TokenParser segmentParser(segmentTJA, segment.Errors);
+					segmentParser.currentlyBetweenFirstCommandAndEnd = true;
+					segmentParser.currentlyBetweenChartStartAndEnd = true;
+					segmentParser.currentCourse = &segment.Course;
+					segmentParser.SetChartBodyState(segment.EntryState);
+
+					for (size_t tokenIndex = segment.TokenBegin; tokenIndex < segment.TokenEnd; tokenIndex++)
+						segmentParser.ParseToken(tokens[tokenIndex]);
+
+					segment.ExitState = segmentParser.GetChartBodyState();
+					segment.Strings = std::move(segmentTJA.Strings);
+					segment.HasPeepoDrumKitComment = segmentTJA.HasPeepoDrumKitComment;
+					segment.PeepoDrumKitCommentDate = segmentTJA.PeepoDrumKitCommentDate;
+				}
+			});
+		}
+		else
+		{
+			segments.clear();
+		}
+
+		ParsedTJA outTJA = {};
+		TokenParser parser(outTJA, outErrors);
+
+		size_t nextSegmentIndex = 0;
+		for (size_t tokenIndex = 0; tokenIndex < tokens.size(); /*tokenIndex++*/)
+		{
+			if (nextSegmentIndex < segments.size() && segments[nextSegmentIndex].TokenBegin == tokenIndex)
+			{
+				ChartBodySegment& segment = segments[nextSegmentIndex++];
+				if (parser.currentlyBetweenChartStartAndEnd && parser.currentCourse != nullptr && parser.GetChartBodyState() == segment.EntryState)
+				{
+					// NOTE: The segment was parsed into its own note arena and string pool so all references have to be rebased onto the ones they are appended to
+					auto& outCommands = parser.currentCourse->ChartCommands;
+					auto& outNotes = parser.currentCourse->Notes;
+					const u32 noteIndexOffset = static_cast<u32>(outNotes.size());
+					const u32 stringOffset = static_cast<u32>(outTJA.Strings.Data.size());
+					for (ParsedChartCommand& command : segment.Course.ChartCommands)
+					{
+						if (command.Type == ParsedChartCommandType::MeasureNotes)
+							command.Param.MeasureNotes.Index += noteIndexOffset;
+						else if (command.Type == ParsedChartCommandType::SetLyricLine)
+							command.Param.SetLyricLine.Value.Offset += stringOffset;
+						else if (command.Type == ParsedChartCommandType::SetNextSong)
+							command.Param.SetNextSong.CommaSeparatedList.Offset += stringOffset;
+					}
+
+					if (outCommands.empty())
+						outCommands = std::move(segment.Course.ChartCommands);
+					else
+						outCommands.insert(outCommands.end(), segment.Course.ChartCommands.begin(), segment.Course.ChartCommands.end());
+					if (outNotes.empty())
+						outNotes = std::move(segment.Course.Notes);
+					else
+						outNotes.insert(outNotes.end(), segment.Course.Notes.begin(), segment.Course.Notes.end());
+					outTJA.Strings.Data.append(segment.Strings.Data);
+					outErrors.Errors.insert(outErrors.Errors.end(), std::make_move_iterator(segment.Errors.Errors.begin()), std::make_move_iterator(segment.Errors.Errors.end()));
+					if (!outTJA.HasPeepoDrumKitComment && segment.HasPeepoDrumKitComment)
+					{
+						outTJA.HasPeepoDrumKitComment = true;
+						outTJA.PeepoDrumKitCommentDate = segment.PeepoDrumKitCommentDate;
+					}
+
+					parser.SetChartBodyState(segment.ExitState);
+					tokenIndex = segment.TokenEnd;
+					continue;
+				}
+			}
+
+			parser.ParseToken(tokens[tokenIndex++]);
+		}
 
 #if 1 // DEBUG: Always add at least one course for now so the debug gui has something to display
 		if (outTJA.Courses.empty())
@@ -1047,13 +1299,65 @@ namespace TJA
 		return outTJA;
 	}
 
+
 	static const ParsedMainMetadata DefaultMainMetadata = {};
 	static const ParsedCourseMetadata DefaultCourseMetadata = {};
 
+	// NOTE: std::to_chars with a precision of 6 produces the exact same output as "%g" (and the default std::ostream float formatting)
+	//		 without having to go through the format string parsing and locale handling of sprintf for every single number written
+	static void AppendI32(std::string& out, i32 value)
+	{
+		char buffer[16];
+		out.append(buffer, std::to_chars(buffer, buffer + ArrayCount(buffer), value).ptr);
+	}
+
+	static void AppendF64(std::string& out, f64 value, std::chars_format format = std::chars_format::general, i32 precision = 6)
+	{
+		char buffer[64];
+		out.append(buffer, std::to_chars(buffer, buffer + ArrayCount(buffer), value, format, precision).ptr);
+	}
+
+	// NOTE: Same as Complex::toStringCompat()
+	static void AppendComplexCompat(std::string& out, Complex value)
+	{
+		AppendF64(out, value.GetRealPart());
+		if (value.GetImaginaryPart() != 0)
+		{
+			if (!(value.GetImaginaryPart() < 0))
+				out += '+';
+			AppendF64(out, value.GetImaginaryPart());
+			out += 'i';
+		}
+	}
+
+	// NOTE: Rough upper bound so that the output only has to be allocated once up front instead of growing with every append
+	static size_t EstimateConvertedTextSize(const ParsedTJA& inContent)
+	{
+		size_t estimate = 0x1000 + inContent.Strings.Data.size();
+		estimate += inContent.Metadata.TITLE.size() + inContent.Metadata.SUBTITLE.size() + inContent.Metadata.WAVE.size() + inContent.Metadata.PREIMAGE.size() + inContent.Metadata.GENRE.size();
+		estimate += inContent.Metadata.MAKER.size() + inContent.Metadata.LYRICS.size() + inContent.Metadata.BGIMAGE.size() + inContent.Metadata.BGMOVIE.size();
+		for (const auto& [locale, val] : inContent.Metadata.TITLE_localized) { estimate += 16 + locale.size() + val.size(); }
+		for (const auto& [locale, val] : inContent.Metadata.SUBTITLE_localized) { estimate += 16 + locale.size() + val.size(); }
+		for (const auto& [header, val] : inContent.Metadata.Others) { estimate += 4 + header.size() + val.size(); }
+
+		for (const ParsedCourse& course : inContent.Courses)
+		{
+			estimate += 0x200 + course.Metadata.NOTESDESIGNER.size();
+			estimate += 8 * (course.Metadata.BALLOON.size() + course.Metadata.BALLOON_Normal.size() + course.Metadata.BALLOON_Expert.size() + course.Metadata.BALLOON_Master.size());
+			for (const auto& [header, val] : course.Metadata.Others) { estimate += 4 + header.size() + val.size(); }
+
+			// NOTE: One char per note plus a line per command, the longest of which (#JPOSSCROLL) fit well within 48 chars
+			estimate += course.Notes.size();
+			for (const ParsedChartCommand& command : course.ChartCommands)
+				estimate += (command.Type == ParsedChartCommandType::MeasureNotes || command.Type == ParsedChartCommandType::MeasureEnd) ? 2 : 48;
+		}
+		return estimate;
+	}
+
 	void ConvertParsedToText(const ParsedTJA& inContent, std::string& out, Encoding encoding)
 	{
 		// TODO: ... or maybe tokenize first instead of going right to text..?
-		out.reserve(out.size() + 0x4000);
+		out.reserve(out.size() + EstimateConvertedTextSize(inContent));
 		if (encoding == Encoding::UTF8)
 			out += std::string_view(UTF8::BOM_UTF8, sizeof(UTF8::BOM_UTF8));
 
@@ -1062,15 +1366,18 @@ namespace TJA
 		static constexpr auto appendSuffixedPropertyLine = [](std::string& out, Key key, std::string_view suffix, std::string_view value)
 		{ out += KeyStrings[EnumToIndex(key)]; out += suffix; out += ':'; out += value; out += '\n'; };
 		static constexpr auto appendCommandLine = [](std::string& out, Key key, std::string_view value) { out += '#'; out += KeyStrings[EnumToIndex(key)]; if (!value.empty()) { out += ' '; out += value; }out += '\n'; };
+		static constexpr auto appendProperyLineI32 = [](std::string& out, Key key, i32 value) { out += KeyStrings[EnumToIndex(key)]; out += ':'; AppendI32(out, value); out += '\n'; };
+		static constexpr auto appendProperyLineF64 = [](std::string& out, Key key, f64 value) { out += KeyStrings[EnumToIndex(key)]; out += ':'; AppendF64(out, value); out += '\n'; };
+		static constexpr auto appendProperyLineF64Fixed = [](std::string& out, Key key, f64 value, i32 precision) { out += KeyStrings[EnumToIndex(key)]; out += ':'; AppendF64(out, value, std::chars_format::fixed, precision); out += '\n'; };
+		// NOTE: For commands with formatted parameters, which are then appended directly after it and terminated with a '\n'
+		static constexpr auto appendCommandLinePrefix = [](std::string& out, Key key) { out += '#'; out += KeyStrings[EnumToIndex(key)]; out += ' '; };
 		static constexpr auto appendBalloonProperyLine = [](std::string& out, Key key, const std::vector<i32>& popCounts)
 		{
 			out += KeyStrings[EnumToIndex(key)];
 			out += ':';
-			char buffer[16];
-			for (size_t i = 0; i < popCounts.size(); i++) { if (i != 0) { out += ','; } out += std::string_view(buffer, sprintf_s(buffer, "%d", popCounts[i])); }
+			for (size_t i = 0; i < popCounts.size(); i++) { if (i != 0) { out += ','; } AppendI32(out, popCounts[i]); }
 			out += '\n';
 		};
-		char buffer[512];
 
 		static constexpr auto noteTypeToChar = [](NoteType in) -> char
 		{
@@ -1160,37 +1467,37 @@ namespace TJA
 			for (const auto& [locale, val] : inContent.Metadata.SUBTITLE_localized)
 				appendSuffixedPropertyLine(out, Key::Main_SUBTITLE_localized, locale, val);
 		}
-		appendProperyLine(out, Key::Main_BPM, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.BPM.BPM))); // Better to be explicit
+		appendProperyLineF64(out, Key::Main_BPM, inContent.Metadata.BPM.BPM); // Better to be explicit
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::WAVE))
 			appendProperyLine(out, Key::Main_WAVE, inContent.Metadata.WAVE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::PREIMAGE))
 			appendProperyLine(out, Key::Main_PREIMAGE, inContent.Metadata.PREIMAGE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::WAVE, &ParsedMainMetadata::OFFSET)) // Better to be explicit if `WAVE:` is given
-			appendProperyLine(out, Key::Main_OFFSET, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.OFFSET.Seconds)));
+			appendProperyLineF64(out, Key::Main_OFFSET, inContent.Metadata.OFFSET.Seconds);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::DEMOSTART))
-			appendProperyLine(out, Key::Main_DEMOSTART, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.DEMOSTART.Seconds)));
+			appendProperyLineF64(out, Key::Main_DEMOSTART, inContent.Metadata.DEMOSTART.Seconds);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::GENRE))
 			appendProperyLine(out, Key::Main_GENRE, inContent.Metadata.GENRE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::SCOREMODE))
-			appendProperyLine(out, Key::Main_SCOREMODE, std::string_view(buffer, sprintf_s(buffer, "%d", static_cast<i32>(inContent.Metadata.SCOREMODE))));
+			appendProperyLineI32(out, Key::Main_SCOREMODE, static_cast<i32>(inContent.Metadata.SCOREMODE));
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::MAKER))
 			appendProperyLine(out, Key::Main_MAKER, inContent.Metadata.MAKER);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::LYRICS))
 			appendProperyLine(out, Key::Main_LYRICS, inContent.Metadata.LYRICS);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::SONGVOL))
-			appendProperyLine(out, Key::Main_SONGVOL, std::string_view(buffer, sprintf_s(buffer, "%g", ToPercent(inContent.Metadata.SONGVOL))));
+			appendProperyLineF64(out, Key::Main_SONGVOL, ToPercent(inContent.Metadata.SONGVOL));
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::SEVOL))
-			appendProperyLine(out, Key::Main_SEVOL, std::string_view(buffer, sprintf_s(buffer, "%g", ToPercent(inContent.Metadata.SEVOL))));
+			appendProperyLineF64(out, Key::Main_SEVOL, ToPercent(inContent.Metadata.SEVOL));
 		// TODO: Key::Main_SIDE;
 		// TODO: Key::Main_GAME;
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::HEADSCROLL))
-			appendProperyLine(out, Key::Main_HEADSCROLL, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.HEADSCROLL)));
+			appendProperyLineF64(out, Key::Main_HEADSCROLL, inContent.Metadata.HEADSCROLL);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::BGIMAGE))
 			appendProperyLine(out, Key::Main_BGIMAGE, inContent.Metadata.BGIMAGE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::BGMOVIE))
 			appendProperyLine(out, Key::Main_BGMOVIE, inContent.Metadata.BGMOVIE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::BGIMAGE, &ParsedMainMetadata::BGMOVIE, &ParsedMainMetadata::MOVIEOFFSET)) // Better to be explicit if bg is given
-			appendProperyLine(out, Key::Main_MOVIEOFFSET, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.MOVIEOFFSET.Seconds)));
+			appendProperyLineF64(out, Key::Main_MOVIEOFFSET, inContent.Metadata.MOVIEOFFSET.Seconds);
 
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::Others)) {
 			for (const auto& [header, val] : inContent.Metadata.Others)
@@ -1257,14 +1564,14 @@ namespace TJA
 			// Unspecified default value
 			if (firstInGroup || shouldEmitCourseMetadata(&ParsedCourseMetadata::LEVEL, &ParsedCourseMetadata::LEVEL_DECIMALTAG)) {
 				if (course.Metadata.LEVEL_DECIMALTAG == -1)
-					appendProperyLine(out, Key::Course_LEVEL, std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.LEVEL)));
+					appendProperyLineI32(out, Key::Course_LEVEL, course.Metadata.LEVEL);
 				else
-					appendProperyLine(out, Key::Course_LEVEL, std::string_view(buffer, sprintf_s(buffer, "%.1f", course.Metadata.LEVEL + static_cast<float>(course.Metadata.LEVEL_DECIMALTAG) / 10.)));
+					appendProperyLineF64Fixed(out, Key::Course_LEVEL, course.Metadata.LEVEL + static_cast<f64>(course.Metadata.LEVEL_DECIMALTAG) / 10.0, 1);
 			}
 
 			// Better to be explicit
 			if (course.Metadata.COURSE == DifficultyType::Tower) {
-				appendProperyLine(out, Key::Course_LIFE, std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.LIFE)));
+				appendProperyLineI32(out, Key::Course_LIFE, course.Metadata.LIFE);
 				appendProperyLine(out, Key::Course_SIDE, sideToString(course.Metadata.SIDE));
 			}
 
@@ -1279,8 +1586,8 @@ namespace TJA
 			}
 
 			if (shouldEmitCourseMetadata(&ParsedCourseMetadata::SCOREINIT, &ParsedCourseMetadata::SCOREDIFF)) {
-				appendProperyLine(out, Key::Course_SCOREINIT, (course.Metadata.SCOREINIT == 0) ? "" : std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.SCOREINIT)));
-				appendProperyLine(out, Key::Course_SCOREDIFF, (course.Metadata.SCOREDIFF == 0) ? "" : std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.SCOREDIFF)));
+				if (course.Metadata.SCOREINIT == 0) appendProperyLine(out, Key::Course_SCOREINIT, ""); else appendProperyLineI32(out, Key::Course_SCOREINIT, course.Metadata.SCOREINIT);
+				if (course.Metadata.SCOREDIFF == 0) appendProperyLine(out, Key::Course_SCOREDIFF, ""); else appendProperyLineI32(out, Key::Course_SCOREDIFF, course.Metadata.SCOREDIFF);
 			}
 
 			if (shouldEmitCourseMetadata(&ParsedCourseMetadata::NOTESDESIGNER))
@@ -1311,8 +1618,11 @@ namespace TJA
 				{
 				case ParsedChartCommandType::MeasureNotes:
 				{
-					for (const NoteType note : command.Param.MeasureNotes.Notes)
-						out += noteTypeToChar(note);
+					const ParsedMeasureNotes measureNotes = course.GetMeasureNotes(command);
+					const size_t outOffset = out.size();
+					out.resize(outOffset + measureNotes.size());
+					for (size_t i = 0; i < measureNotes.size(); i++)
+						out[outOffset + i] = noteTypeToChar(measureNotes.Data[i]);
 
 					if (ArrayItToIndex(&command, &course.ChartCommands[0]) + 1 < course.ChartCommands.size())
 					{
@@ -1323,19 +1633,23 @@ namespace TJA
 				case ParsedChartCommandType::MeasureEnd: { appendLine(out, ","); } break;
 				case ParsedChartCommandType::ChangeTimeSignature:
 				{
-					appendCommandLine(out, Key::Chart_MEASURE, std::string_view(buffer, sprintf_s(buffer, "%d/%d", command.Param.ChangeTimeSignature.Value.Numerator, command.Param.ChangeTimeSignature.Value.Denominator)));
+					appendCommandLinePrefix(out, Key::Chart_MEASURE);
+					AppendI32(out, command.Param.ChangeTimeSignature.Value.Numerator); out += '/'; AppendI32(out, command.Param.ChangeTimeSignature.Value.Denominator); out += '\n';
 				} break;
 				case ParsedChartCommandType::ChangeTempo:
 				{
-					appendCommandLine(out, Key::Chart_BPMCHANGE, std::string_view(buffer, sprintf_s(buffer, "%g", command.Param.ChangeTempo.Value.BPM)));
+					appendCommandLinePrefix(out, Key::Chart_BPMCHANGE);
+					AppendF64(out, command.Param.ChangeTempo.Value.BPM); out += '\n';
 				} break;
 				case ParsedChartCommandType::ChangeDelay:
 				{
-					appendCommandLine(out, Key::Chart_DELAY, std::string_view(buffer, sprintf_s(buffer, "%g", command.Param.ChangeDelay.Value.ToSec())));
+					appendCommandLinePrefix(out, Key::Chart_DELAY);
+					AppendF64(out, command.Param.ChangeDelay.Value.ToSec()); out += '\n';
 				} break;
 				case ParsedChartCommandType::ChangeScrollSpeed:
 				{
-					appendCommandLine(out, Key::Chart_SCROLL, std::string_view(buffer, sprintf_s(buffer, "%s", command.Param.ChangeScrollSpeed.Value.toStringCompat().c_str())));
+					appendCommandLinePrefix(out, Key::Chart_SCROLL);
+					AppendComplexCompat(out, command.Param.ChangeScrollSpeed.Value); out += '\n';
 				} break;
 				case ParsedChartCommandType::ChangeBarLine:
 				{
@@ -1351,7 +1665,10 @@ namespace TJA
 				} break;
 				case ParsedChartCommandType::BranchStart:
 				{
-					appendCommandLine(out, Key::Chart_BRANCHSTART, std::string_view(buffer, sprintf_s(buffer, "%c,%d,%d", BranchConditionToChar(command.Param.BranchStart.Condition), command.Param.BranchStart.RequirementExpert, command.Param.BranchStart.RequirementMaster)));
+					appendCommandLinePrefix(out, Key::Chart_BRANCHSTART);
+					out += BranchConditionToChar(command.Param.BranchStart.Condition); out += ',';
+					AppendI32(out, command.Param.BranchStart.RequirementExpert); out += ',';
+					AppendI32(out, command.Param.BranchStart.RequirementMaster); out += '\n';
 				} break;
 				case ParsedChartCommandType::BranchNormal:
 				{
@@ -1380,7 +1697,7 @@ namespace TJA
 				case ParsedChartCommandType::SetLyricLine:
 				{
 					// TODO: Handle escape characters, most importantly "\n"
-					appendCommandLine(out, Key::Chart_LYRIC, command.Param.SetLyricLine.Value);
+					appendCommandLine(out, Key::Chart_LYRIC, inContent.Strings.Get(command.Param.SetLyricLine.Value));
 				} break;
 				case ParsedChartCommandType::NMScroll:
 				{
@@ -1408,11 +1725,13 @@ namespace TJA
 				} break;
 				case ParsedChartCommandType::SetSudden:
 				{
-					appendCommandLine(out, Key::Chart_SUDDEN, std::string_view(buffer, sprintf_s(buffer, "%g %g", command.Param.SetSudden.AppearanceOffset.ToSec(), command.Param.SetSudden.MovementWaitDelay.ToSec())));
+					appendCommandLinePrefix(out, Key::Chart_SUDDEN);
+					AppendF64(out, command.Param.SetSudden.AppearanceOffset.ToSec()); out += ' '; AppendF64(out, command.Param.SetSudden.MovementWaitDelay.ToSec()); out += '\n';
 				} break;
 				case ParsedChartCommandType::SetJPOSScroll:
 				{
-					appendCommandLine(out, Key::Chart_JPOSSCROLL, std::string_view(buffer, sprintf_s(buffer, "%g %s 1", command.Param.ChangeJPOSScroll.Duration.ToSec(), command.Param.ChangeJPOSScroll.Move.toStringCompat().c_str())));
+					appendCommandLinePrefix(out, Key::Chart_JPOSSCROLL);
+					AppendF64(out, command.Param.ChangeJPOSScroll.Duration.ToSec()); out += ' '; AppendComplexCompat(out, command.Param.ChangeJPOSScroll.Move); out += " 1\n";
 				} break;
 				default: { assert(!"Unhandled ParsedChartCommandType switch case"); } break;
 				}
@@ -1426,12 +1745,14 @@ namespace TJA
 		}
 	}
 
-	void ConvertConvertedMeasuresToParsedCommands(const std::vector<ConvertedMeasure>& inMeasures, std::vector<ParsedChartCommand>& outCommands)
+	void ConvertConvertedMeasuresToParsedCommands(const std::vector<ConvertedMeasure>& inMeasures, ParsedCourse& outCourse, StringPool& outStrings)
 	{
-		struct TempCommand { Beat TimeWithinMeasure; ParsedChartCommand ParsedCommand; };
+		// NOTE: Each temp MeasureNotes command holds a single note which only gets written to the course note arena once merged
+		struct TempCommand { Beat TimeWithinMeasure; ParsedChartCommand ParsedCommand; NoteType Note; };
 		std::vector<TempCommand> tempBuffer;
 		tempBuffer.reserve(64);
 
+		std::vector<ParsedChartCommand>& outCommands = outCourse.ChartCommands;
 		outCommands.reserve(inMeasures.size() * 4);
 
 		TimeSignature lastSignature = DefaultTimeSignature;
@@ -1495,7 +1816,7 @@ namespace TJA
 			{
 				ParsedChartCommand& tempCommand = tempBuffer.emplace_back(TempCommand { lyricChange.TimeWithinMeasure }).ParsedCommand;
 				tempCommand.Type = ParsedChartCommandType::SetLyricLine;
-				tempCommand.Param.SetLyricLine.Value = lyricChange.Lyric;
+				tempCommand.Param.SetLyricLine.Value = outStrings.Push(lyricChange.Lyric);
 			}
 
 			for (const ConvertedDelayChange& delayChange : inMeasure.DelayChanges)
@@ -1510,9 +1831,9 @@ namespace TJA
 			i32 actualNotesInThisMeasure = 0;
 			for (const ConvertedNote& note : inMeasure.Notes)
 			{
-				ParsedChartCommand& tempCommand = tempBuffer.emplace_back(TempCommand { note.TimeWithinMeasure }).ParsedCommand;
-				tempCommand.Type = ParsedChartCommandType::MeasureNotes;
-				tempCommand.Param.MeasureNotes.Notes.push_back(note.Type);
+				TempCommand& tempCommand = tempBuffer.emplace_back(TempCommand { note.TimeWithinMeasure });
+				tempCommand.ParsedCommand.Type = ParsedChartCommandType::MeasureNotes;
+				tempCommand.Note = note.Type;
 				actualNotesInThisMeasure++;
 			}
 			size_t noteCommandEnd = tempBuffer.size();
@@ -1559,9 +1880,9 @@ namespace TJA
 
 						if (!noteAlreadyExists)
 						{
-							ParsedChartCommand& tempCommand = tempBuffer.emplace_back(TempCommand { noteBeat }).ParsedCommand;
-							tempCommand.Type = ParsedChartCommandType::MeasureNotes;
-							tempCommand.Param.MeasureNotes.Notes.push_back(NoteType::None);
+							TempCommand& tempCommand = tempBuffer.emplace_back(TempCommand { noteBeat });
+							tempCommand.ParsedCommand.Type = ParsedChartCommandType::MeasureNotes;
+							tempCommand.Note = NoteType::None;
 						}
 					}
 
@@ -1585,10 +1906,17 @@ namespace TJA
 					// NOTE: Merge adjacent single-note MeasureNotes commands
 					if (lastNoteCommand != nullptr && (thisCommand.ParsedCommand.Type == ParsedChartCommandType::MeasureNotes))
 					{
-						for (NoteType note : thisCommand.ParsedCommand.Param.MeasureNotes.Notes)
-							lastNoteCommand->Param.MeasureNotes.Notes.push_back(note);
+						outCourse.Notes.push_back(thisCommand.Note);
+						lastNoteCommand->Param.MeasureNotes.Count++;
 					}
 					else {
+						if (thisCommand.ParsedCommand.Type == ParsedChartCommandType::MeasureNotes)
+						{
+							thisCommand.ParsedCommand.Param.MeasureNotes.Index = static_cast<u32>(outCourse.Notes.size());
+							thisCommand.ParsedCommand.Param.MeasureNotes.Count = 1;
+							outCourse.Notes.push_back(thisCommand.Note);
+						}
+
 						// Push first, modify later
 						outCommands.push_back(std::move(thisCommand.ParsedCommand));
 						lastNoteCommand = (outCommands.back().Type == ParsedChartCommandType::MeasureNotes) ?
@@ -1623,7 +1951,7 @@ namespace TJA
 			{
 				if (command.Type == ParsedChartCommandType::MeasureNotes)
 				{
-					for (const NoteType note : command.Param.MeasureNotes.Notes)
+					for (const NoteType note : inCourse.GetMeasureNotes(command))
 						currentMeasure->Notes.push_back(ConvertedNote { Beat::Zero(), note });
 				}
 				else if (command.Type == ParsedChartCommandType::MeasureEnd)
@@ -1662,7 +1990,7 @@ namespace TJA
 			{
 				if (command.Type == ParsedChartCommandType::MeasureNotes)
 				{
-					currentNotesInMeasure += static_cast<i32>(command.Param.MeasureNotes.Notes.size());
+					currentNotesInMeasure += static_cast<i32>(command.Param.MeasureNotes.Count);
 
 					if (!currentMeasure->Notes.empty() && currentNotesInMeasure > 0)
 						currentTimeWithinMeasure = currentMeasure->Notes[currentNotesInMeasure - 1].TimeWithinMeasure +
@@ -1703,7 +2031,7 @@ namespace TJA
 				}
 				else if (command.Type == ParsedChartCommandType::SetLyricLine)
 				{
-					currentMeasure->LyricChanges.push_back(ConvertedLyricChange { currentTimeWithinMeasure, command.Param.SetLyricLine.Value });
+					currentMeasure->LyricChanges.push_back(ConvertedLyricChange { currentTimeWithinMeasure, std::string(inContent.Strings.Get(command.Param.SetLyricLine.Value)) });
 				}
 				else if (command.Type == ParsedChartCommandType::NMScroll || command.Type == ParsedChartCommandType::HBScroll || command.Type == ParsedChartCommandType::BMScroll) 
 				{
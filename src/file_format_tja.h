@@ -146,7 +146,7 @@ namespace TJA
 	{
 		TokenType Type;
 		Key Key;
-		i16 LineIndex;
+		i32 LineIndex;
 		std::string_view Line;
 		std::string_view KeyString;
 		std::string_view ValueString;
@@ -378,13 +378,31 @@ namespace TJA
 		Count
 	};
 
+	// NOTE: Chart command strings are stored back-to-back inside a single per-file pool and referenced by offset + length
+	struct StringPoolEntry { u32 Offset, Length; };
+
+	struct StringPool
+	{
+		std::string Data;
+
+		inline StringPoolEntry Push(std::string_view value)
+		{
+			const StringPoolEntry entry = { static_cast<u32>(Data.size()), static_cast<u32>(value.size()) };
+			Data.append(value);
+			return entry;
+		}
+		inline std::string_view Get(StringPoolEntry entry) const { return std::string_view(Data).substr(entry.Offset, entry.Length); }
+	};
+
 	struct ParsedChartCommand
 	{
-		// TODO: Maybe store notes as index + count into single vector (?)
 		ParsedChartCommandType Type;
-		struct ParamData
+
+		// NOTE: Tagged by Type. Notes are referenced by index + count into ParsedCourse::Notes and strings by offset + length into ParsedTJA::Strings
+		//		 so that commands stay small, trivially copyable and don't own any heap allocations of their own
+		union ParamData
 		{
-			struct { std::vector<NoteType> Notes; } MeasureNotes;
+			struct { u32 Index, Count; } MeasureNotes;
 			struct { TimeSignature Value; } ChangeTimeSignature;
 			struct { Tempo Value; } ChangeTempo;
 			struct { Time Value; } ChangeDelay;
@@ -393,26 +411,49 @@ namespace TJA
 			struct { Time Duration; Complex Move; } ChangeJPOSScroll;
 			struct { b8 Visible; } ChangeBarLine;
 			struct { BranchCondition Condition; i32 RequirementExpert; i32 RequirementMaster; } BranchStart;
-			struct { std::string Value; } SetLyricLine;
+			struct { StringPoolEntry Value; } SetLyricLine;
 			struct { i32 Type; } SENoteChange;
-			struct { std::string CommaSeparatedList; } SetNextSong;
+			struct { StringPoolEntry CommaSeparatedList; } SetNextSong;
 			struct { ScrollDirection Direction; } ChangeDirection;
 			struct { Time AppearanceOffset, MovementWaitDelay; } SetSudden;
 			struct { Time Duration; f32 MovementDistance; ScrollDirection Direction; } SetScrollTransition;
+
+			inline ParamData() { ::memset(this, 0, sizeof(*this)); }
+			inline ParamData(const ParamData& other) { ::memcpy(this, &other, sizeof(*this)); }
+			inline ParamData& operator=(const ParamData& other) { ::memcpy(this, &other, sizeof(*this)); return *this; }
 		} Param;
 	};
 
+	struct ParsedMeasureNotes
+	{
+		const NoteType* Data;
+		size_t Count;
+
+		inline const NoteType* begin() const { return Data; }
+		inline const NoteType* end() const { return Data + Count; }
+		inline size_t size() const { return Count; }
+	};
+
 	struct ParsedCourse
 	{
 		ParsedCourseMetadata Metadata;
 		std::vector<ParsedChartCommand> ChartCommands;
+		// NOTE: Note arena shared by all MeasureNotes commands of this course
+		std::vector<NoteType> Notes;
 		b8 HasChart;
+
+		inline ParsedMeasureNotes GetMeasureNotes(const ParsedChartCommand& command) const
+		{
+			assert(command.Type == ParsedChartCommandType::MeasureNotes);
+			return ParsedMeasureNotes { Notes.data() + command.Param.MeasureNotes.Index, command.Param.MeasureNotes.Count };
+		}
 	};
 
 	struct ParsedTJA
 	{
 		ParsedMainMetadata Metadata;
 		std::vector<ParsedCourse> Courses;
+		StringPool Strings;
 
 		// NOTE: Only for internal use within PeepoDrumKit. TJAs that have been exported with this special comment marker
 		//		 are assumed to only make use of known and supported features that can be safely converted without having to worry about potential data loss
@@ -422,7 +463,8 @@ namespace TJA
 
 	std::vector<std::string_view> SplitLines(std::string_view fileContent);
 
-	// NOTE: Designed to never fail, invalid input data just means a different arrangements of (unknown / bad) tokens
+	// NOTE: Designed to never fail, invalid input data just means a different arrangements of (unknown / bad) tokens.
+	//		 Large files are split up and tokenized across multiple threads
 	std::vector<Token> TokenizeLines(const std::vector<std::string_view>& lines);
 
 	struct ErrorList
@@ -442,6 +484,7 @@ namespace TJA
 		inline void Clear() { Errors.clear(); }
 	};
 
+	// NOTE: The #START / #END body of each course is parsed on its own thread (if large enough), with the output being identical to a fully serial parse
 	ParsedTJA ParseTokens(const std::vector<Token>& tokens, ErrorList& outErrors);
 
 	void ConvertParsedToText(const ParsedTJA& inContent, std::string& out, Encoding encoding);
@@ -538,7 +581,7 @@ namespace TJA
 		std::vector<ConvertedGoGoRange> GoGoRanges;
 	};
 
-	void ConvertConvertedMeasuresToParsedCommands(const std::vector<TJA::ConvertedMeasure>& inMeasures, std::vector<TJA::ParsedChartCommand>& outCommands);
+	void ConvertConvertedMeasuresToParsedCommands(const std::vector<TJA::ConvertedMeasure>& inMeasures, TJA::ParsedCourse& outCourse, TJA::StringPool& outStrings);
 
 	ConvertedCourse ConvertParsedToConvertedCourse(const ParsedTJA& inContent, const ParsedCourse& inCourse);
 }
@@ -137,6 +137,154 @@ namespace PeepoDrumKit
 		return maxBeat;
 	}
 
+	static void CountCourseStats(const ChartCourse& course, BranchType branch, ChartCourseStats& out)
+	{
+		out = {};
+		const SortedNotesList& notes = course.GetNotes(branch);
+
+		std::vector<Time> hitTimes;
+		hitTimes.reserve(notes.size());
+		for (const Note& note : notes)
+		{
+			out.NoteCountPerType[EnumToIndex(note.Type)]++;
+			if (IsDonNote(note.Type)) out.DonCount++;
+			if (IsKaNote(note.Type)) out.KaCount++;
+			if (IsKaDonNote(note.Type)) out.KaDonCount++;
+			if (IsAdlibNote(note.Type)) out.AdlibCount++;
+			if (IsBombNote(note.Type)) out.BombCount++;
+
+			const Time headTime = course.TempoMap.BeatToTime(note.BeatTime) + note.TimeOffset;
+			if (IsDonNote(note.Type) || IsKaNote(note.Type) || IsKaDonNote(note.Type))
+				hitTimes.push_back(headTime);
+
+			if (IsDrumrollNote(note.Type))
+			{
+				out.DrumrollCount++;
+				out.DrumrollDuration += (course.TempoMap.BeatToTime(note.GetEnd()) + note.TimeOffset) - headTime;
+			}
+			else if (IsBalloonNote(note.Type))
+			{
+				out.BalloonCount++;
+				out.BalloonPopCount += note.BalloonPopCount;
+			}
+		}
+
+		out.MaxCombo = static_cast<i32>(hitTimes.size());
+		if (hitTimes.empty())
+			return;
+
+		// NOTE: Sorted by beat already, except for notes with a time offset overtaking their neighbors
+		std::sort(hitTimes.begin(), hitTimes.end());
+		out.FirstHitTime = hitTimes.front();
+		out.LastHitTime = hitTimes.back();
+
+		out.HitsPerSecond.resize(static_cast<size_t>((out.LastHitTime - out.FirstHitTime).ToSec()) + 1, 0.0f);
+		for (size_t hitIndex = 0, windowStartIndex = 0; hitIndex < hitTimes.size(); hitIndex++)
+		{
+			out.HitsPerSecond[static_cast<size_t>((hitTimes[hitIndex] - out.FirstHitTime).ToSec())] += 1.0f;
+
+			while ((hitTimes[hitIndex] - hitTimes[windowStartIndex]) >= Time::FromSec(1.0))
+				windowStartIndex++;
+
+			const i32 hitsInWindow = static_cast<i32>(hitIndex - windowStartIndex + 1);
+			if (hitsInWindow > out.PeakHitsPerSecond)
+			{
+				out.PeakHitsPerSecond = hitsInWindow;
+				out.PeakHitsPerSecondTime = hitTimes[windowStartIndex];
+			}
+		}
+	}
+
+	const std::vector<size_t>& ChartCourse::GetSelectedIndices(GenericList list) const
+	{
+		assert(list < GenericList::Count);
+		ChartSelectionIndex& selection = TempSelection[EnumToIndex(list)];
+		if (!selection.IsValid)
+		{
+			selection.SortedIndices.clear();
+			ApplySingleGenericList(list, [&](auto&& typedList)
+			{
+				for (size_t i = 0; i < typedList.size(); i++)
+					if (typedList[i].IsSelected)
+						selection.SortedIndices.push_back(i);
+				return true;
+			}, false, *this);
+			selection.IsValid = true;
+		}
+		return selection.SortedIndices;
+	}
+
+	const ChartCourseStats& ChartCourse::GetStats(BranchType branch) const
+	{
+		assert(branch < BranchType::Count);
+		if (!TempStatsAreValid[EnumToIndex(branch)])
+		{
+			CountCourseStats(*this, branch, TempStats[EnumToIndex(branch)]);
+			TempStatsAreValid[EnumToIndex(branch)] = true;
+		}
+		return TempStats[EnumToIndex(branch)];
+	}
+
+	void ChartCourse::DeferRefresh(b8 tempoMapChanged, const NoteBeatRange (&changedNotesPerBranch)[EnumCount<BranchType>])
+	{
+		DeferredTempoMapRebuild |= tempoMapChanged;
+		for (size_t i = 0; i < EnumCount<BranchType>; i++)
+			DeferredSENotes[i].Add(changedNotesPerBranch[i]);
+	}
+
+	void ChartCourse::FlushDeferredRefresh()
+	{
+		if (DeferredTempoMapRebuild)
+		{
+			// NOTE: Every note time and SE type may have changed, whether or not any notes were edited
+			TempoMap.RebuildAccelerationStructure();
+			RecalculateSENotes();
+			InvalidateStats();
+		}
+		else
+		{
+			for (BranchType branch = BranchType::Normal; branch < BranchType::Count; IncrementEnum(branch))
+			{
+				if (DeferredSENotes[EnumToIndex(branch)].IsEmpty())
+					continue;
+				RecalculateSENotes(branch, DeferredSENotes[EnumToIndex(branch)]);
+				InvalidateStats(branch);
+			}
+		}
+
+		DeferredTempoMapRebuild = false;
+		for (NoteBeatRange& changedNotes : DeferredSENotes)
+			changedNotes = {};
+	}
+
+	ChartProject CreateChartProjectSnapshot(const ChartProject& in)
+	{
+		ChartProject out;
+		out.Courses.reserve(in.Courses.size());
+		for (const std::unique_ptr<ChartCourse>& inCourse : in.Courses)
+			out.Courses.push_back(std::make_unique<ChartCourse>(*inCourse));
+
+		out.ChartDuration = in.ChartDuration;
+		out.ChartTitle = in.ChartTitle;
+		out.ChartTitleLocalized = in.ChartTitleLocalized;
+		out.ChartSubtitle = in.ChartSubtitle;
+		out.ChartSubtitleLocalized = in.ChartSubtitleLocalized;
+		out.ChartCreator = in.ChartCreator;
+		out.ChartGenre = in.ChartGenre;
+		out.ChartLyricsFileName = in.ChartLyricsFileName;
+		out.SongOffset = in.SongOffset;
+		out.SongDemoStartTime = in.SongDemoStartTime;
+		out.SongFileName = in.SongFileName;
+		out.SongJacket = in.SongJacket;
+		out.SongVolume = in.SongVolume;
+		out.SoundEffectVolume = in.SoundEffectVolume;
+		out.BackgroundImageFileName = in.BackgroundImageFileName;
+		out.BackgroundMovieFileName = in.BackgroundMovieFileName;
+		out.MovieOffset = in.MovieOffset;
+		out.OtherMetadata = in.OtherMetadata;
+		return out;
+	}
+
 	b8 CreateChartProjectFromTJA(const TJA::ParsedTJA& inTJA, ChartProject& out)
 	{
 		out.ChartDuration = Time::Zero();
@@ -270,7 +418,54 @@ namespace PeepoDrumKit
 		return true;
 	}
 
-	b8 ConvertChartProjectToTJA(const ChartProject& in, TJA::ParsedTJA& out, b8 includePeepoDrumKitComment)
+	// NOTE: Covers everything ConvertChartProjectToTJA() reads from a course (minus selection and animation state) along with the project wide inputs passed in as the seed
+	static u64 HashChartCourseContentForTJA(const ChartCourse& course, u64 seed)
+	{
+		std::string buffer;
+		const auto appendBytes = [&buffer](const void* data, size_t size) { buffer.append(reinterpret_cast<const char*>(data), size); };
+		const auto appendString = [&](std::string_view value) { const size_t size = value.size(); appendBytes(&size, sizeof(size)); buffer.append(value); };
+
+		appendBytes(&course.Type, sizeof(course.Type));
+		appendBytes(&course.Level, sizeof(course.Level));
+		appendBytes(&course.Decimal, sizeof(course.Decimal));
+		appendBytes(&course.Style, sizeof(course.Style));
+		appendBytes(&course.PlayerSide, sizeof(course.PlayerSide));
+		appendBytes(&course.ScoreInit, sizeof(course.ScoreInit));
+		appendBytes(&course.ScoreDiff, sizeof(course.ScoreDiff));
+		appendBytes(&course.Life, sizeof(course.Life));
+		appendBytes(&course.Side, sizeof(course.Side));
+		appendString(course.CourseCreator);
+		for (const auto& [key, value] : course.OtherMetadata) { appendString(key); appendString(value); }
+		u64 hash = File::HashContent(buffer.data(), buffer.size(), seed);
+
+		for (GenericList list = {}; list < GenericList::Count; IncrementEnum(list))
+		{
+			const size_t itemCount = GetGenericListCount(course, list);
+			buffer.clear();
+			appendBytes(&itemCount, sizeof(itemCount));
+
+			for (size_t itemIndex = 0; itemIndex < itemCount; itemIndex++)
+			{
+				for (GenericMember member = {}; member < GenericMember::Count; IncrementEnum(member))
+				{
+					GenericMemberUnion value {};
+					if (member == GenericMember::B8_IsSelected || !TryGet(course, list, itemIndex, member, value))
+						continue;
+
+					if (member == GenericMember::CStr_Lyric)
+						appendString((value.CStr != nullptr) ? std::string_view(value.CStr) : std::string_view());
+					else
+						appendBytes(&value, sizeof(value));
+				}
+			}
+
+			hash = File::HashContent(buffer.data(), buffer.size(), hash);
+		}
+
+		return hash;
+	}
+
+	b8 ConvertChartProjectToTJA(const ChartProject& in, TJA::ParsedTJA& out, b8 includePeepoDrumKitComment, ChartCourseTJACache* inOutCache)
 	{
 		static constexpr cstr FallbackTJAChartTitle = "Untitled Chart";
 		out.Metadata.TITLE = !in.ChartTitle.empty() ? in.ChartTitle : FallbackTJAChartTitle;
@@ -306,12 +501,54 @@ namespace PeepoDrumKit
 			}
 		}
 
+		static constexpr auto offsetStringPoolEntries = [](std::vector<TJA::ParsedChartCommand>& commands, u32 oldOffset, u32 newOffset)
+		{
+			for (TJA::ParsedChartCommand& command : commands)
+			{
+				if (command.Type == TJA::ParsedChartCommandType::SetLyricLine)
+					command.Param.SetLyricLine.Value.Offset = (command.Param.SetLyricLine.Value.Offset - oldOffset) + newOffset;
+				else if (command.Type == TJA::ParsedChartCommandType::SetNextSong)
+					command.Param.SetNextSong.CommaSeparatedList.Offset = (command.Param.SetNextSong.CommaSeparatedList.Offset - oldOffset) + newOffset;
+			}
+		};
+
+		// NOTE: Courses that weren't used this time around are dropped from the cache
+		std::vector<ChartCourseTJACache::Entry> newCacheEntries;
+		u64 contentHashSeed = 0;
+		if (inOutCache != nullptr)
+		{
+			newCacheEntries.reserve(in.Courses.size());
+			inOutCache->LastReusedCount = 0;
+
+			const Time chartDuration = in.GetDurationOrDefault();
+			contentHashSeed = File::HashContent(&chartDuration, sizeof(chartDuration), File::HashContent(&out.Metadata.BPM, sizeof(out.Metadata.BPM)));
+		}
+
 		out.Courses.reserve(in.Courses.size());
 		for (const std::unique_ptr<ChartCourse>& inCourseIt : in.Courses)
 		{
 			const ChartCourse& inCourse = *inCourseIt;
 			TJA::ParsedCourse& outCourse = out.Courses.emplace_back();
 
+			const u32 outStringsBegin = static_cast<u32>(out.Strings.Data.size());
+			u64 contentHash = 0;
+			if (inOutCache != nullptr)
+			{
+				contentHash = HashChartCourseContentForTJA(inCourse, contentHashSeed);
+
+				auto cached = std::find_if(inOutCache->Entries.begin(), inOutCache->Entries.end(), [&](const ChartCourseTJACache::Entry& e) { return (e.ContentHash == contentHash); });
+				if (cached != inOutCache->Entries.end())
+				{
+					outCourse = cached->Course;
+					offsetStringPoolEntries(outCourse.ChartCommands, 0, outStringsBegin);
+					out.Strings.Data.append(cached->Strings.Data);
+					newCacheEntries.push_back(std::move(*cached));
+					inOutCache->Entries.erase(cached);
+					inOutCache->LastReusedCount++;
+					continue;
+				}
+			}
+
 			// HACK: Write proper enum conversion functions
 			outCourse.Metadata.COURSE = static_cast<TJA::DifficultyType>(inCourse.Type);
 			outCourse.Metadata.LEVEL = static_cast<i32>(inCourse.Level);
@@ -444,9 +681,21 @@ namespace PeepoDrumKit
 					outConvertedMeasureEnd->GoGoChanges.push_back(TJA::ConvertedGoGoChange{ (endTime - outConvertedMeasureEnd->StartTime), false });
 			}
 
-			TJA::ConvertConvertedMeasuresToParsedCommands(outConvertedMeasures, outCourse.ChartCommands);
+			TJA::ConvertConvertedMeasuresToParsedCommands(outConvertedMeasures, outCourse, out.Strings);
+
+			if (inOutCache != nullptr)
+			{
+				ChartCourseTJACache::Entry& newEntry = newCacheEntries.emplace_back();
+				newEntry.ContentHash = contentHash;
+				newEntry.Course = outCourse;
+				newEntry.Strings.Data = out.Strings.Data.substr(outStringsBegin);
+				offsetStringPoolEntries(newEntry.Course.ChartCommands, outStringsBegin, 0);
+			}
 		}
 
+		if (inOutCache != nullptr)
+			inOutCache->Entries = std::move(newCacheEntries);
+
 		return true;
 	}
 }
@@ -361,6 +361,71 @@ namespace PeepoDrumKit
 	constexpr Complex ScrollOrDefault(const ScrollChange* v) { return (v == nullptr) ? Complex(1.0f, 0.0f) : v->ScrollSpeed; }
 	constexpr Tempo TempoOrDefault(const TempoChange* v) { return (v == nullptr) ? FallbackTempo : v->Tempo; }
 
+	// NOTE: Inclusive beat range of the notes added, removed or changed by an edit, so that only the notes around them have to be updated
+	struct NoteBeatRange
+	{
+		Beat Min = Beat::FromTicks(I32Max);
+		Beat Max = Beat::FromTicks(I32Min);
+
+		static constexpr NoteBeatRange FromBeat(Beat beat) { return NoteBeatRange { beat, beat }; }
+
+		constexpr void Add(Beat beat) { Min = (beat < Min) ? beat : Min; Max = (Max < beat) ? beat : Max; }
+		constexpr void Add(const NoteBeatRange& other) { if (!other.IsEmpty()) { Add(other.Min); Add(other.Max); } }
+		constexpr b8 IsEmpty() const { return (Max < Min); }
+	};
+
+	enum class GenericList : u8
+	{
+		TempoChanges,
+		SignatureChanges,
+		Notes_Normal,
+		Notes_Expert,
+		Notes_Master,
+		ScrollChanges,
+		BarLineChanges,
+		GoGoRanges,
+		Lyrics,
+		ScrollType,
+		JPOSScroll,
+		Count
+	};
+
+	// NOTE: Sorted indices of the selected items of a single GenericList, see ChartCourse::GetSelectedIndices()
+	struct ChartSelectionIndex
+	{
+		std::vector<size_t> SortedIndices;
+		b8 IsValid = false;
+
+		inline void Update(size_t index, b8 isSelected)
+		{
+			const auto it = std::lower_bound(SortedIndices.begin(), SortedIndices.end(), index);
+			const b8 wasSelected = (it != SortedIndices.end() && *it == index);
+			if (isSelected && !wasSelected)
+				SortedIndices.insert(it, index);
+			else if (!isSelected && wasSelected)
+				SortedIndices.erase(it);
+		}
+	};
+
+	// NOTE: Summary of all notes of a single branch, see ChartCourse::GetStats()
+	struct ChartCourseStats
+	{
+		i32 NoteCountPerType[EnumCount<NoteType>] = {};
+		i32 DonCount = 0, KaCount = 0, KaDonCount = 0, AdlibCount = 0, BombCount = 0;
+		i32 MaxCombo = 0;
+
+		i32 DrumrollCount = 0, BalloonCount = 0, BalloonPopCount = 0;
+		Time DrumrollDuration = Time::Zero();
+
+		// NOTE: Number of combo notes within each whole second since the first one, as f32 to be plotted directly
+		Time FirstHitTime = Time::Zero(), LastHitTime = Time::Zero();
+		std::vector<f32> HitsPerSecond;
+
+		// NOTE: Most combo notes within any sliding one second window
+		i32 PeakHitsPerSecond = 0;
+		Time PeakHitsPerSecondTime = Time::Zero();
+	};
+
 	struct ChartCourse
 	{
 		DifficultyType Type = DifficultyType::Oni;
@@ -405,6 +470,37 @@ namespace PeepoDrumKit
 		}
 
 		void RecalculateSENotes(BranchType branch) const; // implemented in chart_editor_widgets_game.cpp
+
+		// NOTE: Only reassigns the notes whose SE type can depend on the changed notes, for edits that didn't touch the tempo map or any scroll changes
+		void RecalculateSENotes(BranchType branch, NoteBeatRange changedNotes) const; // implemented in chart_editor_widgets_game.cpp
+
+		// NOTE: Recounted at most once after each InvalidateStats() instead of scanning every note every time the stats are displayed.
+		//		 Must be called by whatever edits the notes or the tempo map (which the undo commands take care of)
+		const ChartCourseStats& GetStats(BranchType branch) const;
+		inline void InvalidateStats(BranchType branch) const { assert(branch < BranchType::Count); TempStatsAreValid[EnumToIndex(branch)] = false; }
+		inline void InvalidateStats() const { for (b8& isValid : TempStatsAreValid) isValid = false; }
+
+		// NOTE: Temp cache storage for GetStats()
+		mutable ChartCourseStats TempStats[EnumCount<BranchType>];
+		mutable b8 TempStatsAreValid[EnumCount<BranchType>] = {};
+
+		// NOTE: Rebuilt at most once after each InvalidateSelectionIndex() and otherwise kept in sync by single-item SetIsSelected(..., course, ...) toggles,
+		//		 so that the selected items can be counted and iterated without scanning every list for their IsSelected flag.
+		//		 Must be invalidated by whatever inserts, removes or replaces list items (which the undo commands take care of)
+		const std::vector<size_t>& GetSelectedIndices(GenericList list) const;
+		inline void InvalidateSelectionIndex(GenericList list) const { assert(list < GenericList::Count); TempSelection[EnumToIndex(list)].IsValid = false; }
+		inline void InvalidateSelectionIndex() const { for (ChartSelectionIndex& selection : TempSelection) selection.IsValid = false; }
+
+		// NOTE: Temp cache storage for GetSelectedIndices()
+		mutable ChartSelectionIndex TempSelection[EnumCount<GenericList>];
+
+		// NOTE: Accumulated by the batched undo commands and only resolved once by FlushDeferredRefresh() at the end of the frame,
+		//		 no matter how many commands have been executed in between. Until then the tempo map acceleration structure and the SE notes may be outdated
+		void DeferRefresh(b8 tempoMapChanged, const NoteBeatRange (&changedNotesPerBranch)[EnumCount<BranchType>]);
+		void FlushDeferredRefresh();
+
+		b8 DeferredTempoMapRebuild = false;
+		NoteBeatRange DeferredSENotes[EnumCount<BranchType>] {};
 	};
 
 	// NOTE: Internal representation of a chart. Can then be imported / exported as .tja (and maybe as the native fumen binary format too eventually?)
@@ -473,27 +569,30 @@ namespace PeepoDrumKit
 
 	Beat FindCourseMaxUsedBeat(const ChartCourse& course);
 	b8 CreateChartProjectFromTJA(const TJA::ParsedTJA& inTJA, ChartProject& out);
-	b8 ConvertChartProjectToTJA(const ChartProject& in, TJA::ParsedTJA& out, b8 includePeepoDrumKitComment = true);
-}
 
-namespace PeepoDrumKit
-{
-	enum class GenericList : u8
+	// NOTE: Converted courses that ConvertChartProjectToTJA() can reuse for every course whose exported content hasn't changed since the last call.
+	//		 Each entry owns its own string pool so that it can be appended to any output file. Not thread safe, each user (such as the autosave) owns its own
+	struct ChartCourseTJACache
 	{
-		TempoChanges,
-		SignatureChanges,
-		Notes_Normal,
-		Notes_Expert,
-		Notes_Master,
-		ScrollChanges,
-		BarLineChanges,
-		GoGoRanges,
-		Lyrics,
-		ScrollType,
-		JPOSScroll,
-		Count
+		struct Entry
+		{
+			u64 ContentHash;
+			TJA::ParsedCourse Course;
+			TJA::StringPool Strings;
+		};
+
+		std::vector<Entry> Entries;
+		size_t LastReusedCount = 0;
 	};
 
+	b8 ConvertChartProjectToTJA(const ChartProject& in, TJA::ParsedTJA& out, b8 includePeepoDrumKitComment = true, ChartCourseTJACache* inOutCache = nullptr);
+
+	// NOTE: Deep copy to be handed off to a worker thread (for saving) while the editor keeps on modifying the original
+	ChartProject CreateChartProjectSnapshot(const ChartProject& in);
+}
+
+namespace PeepoDrumKit
+{
 	enum class GenericMember : u8
 	{
 		B8_IsSelected,
@@ -869,6 +968,8 @@ namespace PeepoDrumKit
 	template <typename... Args>
 	constexpr Beat GetBeatDuration(Args&&... args) { return GetOrEmpty<GenericMember::Beat_Duration>(std::forward<Args>(args)...); }
 	template <typename... Args>
+	constexpr Time GetTimeOffset(Args&&... args) { return GetOrEmpty<GenericMember::Time_Offset>(std::forward<Args>(args)...); }
+	template <typename... Args>
 	constexpr std::tuple<bool, Time> GetTimeDuration(Args&&... args) { f32 v{}; return { TryGet<GenericMember::F32_JPOSScrollDuration>(std::forward<Args>(args)..., v), Time::FromSec(v) }; }
 
 	// unfortunately the parameter order has to be changed to make function overloading works
@@ -1088,6 +1189,8 @@ namespace PeepoDrumKit
 
 	// course list attribute query functions
 	constexpr b8 IsNotesList(GenericList list) { return (list == GenericList::Notes_Normal) || (list == GenericList::Notes_Expert) || (list == GenericList::Notes_Master); }
+	constexpr BranchType NotesListToBranch(GenericList list) { assert(IsNotesList(list)); return static_cast<BranchType>(EnumToIndex(list) - EnumToIndex(GenericList::Notes_Normal)); }
+	constexpr GenericList BranchToNotesList(BranchType branch) { assert(branch < BranchType::Count); return static_cast<GenericList>(EnumToIndex(GenericList::Notes_Normal) + EnumToIndex(branch)); }
 	constexpr b8 ListHasDurations(GenericList list) { return IsNotesList(list) || (list == GenericList::GoGoRanges); }
 	constexpr b8 ListUsesInclusiveBeatCheck(GenericList list) { return IsNotesList(list) || (list != GenericList::GoGoRanges && list != GenericList::Lyrics); }
 	constexpr b8 ListIsItemEndBounded(GenericList list) { return IsNotesList(list) || (list == GenericList::GoGoRanges) || (list == GenericList::JPOSScroll); }
@@ -1115,6 +1218,11 @@ namespace PeepoDrumKit
 			course);
 	}
 
+	// NOTE: Setting the beat, duration or time offset of an item in place has to invalidate the overlap index of its list
+	template <typename FAction>
+	constexpr b8 IsGenericSetAction = std::is_same_v<std::decay_t<FAction>, std::decay_t<decltype(SetGeneric)>>;
+	constexpr b8 IsGenericMemberAffectingOverlap(GenericMember member) { return (member == GenericMember::Beat_Start || member == GenericMember::Beat_Duration || member == GenericMember::Time_Offset); }
+
 	// course list element access functions
 	template <GenericMember Member, typename ChartCourseT, expect_type_t<ChartCourseT, ChartCourse> = true, typename FAction, typename... Args>
 	constexpr b8 TryDo(FAction&& action, ChartCourseT&& course, GenericList list, size_t index, Args&&...args)
@@ -1126,6 +1234,8 @@ namespace PeepoDrumKit
 					if (!(index < typedList.size()))
 						return false;
 					action(get<Member>(std::forward<decltype(typedList)>(typedList)[index]), get_or_forward<Member>(std::forward<Args>(args))...);
+					if constexpr (IsGenericSetAction<FAction> && IsGenericMemberAffectingOverlap(Member))
+						typedList.UpdateOverlapIndexAt(index);
 					return true;
 				} else {
 					return false;
@@ -1146,6 +1256,9 @@ namespace PeepoDrumKit
 						if (!(index < typedList.size()))
 							return false;
 						action(std::forward<decltype(typedMember)>(typedMember), std::forward<decltype(typedArgs)>(typedArgs)...);
+						if constexpr (IsGenericSetAction<FAction>)
+							if (IsGenericMemberAffectingOverlap(member))
+								typedList.UpdateOverlapIndexAt(index);
 						return true;
 					}, false, false,
 					std::forward<decltype(typedList)>(typedList)[index], std::forward<Args>(args)...);
@@ -1163,7 +1276,7 @@ namespace PeepoDrumKit
 	constexpr b8 TrySetGenericStruct(ChartCourse& course, GenericList list, size_t index, const GenericListStruct& inValue)
 	{
 		return ApplySingleGenericList(list,
-			[&](auto&& typedList, auto&& typedInValue) { if (InBounds(index, typedList)) { typedList[index] = typedInValue; return true; } return false; }, false,
+			[&](auto&& typedList, auto&& typedInValue) { if (InBounds(index, typedList)) { typedList[index] = typedInValue; typedList.UpdateOverlapIndexAt(index); return true; } return false; }, false,
 			course, inValue);
 	}
 
@@ -1194,6 +1307,51 @@ namespace PeepoDrumKit
 		return TryRemoveGenericStruct(course, list, GetBeat(inValueToRemove, list));
 	}
 
+	// NOTE: Batched versions of the above for a run of values of the same list (which must already be sorted by beat), merged into the list in a single pass
+	template <typename Func>
+	b8 TryAddManyOrFuncGenericStructs(ChartCourse& course, GenericList list, const GenericListStructWithType* sortedValues, size_t valueCount, Func funcExist)
+	{
+		return ApplySingleGenericList(list,
+			[&](auto&& typedList)
+			{
+				using TEvent = typename std::remove_reference_t<decltype(typedList)>::value_type;
+				std::vector<TEvent> typedValues;
+				typedValues.reserve(valueCount);
+				for (size_t i = 0; i < valueCount; i++) { assert(sortedValues[i].List == list); typedValues.push_back(get<TEvent>(sortedValues[i].Value)); }
+				typedList.InsertManyOrFunc(typedValues.data(), typedValues.size(), funcExist);
+				return true;
+			}, false,
+			course);
+	}
+
+	inline b8 TryAddOrReplaceManyGenericStructs(ChartCourse& course, GenericList list, const GenericListStructWithType* sortedValues, size_t valueCount)
+	{
+		return TryAddManyOrFuncGenericStructs(course, list, sortedValues, valueCount, [](auto& existing, auto&& valueToInsert) { existing = valueToInsert; });
+	}
+
+	inline b8 TryRemoveManyGenericStructs(ChartCourse& course, GenericList list, const GenericListStructWithType* sortedValuesToRemove, size_t valueCount)
+	{
+		std::vector<Beat> sortedBeatsToRemove;
+		sortedBeatsToRemove.reserve(valueCount);
+		for (size_t i = 0; i < valueCount; i++) { assert(sortedValuesToRemove[i].List == list); sortedBeatsToRemove.push_back(GetBeat(sortedValuesToRemove[i].Value, list)); }
+
+		return ApplySingleGenericList(list,
+			[&](auto&& typedList) { typedList.RemoveManyAtBeats(sortedBeatsToRemove.data(), sortedBeatsToRemove.size()); return true; }, false,
+			course);
+	}
+
+	// NOTE: Calls perRunFunc(list, values, valueCount) for each run of consecutive values with the same list
+	template <typename Func>
+	void ForEachGenericListRun(const std::vector<GenericListStructWithType>& values, Func perRunFunc)
+	{
+		for (size_t runStart = 0, runEnd = 0; runStart < values.size(); runStart = runEnd)
+		{
+			while (runEnd < values.size() && values[runEnd].List == values[runStart].List)
+				runEnd++;
+			perRunFunc(values[runStart].List, &values[runStart], (runEnd - runStart));
+		}
+	}
+
 	template <auto... Tags, typename FAction, typename ForEachChartItemDataT, typename ChartCourseT, typename... Args,
 		expect_type_t<ForEachChartItemDataT, struct ForEachChartItemData> = true,
 		expect_type_t<ChartCourseT, struct ChartCourse> = true>
@@ -1218,13 +1376,49 @@ namespace PeepoDrumKit
 	}
 
 	template <typename Func>
-	constexpr void ForEachSelectedChartItem(const ChartCourse& course, Func perSelectedItemFunc)
+	void ForEachSelectedChartItem(const ChartCourse& course, Func perSelectedItemFunc)
 	{
-		ApplyForEachGenericList([&](GenericList list, auto&& typedList) {
-			for (size_t i = 0; i < typedList.size(); i++)
-				if (typedList[i].IsSelected)
-					perSelectedItemFunc(ForEachChartItemData{ list, i });
-		}, course);
+		// NOTE: Iterating over a copy because perSelectedItemFunc is free to (un)select items itself
+		std::vector<size_t> selectedIndices;
+		for (GenericList list = {}; list < GenericList::Count; IncrementEnum(list))
+		{
+			selectedIndices = course.GetSelectedIndices(list);
+			for (const size_t index : selectedIndices)
+				perSelectedItemFunc(ForEachChartItemData{ list, index });
+		}
+	}
+
+	inline size_t CountSelectedChartItems(const ChartCourse& course)
+	{
+		size_t selectedItemCount = 0;
+		for (GenericList list = {}; list < GenericList::Count; IncrementEnum(list))
+			selectedItemCount += course.GetSelectedIndices(list).size();
+		return selectedItemCount;
+	}
+
+	// NOTE: Overloads for items of a course also keeping its selection index in sync, which a plain TrySet<GenericMember::B8_IsSelected>() would not
+	template <typename ChartCourseT, expect_type_t<ChartCourseT, ChartCourse> = true>
+	void SetIsSelected(b8 isSelected, ChartCourseT&& course, GenericList list, size_t index)
+	{
+		if (TrySet<GenericMember::B8_IsSelected>(course, list, index, isSelected))
+		{
+			if (ChartSelectionIndex& selection = course.TempSelection[EnumToIndex(list)]; selection.IsValid)
+				selection.Update(index, isSelected);
+		}
+	}
+
+	template <typename ForEachChartItemDataT, typename ChartCourseT, expect_type_t<ForEachChartItemDataT, ForEachChartItemData> = true, expect_type_t<ChartCourseT, ChartCourse> = true>
+	void SetIsSelected(b8 isSelected, ForEachChartItemDataT&& it, ChartCourseT&& course)
+	{
+		SetIsSelected(isSelected, course, it.List, it.Index);
+	}
+
+	// NOTE: For bulk selection changes only, where keeping the index in sync one sorted insert / erase at a time would be quadratic in the number of items.
+	//		 Writes the plain IsSelected flag, so the caller has to call ChartCourse::InvalidateSelectionIndex() once after all items have been updated
+	template <typename ForEachChartItemDataT, typename ChartCourseT, expect_type_t<ForEachChartItemDataT, ForEachChartItemData> = true, expect_type_t<ChartCourseT, ChartCourse> = true>
+	void SetIsSelectedWithoutIndexUpdate(b8 isSelected, ForEachChartItemDataT&& it, ChartCourseT&& course)
+	{
+		TrySet<GenericMember::B8_IsSelected>(course, it.List, it.Index, isSelected);
 	}
 
 	// helpers for end-unbounded events
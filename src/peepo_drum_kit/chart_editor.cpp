@@ -8,6 +8,12 @@
 namespace PeepoDrumKit
 {
 	static constexpr std::string_view UntitledChartFileName = "Untitled Chart.tja";
+	// NOTE: Relative to the working directory, same as the settings files
+	static constexpr std::string_view CacheDirectory = "cache";
+	static constexpr std::string_view SongWaveformPeakCacheDirectory = "cache/waveform";
+	static constexpr std::string_view SongPCMCacheDirectory = "cache/pcm";
+	static constexpr std::string_view AutosaveDirectory = "autosave";
+	static constexpr i32 AutosaveRotatingFileCount = 3;
 
 	static constexpr f32 PresetGuiScaleFactors[] = { 0.5, (2.0f / 3.0f), 0.75f, 0.8f, 0.9f, 1.0f, 1.1f, 1.25f, 1.5f, 1.75f, 2.0f, 2.5f, 3.0f, };
 	static constexpr f32 PresetGuiScaleFactorMin = PresetGuiScaleFactors[0];
@@ -64,6 +70,13 @@ namespace PeepoDrumKit
 		context.SetSelectedChart(context.Chart.Courses.emplace_back(std::make_unique<ChartCourse>()).get(), BranchType::Normal);
 		SetChartDefaultSettingsAndCourses(context.Chart);
 
+		// NOTE: Tempo map and SE note updates of the undo commands are batched up and resolved here once per frame
+		context.Undo.OnEndOfFrameFlush = [this]
+		{
+			for (auto& course : context.Chart.Courses)
+				course->FlushDeferredRefresh();
+		};
+
 		GlobalLastSetRequestExclusiveDeviceAccessAudioSetting = *Settings.Audio.RequestExclusiveDeviceAccess;
 		Audio::Engine.SetBackend(*Settings.Audio.RequestExclusiveDeviceAccess ? Audio::Backend::WASAPI_Exclusive : Audio::Backend::WASAPI_Shared);
 		Audio::Engine.SetBufferFrameSize(*Settings.Audio.BufferFrameSize);
@@ -143,8 +156,9 @@ namespace PeepoDrumKit
 				Gui::EndMenu();
 			}
 
-			size_t selectedItemCount = 0, selectedNoteCount = 0;
-			ForEachSelectedChartItem(*context.ChartSelectedCourse, [&](const ForEachChartItemData& it) { selectedItemCount++; selectedNoteCount += IsNotesList(it.List); });
+			const ChartCourse& selectedCourse = *context.ChartSelectedCourse;
+			const size_t selectedItemCount = CountSelectedChartItems(selectedCourse);
+			const size_t selectedNoteCount = (selectedCourse.GetSelectedIndices(GenericList::Notes_Normal).size() + selectedCourse.GetSelectedIndices(GenericList::Notes_Expert).size() + selectedCourse.GetSelectedIndices(GenericList::Notes_Master).size());
 			const b8 isAnyItemSelected = (selectedItemCount > 0);
 			const b8 isAnyNoteSelected = (selectedNoteCount > 0);
 
@@ -844,15 +858,27 @@ namespace PeepoDrumKit
 	void ChartEditor::DrawGui()
 	{
 		InternalUpdateAsyncLoading();
+		InternalUpdateAutosave();
 
-		if (tryToCloseApplicationOnNextFrame)
+		// NOTE: Only ask again once a save failed popup has been dismissed
+		if (tryToCloseApplicationOnNextFrame && !saveFailedPopup.OpenOnNextFrame && !saveFailedPopup.IsOpen)
 		{
 			tryToCloseApplicationOnNextFrame = false;
 			CheckOpenSaveConfirmationPopupThenCall([&]
 			{
+				// NOTE: The save chosen in the confirmation popup has only just been started, so never exit before it has actually succeeded
+				if (!InternalWaitForAsyncSaveChart())
+				{
+					tryToCloseApplicationOnNextFrame = true;
+					return;
+				}
+
 				if (loadSongFuture.valid()) loadSongFuture.get();
+				if (loadSongWaveformFuture.valid()) loadSongWaveformFuture.get();
+				loadSongWaveformCoarseResult = nullptr;
 				if (loadJacketFuture.valid()) loadJacketFuture.get();
 				if (importChartFuture.valid()) importChartFuture.get();
+				InternalDeleteAutosaveFiles();
 				context.Undo.ClearAll();
 				ApplicationHost::GlobalState.RequestExitNextFrame = EXIT_SUCCESS;
 			});
@@ -1271,6 +1297,31 @@ namespace PeepoDrumKit
 			Gui::PopStyleVar(2);
 		}
 
+		// NOTE: Save failed popup
+		{
+			static constexpr cstr saveFailedPopupID = "INFO_MSGBOX_SAVE_FAILED";
+			if (saveFailedPopup.OpenOnNextFrame) { Gui::OpenPopup(UI_WindowName(saveFailedPopupID)); saveFailedPopup.OpenOnNextFrame = false; }
+
+			const ImGuiViewport* mainViewport = Gui::GetMainViewport();
+			Gui::SetNextWindowPos(Rect::FromTLSize(mainViewport->Pos, mainViewport->Size).GetCenter(), ImGuiCond_Appearing, vec2(0.5f));
+
+			Gui::PushStyleVar(ImGuiStyleVar_WindowPadding, { GuiScale(6.0f), GuiScale(6.0f) });
+			b8 isPopupOpen = true;
+			saveFailedPopup.IsOpen = Gui::BeginPopupModal(UI_WindowName(saveFailedPopupID), &isPopupOpen, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings);
+			if (saveFailedPopup.IsOpen)
+			{
+				Gui::PushFont(FontMain, GuiScaleI32_AtTarget(FontBaseSizes::Medium));
+				Gui::AlignTextToFramePadding();
+				Gui::Text(UI_Str("PROMPT_MSGBOX_SAVE_FAILED_FMT_%s"), saveFailedPopup.ChartFilePath.c_str());
+				Gui::PopFont();
+
+				if (Gui::Button(UI_Str("ACT_MSGBOX_OK"), GuiScale(vec2(120.0f, 0.0f))) | (Gui::IsWindowFocused() && Gui::IsAnyPressed(*Settings.Input.Dialog_YesOrOk, false)))
+					Gui::CloseCurrentPopup();
+				Gui::EndPopup();
+			}
+			Gui::PopStyleVar(1);
+		}
+
 		context.Undo.FlushAndExecuteEndOfFrameCommands();
 	}
 
@@ -1320,6 +1371,9 @@ namespace PeepoDrumKit
 
 	ApplicationHost::CloseResponse ChartEditor::OnWindowCloseRequest()
 	{
+		// NOTE: Never exit with a save still in flight, and ask again in case it has failed
+		InternalWaitForAsyncSaveChart();
+
 		if (context.Undo.HasPendingChanges)
 		{
 			tryToCloseApplicationOnNextFrame = true;
@@ -1327,6 +1381,7 @@ namespace PeepoDrumKit
 		}
 		else
 		{
+			InternalDeleteAutosaveFiles();
 			return ApplicationHost::CloseResponse::Exit;
 		}
 	}
@@ -1346,7 +1401,13 @@ namespace PeepoDrumKit
 
 	void ChartEditor::CreateNewChart(ChartContext& context)
 	{
+		// NOTE: Keep the current chart if saving it (as part of the save confirmation popup) has failed
+		if (!InternalWaitForAsyncSaveChart())
+			return;
+
 		if (loadSongFuture.valid()) loadSongFuture.get();
+		if (loadSongWaveformFuture.valid()) loadSongWaveformFuture.get();
+		loadSongWaveformCoarseResult = nullptr;
 		if (!context.SongSourceFilePath.empty()) StartAsyncLoadingSongAudioFile("");
 		if (loadJacketFuture.valid()) loadJacketFuture.get();
 		if (!context.SongJacketFilePath.empty()) StartAsyncLoadingSongJacketFile("");
@@ -1397,22 +1458,43 @@ namespace PeepoDrumKit
 		assert(!filePath.empty());
 		if (!filePath.empty())
 		{
-			TJA::ParsedTJA tja;
-			ConvertChartProjectToTJA(context.Chart, tja);
-			std::string tjaText;
-			TJA::ConvertParsedToText(tja, tjaText, TJA::Encoding::UTF8);
+			// NOTE: Saves have to be written in the order they were made in
+			InternalWaitForAsyncSaveChart();
+
+			// NOTE: Only the snapshot is taken on the UI thread, converting and writing it out is then done on a worker thread
+			for (std::unique_ptr<ChartCourse>& course : context.Chart.Courses)
+				course->FlushDeferredRefresh();
+			ChartProject chartSnapshot = CreateChartProjectSnapshot(context.Chart);
+
+			const b8 createBackup = createBackupOfOriginalTJABeforeOverwriteSave;
+			createBackupOfOriginalTJABeforeOverwriteSave = false;
 
-			// TODO: Proper async file saving by copying in-memory
-			if (createBackupOfOriginalTJABeforeOverwriteSave)
+			saveChartFuture = std::async(std::launch::async, [chartSnapshot = std::move(chartSnapshot), tempPathCopy = std::string(filePath), createBackup]() mutable->AsyncSaveChartResult
 			{
-				static constexpr b8 overwriteExisting = false;
-				const std::string originalFileBackupPath { std::string(filePath).append(".bak") };
+				AsyncSaveChartResult result {};
+				result.ChartFilePath = std::move(tempPathCopy);
 
-				File::Copy(filePath, originalFileBackupPath, overwriteExisting);
-				createBackupOfOriginalTJABeforeOverwriteSave = false;
-			}
+				TJA::ParsedTJA tja;
+				ConvertChartProjectToTJA(chartSnapshot, tja);
+				std::string tjaText;
+				TJA::ConvertParsedToText(tja, tjaText, TJA::Encoding::UTF8);
 
-			File::WriteAllBytes(filePath, tjaText);
+				if (createBackup)
+				{
+					static constexpr b8 overwriteExisting = false;
+					const std::string originalFileBackupPath { std::string(result.ChartFilePath).append(".bak") };
+
+					File::Copy(result.ChartFilePath, originalFileBackupPath, overwriteExisting);
+				}
+
+				// NOTE: Write to a temporary file next to the original first and only then replace it,
+				//		 so that a crash or a failed write midway through can never leave behind a truncated chart file
+				const std::string tempFilePath { std::string(result.ChartFilePath).append(".tmp") };
+				static constexpr b8 overwriteExisting = true;
+
+				result.Succeeded = File::WriteAllBytes(tempFilePath, tjaText) && File::Move(tempFilePath, result.ChartFilePath, overwriteExisting);
+				return result;
+			});
 
 			context.ChartFilePath = filePath;
 			context.Undo.ClearChangesWereMade();
@@ -1458,6 +1540,9 @@ namespace PeepoDrumKit
 		if (importChartFuture.valid())
 			importChartFuture.get();
 
+		// NOTE: In case the chart that is still being saved is the one being opened
+		InternalWaitForAsyncSaveChart();
+
 		PersistentApp.RecentFiles.Add(std::string { absoluteChartFilePath });
 		importChartFuture = std::async(std::launch::async, [tempPathCopy = std::string(absoluteChartFilePath)]() mutable->AsyncImportChartResult
 		{
@@ -1514,14 +1599,39 @@ namespace PeepoDrumKit
 			});
 	}
 
+	static std::string GetPathKeyedCacheFilePath(std::string_view cacheDirectory, std::string_view keyFilePath, std::string_view fileExtension)
+	{
+		// NOTE: Named after the full path rather than the file content so that changing the (song) file overwrites its now stale cache entry
+		const std::string normalizedKeyFilePath = Path::CopyAndNormalize(keyFilePath);
+		char fileName[32];
+		const i32 fileNameLength = sprintf_s(fileName, "%016llx", static_cast<unsigned long long>(File::HashContent(normalizedKeyFilePath.data(), normalizedKeyFilePath.size())));
+
+		std::string filePath { cacheDirectory };
+		filePath += '/';
+		filePath += std::string_view(fileName, fileNameLength);
+		filePath += fileExtension;
+		return filePath;
+	}
+
+	// NOTE: Keyed on the full chart path so that different charts sharing the same file name never overwrite each other's recovery copies
+	static std::string GetChartAutosaveFilePath(std::string_view chartFilePath, i32 fileIndex)
+	{
+		char fileExtension[32];
+		const i32 fileExtensionLength = sprintf_s(fileExtension, ".autosave%d" StrViewFmtString, fileIndex, FmtStrViewArgs(TJA::Extension));
+		return GetPathKeyedCacheFilePath(AutosaveDirectory, chartFilePath, std::string_view(fileExtension, fileExtensionLength));
+	}
+
 	void ChartEditor::StartAsyncLoadingSongAudioFile(std::string_view absoluteAudioFilePath)
 	{
 		if (loadSongFuture.valid())
 			loadSongFuture.get();
+		if (loadSongWaveformFuture.valid())
+			loadSongWaveformFuture.get();
+		loadSongWaveformCoarseResult = nullptr;
 
 		context.SongWaveformFadeAnimationTarget = 0.0f;
 		loadSongStopwatch.Restart();
-		loadSongFuture = std::async(std::launch::async, [tempPathCopy = std::string(absoluteAudioFilePath)]()->AsyncLoadSongResult
+		loadSongFuture = std::async(std::launch::async, [tempPathCopy = std::string(absoluteAudioFilePath), usePCMCache = *Settings.Audio.CacheDecodedSongAudio]()->AsyncLoadSongResult
 		{
 			AsyncLoadSongResult result {};
 			result.SongFilePath = std::move(tempPathCopy);
@@ -1537,20 +1647,100 @@ namespace PeepoDrumKit
 				return result;
 			}
 
-			if (Audio::DecodeEntireFile(result.SongFilePath, fileContent.get(), fileSize, result.SampleBuffer) != Audio::DecodeFileResult::FeelsGoodMan)
+			result.SongCacheKey = { File::HashContent(fileContent.get(), fileSize), static_cast<u64>(fileSize) };
+			result.WriteSongPCMCache = usePCMCache;
+
+			// NOTE: The cached samples have already been resampled to the output sample rate and are mapped as is, skipping the decode entirely
+			if (Audio::PCMSampleBuffer cachedBuffer {}; usePCMCache && Audio::MapPCMCacheFile(GetPathKeyedCacheFilePath(SongPCMCacheDirectory, result.SongFilePath, ".pcm"), result.SongCacheKey, Audio::Engine.OutputSampleRate, cachedBuffer))
+			{
+				result.SongDuration = Audio::FramesToTimeOrZero(cachedBuffer.FrameCount, cachedBuffer.SampleRate);
+				result.SongSource = Audio::Engine.LoadSourceFromBufferMove(Path::GetFileName(result.SongFilePath), std::move(cachedBuffer));
+				if (result.SongSource != Audio::SourceHandle::Invalid)
+					return result;
+			}
+
+			// NOTE: Returns as soon as the header has been read, with the rest of the song then being decoded in the background while already playable
+			result.SongSource = Audio::Engine.LoadSourceFromFileContentStreaming(Path::GetFileName(result.SongFilePath), std::move(fileContent), fileSize);
+			if (result.SongSource == Audio::SourceHandle::Invalid)
 			{
 				printf("Failed to decode audio file '%.*s'\n", FmtStrViewArgs(result.SongFilePath));
 				return result;
 			}
 
-			// HACK: ...
-			if (result.SampleBuffer.SampleRate != Audio::Engine.OutputSampleRate)
-				Audio::LinearlyResampleBuffer<i16>(result.SampleBuffer.InterleavedSamples, result.SampleBuffer.FrameCount, result.SampleBuffer.SampleRate, result.SampleBuffer.ChannelCount, Audio::Engine.OutputSampleRate);
+			if (const Audio::PCMSampleBuffer* sampleBuffer = Audio::Engine.GetSourceSampleBufferView(result.SongSource); sampleBuffer != nullptr)
+				result.SongDuration = Audio::FramesToTimeOrZero(sampleBuffer->FrameCount, sampleBuffer->SampleRate);
 
-			if (result.SampleBuffer.ChannelCount > 0) result.WaveformL.GenerateEntireMipChainFromSampleBuffer(result.SampleBuffer, 0);
-#if !PEEPO_DEBUG // NOTE: Always ignore the second channel in debug builds for performance reasons!
-			if (result.SampleBuffer.ChannelCount > 1) result.WaveformR.GenerateEntireMipChainFromSampleBuffer(result.SampleBuffer, 1);
-#endif
+			return result;
+		});
+	}
+
+	void ChartEditor::StartAsyncGeneratingSongWaveform(Audio::SourceHandle songSource, std::string_view songFilePath, Audio::SourceCacheKey cacheKey, b8 writePCMCache, b8 completeCachedWaveform)
+	{
+		if (loadSongWaveformFuture.valid())
+			loadSongWaveformFuture.get();
+
+		// NOTE: Shared with the waveform thread so that a stale coarse result can simply be dropped by resetting the pointer on the main thread
+		loadSongWaveformCoarseResult = std::make_shared<AsyncLoadSongWaveformCoarseResult>();
+		loadSongWaveformFuture = std::async(std::launch::async, [songSource, cacheFilePath = songFilePath.empty() ? std::string() : GetPathKeyedCacheFilePath(SongWaveformPeakCacheDirectory, songFilePath, ".peaks"),
+			pcmCacheFilePath = (songFilePath.empty() || !writePCMCache) ? std::string() : GetPathKeyedCacheFilePath(SongPCMCacheDirectory, songFilePath, ".pcm"), cacheKey, writePCMCache, completeCachedWaveform,
+			coarseResult = loadSongWaveformCoarseResult]()->AsyncLoadSongWaveformResult
+		{
+			AsyncLoadSongWaveformResult result {};
+			result.SongCacheKey = cacheKey;
+			result.WriteSongPCMCache = writePCMCache;
+			if (songSource == Audio::SourceHandle::Invalid)
+				return result;
+
+			auto publishCoarseWaveforms = [&coarseResult](Audio::WaveformMipChain* coarseWaveforms, size_t coarseWaveformCount)
+			{
+				const auto lock = std::scoped_lock(coarseResult->Mutex);
+				if (coarseWaveformCount > 0) coarseResult->Result.WaveformL = std::move(coarseWaveforms[0]);
+				if (coarseWaveformCount > 1) coarseResult->Result.WaveformR = std::move(coarseWaveforms[1]);
+				coarseResult->IsReady = true;
+			};
+
+			// NOTE: A valid cache hit is served straight from the mapped file as the final result, without having to wait for the song to finish decoding.
+			//		 Only the finer mips that the cache doesn't store are then generated by a follow-up pass (see InternalUpdateAsyncLoading())
+			Audio::WaveformMipChain cachedWaveforms[2];
+			const size_t cachedWaveformCount = Audio::MapWaveformPeakCacheFile(cacheFilePath, cacheKey, cachedWaveforms, ArrayCount(cachedWaveforms));
+			if (cachedWaveformCount > 0 && !completeCachedWaveform)
+			{
+				result.WaveformL = std::move(cachedWaveforms[0]);
+				result.WaveformR = std::move(cachedWaveforms[1]);
+				result.IsMissingFineMips = true;
+				return result;
+			}
+
+			// NOTE: The source is only ever unloaded on the main thread after this future has been waited on
+			Audio::Engine.WaitForSourceStreamingToFinish(songSource);
+			const Audio::PCMSampleBuffer* sampleBuffer = Audio::Engine.GetSourceSampleBufferView(songSource);
+			if (sampleBuffer == nullptr)
+				return result;
+
+			Audio::WaveformMipChain waveforms[2];
+			const size_t waveformCount = Min<size_t>(sampleBuffer->ChannelCount, ArrayCount(waveforms));
+			if (cachedWaveformCount > 0 && cachedWaveformCount >= waveformCount)
+				Audio::CompleteMipChainsFromPeakCache(*sampleBuffer, cachedWaveforms, waveforms, waveformCount);
+			else
+				Audio::GenerateMipChainsFromSampleBuffer(*sampleBuffer, waveforms, waveformCount, publishCoarseWaveforms);
+
+			if (cachedWaveformCount == 0 && !cacheFilePath.empty())
+			{
+				Directory::Create(CacheDirectory);
+				Directory::Create(SongWaveformPeakCacheDirectory);
+				Audio::WriteWaveformPeakCacheFile(cacheFilePath, cacheKey, waveforms, waveformCount);
+			}
+
+			// NOTE: Only after the waveform has been generated, as writing out the full sample data isn't exactly free
+			if (!pcmCacheFilePath.empty() && !sampleBuffer->InterleavedSamples.IsMapped() && sampleBuffer->SampleRate == Audio::Engine.OutputSampleRate)
+			{
+				Directory::Create(CacheDirectory);
+				Directory::Create(SongPCMCacheDirectory);
+				Audio::WritePCMCacheFile(pcmCacheFilePath, cacheKey, *sampleBuffer);
+			}
+
+			result.WaveformL = std::move(waveforms[0]);
+			result.WaveformR = std::move(waveforms[1]);
 
 			return result;
 		});
@@ -1653,11 +1843,147 @@ namespace PeepoDrumKit
 		}
 	}
 
+	void ChartEditor::InternalOnAsyncSaveChartFinished(const AsyncSaveChartResult& saveResult)
+	{
+		if (saveResult.Succeeded)
+		{
+			// NOTE: The recovery copies are no longer needed once everything has been written to the chart file itself
+			if (context.ChartFilePath == saveResult.ChartFilePath && !context.Undo.HasPendingChanges)
+				InternalDeleteAutosaveFiles();
+			return;
+		}
+
+		printf("Failed to save chart file '%.*s'\n", FmtStrViewArgs(saveResult.ChartFilePath));
+		saveFailedPopup.OpenOnNextFrame = true;
+		saveFailedPopup.ChartFilePath = saveResult.ChartFilePath;
+
+		// NOTE: The changes were already marked as saved once the snapshot was taken, so bring them back
+		//		 unless a different chart has been opened in the meantime
+		if (context.ChartFilePath == saveResult.ChartFilePath)
+			context.Undo.NotifyChangesWereMade();
+	}
+
+	b8 ChartEditor::InternalWaitForAsyncSaveChart()
+	{
+		if (!saveChartFuture.valid())
+			return true;
+
+		const AsyncSaveChartResult saveResult = saveChartFuture.get();
+		InternalOnAsyncSaveChartFinished(saveResult);
+		return saveResult.Succeeded;
+	}
+
+	void ChartEditor::InternalOnAutosaveFinished(AsyncAutosaveChartResult autosaveResult)
+	{
+		autosave.Cache = std::move(autosaveResult.Cache);
+		if (autosaveResult.Succeeded && autosaveResult.WasWritten)
+		{
+			autosave.LastWrittenContentHash = autosaveResult.ContentHash;
+			autosave.NextFileIndex = (autosave.NextFileIndex + 1) % AutosaveRotatingFileCount;
+		}
+		else if (!autosaveResult.Succeeded)
+		{
+			printf("Failed to write autosave file '%s'\n", autosaveResult.AutosaveFilePath.c_str());
+		}
+	}
+
+	void ChartEditor::InternalDeleteAutosaveFiles()
+	{
+		// NOTE: An autosave still in flight would otherwise write its file again right after it has been deleted
+		if (autosave.Future.valid())
+			InternalOnAutosaveFinished(autosave.Future.get());
+
+		// NOTE: Also covers the files written before the chart path has changed, such as for an untitled chart that has then been saved as a new file
+		for (i32 fileIndex = 0; fileIndex < AutosaveRotatingFileCount; fileIndex++)
+		{
+			File::Delete(GetChartAutosaveFilePath(context.ChartFilePath, fileIndex));
+			if (autosave.ChartFilePath != context.ChartFilePath)
+				File::Delete(GetChartAutosaveFilePath(autosave.ChartFilePath, fileIndex));
+		}
+
+		autosave.LastWrittenContentHash = 0;
+		autosave.NextFileIndex = 0;
+	}
+
+	void ChartEditor::InternalUpdateAutosave()
+	{
+		if (autosave.Future.valid())
+		{
+			if (!autosave.Future._Is_ready())
+				return;
+			InternalOnAutosaveFinished(autosave.Future.get());
+		}
+
+		// NOTE: The interval is counted from the first change made since the last save or autosave snapshot, so that regularly saved charts never have to be
+		//		 autosaved at all and idle ones aren't snapshotted over and over again. Changes that have all been undone are caught by the content hash instead
+		if (!context.Undo.HasPendingChanges)
+			autosave.SnapshotNumberOfChangesMade = -1;
+
+		const i32 intervalSeconds = *Settings.General.AutosaveIntervalSeconds;
+		if (intervalSeconds <= 0 || !context.Undo.HasPendingChanges || context.Undo.NumberOfChangesMade == autosave.SnapshotNumberOfChangesMade)
+		{
+			autosave.Stopwatch.Stop();
+			return;
+		}
+
+		autosave.Stopwatch.Start();
+		if (autosave.Stopwatch.GetElapsed() < Time::FromSec(static_cast<f64>(intervalSeconds)))
+			return;
+		autosave.Stopwatch.Stop();
+		autosave.SnapshotNumberOfChangesMade = context.Undo.NumberOfChangesMade;
+
+		// NOTE: Same as for regular saves only the snapshot is taken on the UI thread. Courses that haven't changed since the previous autosave
+		//		 are then skipped over on the worker thread by reusing their cached TJA conversion instead of converting them all over again
+		for (std::unique_ptr<ChartCourse>& course : context.Chart.Courses)
+			course->FlushDeferredRefresh();
+		ChartProject chartSnapshot = CreateChartProjectSnapshot(context.Chart);
+
+		if (autosave.ChartFilePath != context.ChartFilePath)
+		{
+			autosave.ChartFilePath = context.ChartFilePath;
+			autosave.LastWrittenContentHash = 0;
+			autosave.NextFileIndex = 0;
+		}
+		std::string autosaveFilePath = GetChartAutosaveFilePath(context.ChartFilePath, autosave.NextFileIndex);
+
+		autosave.Future = std::async(std::launch::async, [chartSnapshot = std::move(chartSnapshot), cache = std::move(autosave.Cache), autosaveFilePath = std::move(autosaveFilePath),
+			lastWrittenContentHash = autosave.LastWrittenContentHash]() mutable->AsyncAutosaveChartResult
+		{
+			AsyncAutosaveChartResult result {};
+			result.AutosaveFilePath = std::move(autosaveFilePath);
+
+			TJA::ParsedTJA tja;
+			ConvertChartProjectToTJA(chartSnapshot, tja, true, &cache);
+			std::string tjaText;
+			TJA::ConvertParsedToText(tja, tjaText, TJA::Encoding::UTF8);
+			result.Cache = std::move(cache);
+
+			// NOTE: Changes that have all been undone again since the previous autosave don't need to be written out a second time
+			result.ContentHash = File::HashContent(tjaText.data(), tjaText.size());
+			if (result.ContentHash == lastWrittenContentHash)
+			{
+				result.Succeeded = true;
+				return result;
+			}
+
+			Directory::Create(AutosaveDirectory);
+			const std::string tempFilePath { std::string(result.AutosaveFilePath).append(".tmp") };
+			static constexpr b8 overwriteExisting = true;
+
+			result.Succeeded = File::WriteAllBytes(tempFilePath, tjaText) && File::Move(tempFilePath, result.AutosaveFilePath, overwriteExisting);
+			result.WasWritten = result.Succeeded;
+			return result;
+		});
+	}
+
 	void ChartEditor::InternalUpdateAsyncLoading()
 	{
 		context.Gfx.UpdateAsyncLoading();
 		context.SfxVoicePool.UpdateAsyncLoading();
 
+		if (saveChartFuture.valid() && saveChartFuture._Is_ready())
+			InternalOnAsyncSaveChartFinished(saveChartFuture.get());
+
 		if (importChartFuture.valid() && importChartFuture._Is_ready())
 		{
 			const Time previousChartSongOffset = context.Chart.SongOffset;
@@ -1694,26 +2020,51 @@ namespace PeepoDrumKit
 			loadSongStopwatch.Stop();
 			AsyncLoadSongResult loadResult = loadSongFuture.get();
 			context.SongSourceFilePath = std::move(loadResult.SongFilePath);
-			context.SongWaveformL = std::move(loadResult.WaveformL);
-			context.SongWaveformR = std::move(loadResult.WaveformR);
-			context.SongWaveformFadeAnimationTarget = context.SongWaveformL.IsEmpty() ? 0.0f : 1.0f;
+			context.SongWaveformL = {};
+			context.SongWaveformR = {};
 
 			// TODO: Maybe handle this differently...
 			if (context.Chart.ChartTitle.empty() && !context.SongSourceFilePath.empty())
 				context.Chart.ChartTitle = Path::GetFileName(context.SongSourceFilePath, false);
 
-			if (context.Chart.ChartDuration.Seconds <= 0.0 && loadResult.SampleBuffer.SampleRate > 0)
-				context.Chart.ChartDuration = Audio::FramesToTime(loadResult.SampleBuffer.FrameCount, loadResult.SampleBuffer.SampleRate);
+			if (context.Chart.ChartDuration.Seconds <= 0.0 && loadResult.SongDuration.Seconds > 0.0)
+				context.Chart.ChartDuration = loadResult.SongDuration;
 
 			if (context.SongSource != Audio::SourceHandle::Invalid)
 				Audio::Engine.UnloadSource(context.SongSource);
 
-			context.SongSource = Audio::Engine.LoadSourceFromBufferMove(Path::GetFileName(context.SongSourceFilePath), std::move(loadResult.SampleBuffer));
+			context.SongSource = loadResult.SongSource;
 			context.SongVoice.SetSource(context.SongSource);
+			StartAsyncGeneratingSongWaveform(context.SongSource, context.SongSourceFilePath, loadResult.SongCacheKey, loadResult.WriteSongPCMCache);
 
 			Audio::Engine.EnsureStreamRunning();
 		}
 
+		if (loadSongWaveformCoarseResult != nullptr)
+		{
+			const auto lock = std::scoped_lock(loadSongWaveformCoarseResult->Mutex);
+			if (loadSongWaveformCoarseResult->IsReady)
+			{
+				// NOTE: Show the low resolution waveform right away, to be replaced once all of the finer mips have been generated
+				context.SongWaveformL = std::move(loadSongWaveformCoarseResult->Result.WaveformL);
+				context.SongWaveformR = std::move(loadSongWaveformCoarseResult->Result.WaveformR);
+				context.SongWaveformFadeAnimationTarget = context.SongWaveformL.IsEmpty() ? 0.0f : 1.0f;
+				loadSongWaveformCoarseResult->IsReady = false;
+			}
+		}
+
+		if (loadSongWaveformFuture.valid() && loadSongWaveformFuture._Is_ready())
+		{
+			loadSongWaveformCoarseResult = nullptr;
+			AsyncLoadSongWaveformResult loadResult = loadSongWaveformFuture.get();
+			context.SongWaveformL = std::move(loadResult.WaveformL);
+			context.SongWaveformR = std::move(loadResult.WaveformR);
+			context.SongWaveformFadeAnimationTarget = context.SongWaveformL.IsEmpty() ? 0.0f : 1.0f;
+
+			if (loadResult.IsMissingFineMips)
+				StartAsyncGeneratingSongWaveform(context.SongSource, context.SongSourceFilePath, loadResult.SongCacheKey, loadResult.WriteSongPCMCache, true);
+		}
+
 		if (loadJacketFuture.valid() && loadJacketFuture._Is_ready())
 		{
 			AsyncLoadJacketResult loadResult = loadJacketFuture.get();
@@ -12,6 +12,8 @@
 #include "test_gui_audio.h"
 #include "test_gui_tja.h"
 
+#include <mutex>
+
 namespace PeepoDrumKit
 {
 	struct AsyncImportChartResult
@@ -29,11 +31,45 @@ namespace PeepoDrumKit
 		} TJA;
 	};
 
+	struct AsyncSaveChartResult
+	{
+		std::string ChartFilePath;
+		b8 Succeeded = false;
+	};
+
+	struct AsyncAutosaveChartResult
+	{
+		std::string AutosaveFilePath;
+		b8 Succeeded = false;
+		b8 WasWritten = false;
+		u64 ContentHash = 0;
+		ChartCourseTJACache Cache;
+	};
+
 	struct AsyncLoadSongResult
 	{
 		std::string SongFilePath;
-		Audio::PCMSampleBuffer SampleBuffer;
+		Audio::SourceHandle SongSource = Audio::SourceHandle::Invalid;
+		Time SongDuration;
+		Audio::SourceCacheKey SongCacheKey;
+		b8 WriteSongPCMCache = false;
+	};
+
+	struct AsyncLoadSongWaveformResult
+	{
 		Audio::WaveformMipChain WaveformL, WaveformR;
+		// NOTE: Set when served straight from the peak cache, which doesn't store the finest mips that then still have to be generated once the song has been decoded
+		b8 IsMissingFineMips = false;
+		Audio::SourceCacheKey SongCacheKey = {};
+		b8 WriteSongPCMCache = false;
+	};
+
+	// NOTE: Handed over from the waveform thread while the full resolution result is still being generated
+	struct AsyncLoadSongWaveformCoarseResult
+	{
+		std::mutex Mutex;
+		b8 IsReady = false;
+		AsyncLoadSongWaveformResult Result;
 	};
 
 	struct AsyncLoadJacketResult
@@ -64,6 +100,7 @@ namespace PeepoDrumKit
 
 		void StartAsyncImportingChartFile(std::string_view absoluteChartFilePath);
 		void StartAsyncLoadingSongAudioFile(std::string_view absoluteAudioFilePath);
+		void StartAsyncGeneratingSongWaveform(Audio::SourceHandle songSource, std::string_view songFilePath, Audio::SourceCacheKey cacheKey, b8 writePCMCache, b8 completeCachedWaveform = false);
 		void StartAsyncLoadingSongJacketFile(std::string_view absoluteJacketFilePath);
 		void SetAndStartLoadingChartSongFileName(std::string_view relativeOrAbsoluteAudioFilePath, Undo::UndoHistory& undo);
 		void SetAndStartLoadingSongJacketFileName(std::string_view relativeOrAbsoluteAudioFilePath, Undo::UndoHistory& undo);
@@ -74,6 +111,12 @@ namespace PeepoDrumKit
 
 		void CheckOpenSaveConfirmationPopupThenCall(std::function<void()> onSuccess);
 		void InternalUpdateAsyncLoading();
+		void InternalOnAsyncSaveChartFinished(const AsyncSaveChartResult& saveResult);
+		// NOTE: Returns false if the save that was still in flight has failed
+		b8 InternalWaitForAsyncSaveChart();
+		void InternalUpdateAutosave();
+		void InternalOnAutosaveFinished(AsyncAutosaveChartResult autosaveResult);
+		void InternalDeleteAutosaveFiles();
 
 	private:
 		ChartContext context = {};
@@ -81,7 +124,10 @@ namespace PeepoDrumKit
 		ChartGamePreview gamePreview = {};
 
 		std::future<AsyncImportChartResult> importChartFuture {};
+		std::future<AsyncSaveChartResult> saveChartFuture {};
 		std::future<AsyncLoadSongResult> loadSongFuture {};
+		std::future<AsyncLoadSongWaveformResult> loadSongWaveformFuture {};
+		std::shared_ptr<AsyncLoadSongWaveformCoarseResult> loadSongWaveformCoarseResult {};
 		std::future<AsyncLoadJacketResult> loadJacketFuture {};
 		CPUStopwatch loadSongStopwatch = {};
 		b8 createBackupOfOriginalTJABeforeOverwriteSave = false;
@@ -115,12 +161,33 @@ namespace PeepoDrumKit
 			inline void OnChange() { TimeSinceLastChange = {}; }
 		} zoomPopup = {};
 
+		// NOTE: The cache is handed over to the worker thread while an autosave is in flight and returned along with its result
+		struct AutosaveData
+		{
+			CPUStopwatch Stopwatch;
+			std::future<AsyncAutosaveChartResult> Future;
+			ChartCourseTJACache Cache;
+			u64 LastWrittenContentHash;
+			i32 NextFileIndex;
+			// NOTE: Undo change count at the time of the last snapshot, so that an idle chart with unsaved changes isn't snapshotted again and again
+			i32 SnapshotNumberOfChangesMade;
+			// NOTE: Chart path the autosave files have been named after
+			std::string ChartFilePath;
+		} autosave = {};
+
 		struct SaveConfirmationPopupData
 		{
 			b8 OpenOnNextFrame;
 			std::function<void()> OnSuccessFunction;
 		} saveConfirmationPopup = {};
 
+		struct SaveFailedPopupData
+		{
+			b8 OpenOnNextFrame;
+			b8 IsOpen;
+			std::string ChartFilePath;
+		} saveFailedPopup = {};
+
 		struct PerformanceData
 		{
 			b8 ShowOverlay;
@@ -167,6 +167,10 @@ X("PROMPT_MSGBOX_UNSAVED_SAVE_CHANGES",				"Save changes to the current file?")
 X("ACT_MSGBOX_UNSAVED_SAVE_CHANGES",				"Save Changes") \
 X("ACT_MSGBOX_UNSAVED_DISCARD_CHANGES",				"Discard Changes") \
 X("ACT_MSGBOX_CANCEL",								"Cancel") \
+/* save failed message box */ \
+X("INFO_MSGBOX_SAVE_FAILED",						"Peepo Drum Kit - Save Failed") \
+X("PROMPT_MSGBOX_SAVE_FAILED_FMT_%s",				"Failed to save the chart to '%s'. The changes have not been saved.") \
+X("ACT_MSGBOX_OK",									"OK") \
 /* chart events tab / timeline tab */ \
 X("DETAILS_CHART_EVENT_EVENTS",						"Events") \
 X("EVENT_TEMPO",									"Tempo") \
@@ -275,6 +279,8 @@ X("TOWER_SIDE_BOTH",								"Unspecified (Both)") \
 X("UNDO_HISTORY_DESCRIPTION",						"Description") \
 X("UNDO_HISTORY_TIME",								"Time") \
 X("UNDO_HISTORY_INITIAL_STATE",						"Initial State") \
+X("UNDO_HISTORY_MEMORY_USAGE",						"Memory Usage") \
+X("UNDO_HISTORY_DROPPED_COMMANDS",					"Dropped Commands") \
 /* lyrics tab */ \
 X("DETAILS_LYRICS_OVERVIEW",						"Lyrics Overview") \
 X("DETAILS_LYRICS_EDIT_LINE",						"Edit Line") \
@@ -388,6 +388,7 @@ namespace PeepoDrumKit
 		});
 
 		out.General.DrumrollAutoHitBarDivision.Value = Clamp(out.General.DrumrollAutoHitBarDivision.Value, 1, Beat::TicksPerBeat);
+		out.General.AutosaveIntervalSeconds.Value = ClampBot(out.General.AutosaveIntervalSeconds.Value, 0);
 
 		return parser.Result;
 	}
@@ -448,6 +449,7 @@ namespace PeepoDrumKit
 		{
 			SECTION("general");
 			X(General.DefaultCreatorName, "default_creator_name");
+			X(General.AutosaveIntervalSeconds, "autosave_interval_seconds");
 			X(General.DrumrollAutoHitBarDivision, "drumroll_auto_hit_bar_division");
 			X(General.DisplayTimeInSongSpace, "display_time_in_song_space");
 			X(General.TimelineScrollInvertMouseWheel, "timeline_scroll_invert_mouse_wheel");
@@ -476,6 +478,7 @@ namespace PeepoDrumKit
 			X(Audio.CloseDeviceOnIdleFocusLoss, "close_device_on_idle_focus_loss");
 			X(Audio.RequestExclusiveDeviceAccess, "request_exclusive_device_access");
 			X(Audio.BufferFrameSize, "buffer_frame_size");
+			X(Audio.CacheDecodedSongAudio, "cache_decoded_song_audio");
 
 			SECTION("animation");
 			X(Animation.EnableGuiScaleAnimation, "enable_gui_scale_animation");
@@ -128,6 +128,7 @@ namespace PeepoDrumKit
 		struct GeneralData
 		{
 			WithDefault<std::string> DefaultCreatorName = {};
+			WithDefault<i32> AutosaveIntervalSeconds = 120;
 			WithDefault<i32> DrumrollAutoHitBarDivision = 16;
 			WithDefault<b8> DisplayTimeInSongSpace = false;
 			WithDefault<b8> TimelineScrollInvertMouseWheel = false;
@@ -161,6 +162,7 @@ namespace PeepoDrumKit
 			WithDefault<b8> CloseDeviceOnIdleFocusLoss = false;
 			WithDefault<b8> RequestExclusiveDeviceAccess = false;
 			WithDefault<i32> BufferFrameSize = 0;
+			WithDefault<b8> CacheDecodedSongAudio = false;
 		} Audio;
 
 		struct AnimationData
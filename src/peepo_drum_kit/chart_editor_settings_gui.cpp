@@ -698,6 +698,12 @@ namespace PeepoDrumKit
 							"General: Default Creator Name",
 							"The name that is automatically filled in when creating a new chart."),
 
+						SettingsGui::SettingsEntry(
+							settings.General.AutosaveIntervalSeconds,
+							"General: Autosave Interval",
+							"The number of seconds between writing a recovery copy of a chart with unsaved changes to the \"autosave\" directory.\n"
+							"Set to 0 to disable autosave."),
+
 						SettingsGui::SettingsEntry(
 							settings.General.DrumrollAutoHitBarDivision,
 							"General: Drumroll Preview Interval",
@@ -903,6 +909,12 @@ namespace PeepoDrumKit
 							"Prevent audio distortion by requesting sufficient buffer size (adding audio latency).\n"
 							"The minimum resulting size is the minimum possible size reported by the device.",
 							SettingsGui::WidgetType::I32_AudioBufferFrameSize),
+
+						SettingsGui::SettingsEntry(
+							settings.Audio.CacheDecodedSongAudio,
+							"Cache Decoded Song Audio",
+							"Store the decoded samples of each opened song on disk so that reopening it doesn't have to decode it again.\n"
+							"Uses roughly 10 MB of disk space per minute of stereo audio, which is never cleaned up automatically."),
 					};
 
 					changesWereMade |= SettingsGui::DrawEntriesListTableGui(settingsEntriesAudio, ArrayCount(settingsEntriesAudio), nullptr, lastActiveGroup);
@@ -1,6 +1,7 @@
 #include "chart_editor_sound.h"
 #include "core_io.h"
 #include "audio/audio_file_formats.h"
+#include "audio/audio_resampler.h"
 
 namespace PeepoDrumKit
 {
@@ -30,7 +31,7 @@ namespace PeepoDrumKit
 
 				// HACK: ...
 				if (resultBuffer.SampleRate != Audio::Engine.OutputSampleRate)
-					Audio::LinearlyResampleBuffer<i16>(resultBuffer.InterleavedSamples, resultBuffer.FrameCount, resultBuffer.SampleRate, resultBuffer.ChannelCount, Audio::Engine.OutputSampleRate);
+					Audio::PolyphaseResampleBuffer(resultBuffer.InterleavedSamples, resultBuffer.FrameCount, resultBuffer.SampleRate, resultBuffer.ChannelCount, Audio::Engine.OutputSampleRate);
 			}
 			return result;
 		});
@@ -554,19 +554,20 @@ namespace PeepoDrumKit
 			if (waveform.IsEmpty())
 				continue;
 
-			const auto& waveformMip = waveform.FindClosestMip(waveformTimePerPixel);
-			for (i32 visiblePixel = 0; visiblePixel < contentRect.GetWidth(); /*visiblePixel++*/)
+			for (i32 visiblePixel = 0; visiblePixel < contentRect.GetWidth(); visiblePixel += CustomDraw::WaveformPixelsPerChunk)
 			{
 				CustomDraw::WaveformChunk chunk;
 				const Rect chunkRect = Rect::FromTLSize(timeline.LocalToScreenSpace(vec2(static_cast<f32>(visiblePixel), 0.5f)), vec2(static_cast<f32>(CustomDraw::WaveformPixelsPerChunk), rowsHeight));
 
+				const Time chunkStartTime = timeline.Camera.LocalSpaceXToTime(static_cast<f32>(visiblePixel)) - chartSongOffset;
+				waveform.GetPeakAmplitudeRow(chunkStartTime, waveformTimePerPixel, CustomDraw::WaveformPixelsPerChunk, chunk.PerPixelAmplitude);
+
 				for (i32 chunkPixel = 0; chunkPixel < CustomDraw::WaveformPixelsPerChunk; chunkPixel++)
 				{
-					const Time timeAtPixel = timeline.Camera.LocalSpaceXToTime(static_cast<f32>(visiblePixel)) - chartSongOffset;
+					const Time timeAtPixel = chunkStartTime + (waveformTimePerPixel * static_cast<f64>(chunkPixel));
 					const b8 outOfBounds = (timeAtPixel < Time::Zero() || (timeAtPixel > waveformDuration));
 
-					chunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(waveform.GetAmplitudeAt(waveformMip, timeAtPixel, waveformTimePerPixel), minAmplitude));
-					visiblePixel++;
+					chunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(chunk.PerPixelAmplitude[chunkPixel], minAmplitude));
 				}
 
 				CustomDraw::DrawWaveformChunk(drawList, chunkRect, waveformColor, chunk);
@@ -585,6 +586,19 @@ namespace PeepoDrumKit
 		Beat CursorBeatOnPlaybackStart;
 	};
 
+	struct MinMaxBeat { Beat Min, Max; };
+
+	// NOTE: Conservative beat range of all the items that could be visible inside the time range (after applying their time offsets),
+	//		 padded by a tick on either side to account for TimeToBeat() rounding to the closest tick
+	template <typename T>
+	static MinMaxBeat GetVisibleBeatRange(const ChartContext& context, const BeatSortedList<T>& list, ChartTimeline::MinMaxTime visibleTime)
+	{
+		Time minTimeOffset = Time::Zero(), maxTimeOffset = Time::Zero();
+		if constexpr (std::is_same_v<T, Note>)
+			list.GetTimeOffsetBounds(minTimeOffset, maxTimeOffset);
+		return MinMaxBeat { context.TimeToBeat(visibleTime.Min - maxTimeOffset) - Beat::FromTicks(1), context.TimeToBeat(visibleTime.Max - minTimeOffset) + Beat::FromTicks(1) };
+	}
+
 	template <typename T, TimelineRowType RowType>
 	static void DrawTimelineContentItemRowT(DrawTimelineContentItemRowParam param, const ForEachRowData& rowIt, const BeatSortedList<T>& list)
 	{
@@ -594,7 +608,9 @@ namespace PeepoDrumKit
 		const TimelineCamera& camera = timeline.Camera;
 		const ChartTimeline::MinMaxTime visibleTime = param.VisibleTime;
 
-		// TODO: Do culling by first determining min/max visible beat times then use those to continue / break inside loop (although problematic with TimeOffset?)
+		// NOTE: Only the items inside the visible beat range are iterated (binary searched or via the overlap index for long items starting before it),
+		//		 with the per item visible time check below then only having to cull the few items around the edges
+		const MinMaxBeat visibleBeat = GetVisibleBeatRange(context, list, visibleTime);
 		if constexpr (std::is_same_v<T, Note>)
 		{
 			// TODO: Draw unselected branch notes grayed and at a slightly smaller scale (also nicely animate between selecting different branched!)
@@ -602,12 +618,12 @@ namespace PeepoDrumKit
 			// TODO: It looks like there'll also have to be one scroll speed lane per branch type
 			//		 which means the scroll speed change line should probably extend all to the way down to its corresponding note lane (?)
 
-			for (const Note& it : list)
+			list.ForEachOverlappingBeat(visibleBeat.Min, visibleBeat.Max, true, [&](const Note& it)
 			{
 				const Time startTime = context.BeatToTime(it.GetStart()) + it.TimeOffset;
 				const Time endTime = (it.BeatDuration > Beat::Zero()) ? context.BeatToTime(it.GetEnd()) + it.TimeOffset : startTime;
 				if (endTime < visibleTime.Min || startTime > visibleTime.Max)
-					continue;
+					return;
 
 				const vec2 localTL = vec2(timeline.Camera.TimeToLocalSpaceX(startTime), rowIt.LocalY);
 				const vec2 localCenter = localTL + vec2(0.0f, rowIt.LocalHeight * 0.5f);
@@ -637,7 +653,7 @@ namespace PeepoDrumKit
 					if (it.BeatDuration > Beat::Zero())
 						timeline.TempSelectionBoxesDrawBuffer.push_back(ChartTimeline::TempDrawSelectionBox{ Rect::FromCenterSize(timeline.LocalToScreenSpace(localCenterEnd - vec2(localSpaceTimeOffsetX, 0.0f)), hitBoxSize), TimelineSelectedNoteBoxBackgroundColor, TimelineSelectedNoteBoxBorderColor });
 				}
-			}
+			});
 
 			static constexpr BranchType branchForThisRow = TimelineRowToBranchType(RowType);
 			if (!timeline.TempDeletedNoteAnimationsBuffer.empty())
@@ -688,25 +704,29 @@ namespace PeepoDrumKit
 		}
 		else if constexpr (std::is_same_v<T, GoGoRange>)
 		{
-			for (const GoGoRange& it : list)
+			list.ForEachOverlappingBeat(visibleBeat.Min, visibleBeat.Max, true, [&](const GoGoRange& it)
 			{
 				const Time startTime = context.BeatToTime(it.GetStart());
 				const Time endTime = context.BeatToTime(it.GetEnd());
 				if (endTime < visibleTime.Min || startTime > visibleTime.Max)
-					continue;
+					return;
 
 				static constexpr f32 margin = 1.0f;
 				const vec2 localTL = vec2(camera.TimeToLocalSpaceX(startTime), 0.0f) + vec2(0.0f, rowIt.LocalY + margin);
 				const vec2 localBR = vec2(camera.TimeToLocalSpaceX(endTime), 0.0f) + vec2(0.0f, rowIt.LocalY + rowIt.LocalHeight - (margin * 2.0f));
 				DrawTimelineGoGoTimeBackground(drawListContent, timeline.LocalToScreenSpace(localTL) + vec2(0.0f, 2.0f), timeline.LocalToScreenSpace(localBR), it.ExpansionAnimationCurrent, it.IsSelected);
-			}
+			});
 		}
 		else if constexpr (std::is_same_v<T, LyricChange>)
 		{
 			const Beat chartBeatDuration = context.TimeToBeat(context.Chart.GetDurationOrDefault());
 
+			// NOTE: Each lyric extends until the next one so the last one starting before the visible range has to be included too
+			const size_t visibleIndexBegin = SearchForFirstIndexAtOrAfterBeat(list.Sorted, visibleBeat.Min);
+			const size_t visibleIndexEnd = SearchForFirstIndexAfterBeat(list.Sorted, visibleBeat.Max, visibleIndexBegin);
+
 			Gui::PushFont(FontMain, GuiScaleI32_AtTarget(FontBaseSizes::Small));
-			for (size_t i = 0; i < list.size(); i++)
+			for (size_t i = (visibleIndexBegin > 0) ? (visibleIndexBegin - 1) : 0; i < visibleIndexEnd; i++)
 			{
 				const LyricChange* prevLyric = IndexOrNull(static_cast<i32>(i) - 1, list);
 				const LyricChange& thisLyric = list[i];
@@ -756,8 +776,13 @@ namespace PeepoDrumKit
 			const b8 useCompactFormat = (camera.ZoomTarget.x < compactFormatStringZoomLevelThreshold);
 			const f32 textHeight = Gui::GetFontSize();
 
-			for (const auto& it : list)
+			// NOTE: JPOSScroll durations are in seconds instead of beats so the ones starting before the visible range can't be skipped as easily (though there typically are only very few of them)
+			const size_t visibleIndexBegin = std::is_same_v<T, JPOSScrollChange> ? 0 : SearchForFirstIndexAtOrAfterBeat(list.Sorted, visibleBeat.Min);
+			const size_t visibleIndexEnd = SearchForFirstIndexAfterBeat(list.Sorted, visibleBeat.Max, visibleIndexBegin);
+
+			for (size_t i = visibleIndexBegin; i < visibleIndexEnd; i++)
 			{
+				const auto& it = list[i];
 				const Time startTime = context.BeatToTime(GetBeat(it));
 				Time endTime = startTime;
 				if constexpr (std::is_same_v<T, JPOSScrollChange>) {
@@ -838,19 +863,20 @@ namespace PeepoDrumKit
 			if (waveform.IsEmpty())
 				continue;
 
-			const auto& waveformMip = waveform.FindClosestMip(waveformTimePerPixel);
-			for (i32 visiblePixel = 0; visiblePixel < scrollbarRect.GetWidth(); /*visiblePixel++*/)
+			for (i32 visiblePixel = 0; visiblePixel < scrollbarRect.GetWidth(); visiblePixel += CustomDraw::WaveformPixelsPerChunk)
 			{
 				CustomDraw::WaveformChunk chunk;
 				const Rect chunkRect = Rect::FromTLSize(timeline.LocalToScreenSpace_ScrollbarX(vec2(static_cast<f32>(visiblePixel), 0.5f)), vec2(static_cast<f32>(CustomDraw::WaveformPixelsPerChunk), scrollbarHeight));
 
+				const Time chunkStartTime = (waveformTimePerPixel * static_cast<f64>(visiblePixel)) - chartSongOffset;
+				waveform.GetPeakAmplitudeRow(chunkStartTime, waveformTimePerPixel, CustomDraw::WaveformPixelsPerChunk, chunk.PerPixelAmplitude);
+
 				for (i32 chunkPixel = 0; chunkPixel < CustomDraw::WaveformPixelsPerChunk; chunkPixel++)
 				{
-					const Time timeAtPixel = (waveformTimePerPixel * static_cast<f64>(visiblePixel)) - chartSongOffset;
+					const Time timeAtPixel = chunkStartTime + (waveformTimePerPixel * static_cast<f64>(chunkPixel));
 					const b8 outOfBounds = (timeAtPixel < Time::Zero() || (timeAtPixel > waveformDuration));
 
-					chunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(waveform.GetAmplitudeAt(waveformMip, timeAtPixel, waveformTimePerPixel), minAmplitude));
-					visiblePixel++;
+					chunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(chunk.PerPixelAmplitude[chunkPixel], minAmplitude));
 				}
 
 				CustomDraw::DrawWaveformChunk(drawList, chunkRect, waveformColor, chunk);
@@ -1408,7 +1434,7 @@ namespace PeepoDrumKit
 		static constexpr auto copyAllSelectedItems = [](const ChartCourse& course) -> std::vector<GenericListStructWithType>
 		{
 			std::vector<GenericListStructWithType> out;
-			size_t selectionCount = 0; ForEachSelectedChartItem(course, [&](const ForEachChartItemData& it) { selectionCount++; });
+			const size_t selectionCount = CountSelectedChartItems(course);
 			if (selectionCount > 0)
 			{
 				out.reserve(selectionCount);
@@ -1524,14 +1550,14 @@ namespace PeepoDrumKit
 		switch (action)
 		{
 		default: { assert(false); } break;
-		case SelectionAction::SelectAll: { ForEachChartItem(course, [&](const ForEachChartItemData& it) { SetIsSelected(true, it, course); }); } break;
-		case SelectionAction::UnselectAll: { ForEachChartItem(course, [&](const ForEachChartItemData& it) { SetIsSelected(false, it, course); }); } break;
-		case SelectionAction::InvertAll: { ForEachChartItem(course, [&](const ForEachChartItemData& it) { SetIsSelected(!GetIsSelected(it, course), it, course); }); } break;
+		case SelectionAction::SelectAll: { ForEachChartItem(course, [&](const ForEachChartItemData& it) { SetIsSelectedWithoutIndexUpdate(true, it, course); }); } break;
+		case SelectionAction::UnselectAll: { ForEachChartItem(course, [&](const ForEachChartItemData& it) { SetIsSelectedWithoutIndexUpdate(false, it, course); }); } break;
+		case SelectionAction::InvertAll: { ForEachChartItem(course, [&](const ForEachChartItemData& it) { SetIsSelectedWithoutIndexUpdate(!GetIsSelected(it, course), it, course); }); } break;
 		case SelectionAction::SelectToEnd:
 			ForEachChartItem(course, [&](const ForEachChartItemData& it)
 			{
 				if (GetBeat(it, course) >= context.GetCursorBeat())
-					SetIsSelected(true, it, course);
+					SetIsSelectedWithoutIndexUpdate(true, it, course);
 			});
 			break;
 		case SelectionAction::SelectAllWithinRangeSelection:
@@ -1545,7 +1571,7 @@ namespace PeepoDrumKit
 					const Beat itStart = GetBeat(it, course);
 					const Beat itEnd = itStart + GetBeatDuration(it, course);
 					if ((itStart <= rangeSelectionMax) && (itEnd >= rangeSelectionMin))
-						SetIsSelected(true, it, course);
+						SetIsSelectedWithoutIndexUpdate(true, it, course);
 				});
 			}
 		} break;
@@ -1556,7 +1582,7 @@ namespace PeepoDrumKit
 				ChartCourse& Course; GenericList List; i32 Index;
 				inline b8 Exists() const { return (Index >= 0); }
 				constexpr b8 IsSelected() const { return GetOrEmpty<GenericMember::B8_IsSelected>(Course, List, Index); }
-				constexpr void IsSelected(b8 isSelected) { TrySet<GenericMember::B8_IsSelected>(Course, List, Index, isSelected); }
+				inline void IsSelected(b8 isSelected) { SetIsSelectedWithoutIndexUpdate(isSelected, ForEachChartItemData { List, static_cast<size_t>(Index) }, Course); }
 				inline static ItemProxy At(ChartCourse& course, GenericList list, i32 listCount, i32 i) { return ItemProxy { course, list, (i >= 0) && (i < listCount) ? i : -1 }; }
 			};
 
@@ -1600,7 +1626,7 @@ namespace PeepoDrumKit
 					if (const ForEachChartItemData it = { list, i }; GetIsSelected(it, course))
 					{
 						if (pattern[patternIndex] != 'x')
-							SetIsSelected(false, it, course);
+							SetIsSelectedWithoutIndexUpdate(false, it, course);
 						if (++patternIndex >= pattern.size())
 							patternIndex = 0;
 					}
@@ -1608,6 +1634,9 @@ namespace PeepoDrumKit
 			}
 		} break;
 		}
+
+		// NOTE: Every action may touch any number of items, so rebuild the selection index once instead of updating it per item
+		course.InvalidateSelectionIndex();
 	}
 
 	static auto GetScaleChartItemRatios(const TransformActionParam& param)
@@ -1873,25 +1902,25 @@ namespace PeepoDrumKit
 		{
 			for (BranchType branch = {}; branch < BranchType::Count; IncrementEnum(branch))
 			{
-				size_t selectedNoteCount = 0;
 				SortedNotesList& notes = context.ChartSelectedCourse->GetNotes(branch);
-				for (const Note& note : notes) { if (note.IsSelected && IsNoteFlippable(note.Type)) selectedNoteCount++; }
-				if (selectedNoteCount <= 0)
-					continue;
+				const std::vector<size_t>& selectedNoteIndices = context.ChartSelectedCourse->GetSelectedIndices(BranchToNotesList(branch));
 
 				std::vector<Commands::ChangeMultipleNoteTypes::Data> noteTypesToChange;
-				noteTypesToChange.reserve(selectedNoteCount);
+				noteTypesToChange.reserve(selectedNoteIndices.size());
 
-				for (Note& note : notes)
+				for (const size_t noteIndex : selectedNoteIndices)
 				{
-					if (note.IsSelected && IsNoteFlippable(note.Type))
+					Note& note = notes[noteIndex];
+					if (IsNoteFlippable(note.Type))
 					{
 						auto& data = noteTypesToChange.emplace_back();
-						data.Index = ArrayItToIndex(&note, &notes[0]);
+						data.Index = noteIndex;
 						data.NewValue = FlipNote(note.Type);
 						note.ClickAnimationTimeRemaining = note.ClickAnimationTimeDuration = NoteHitAnimationDuration;
 					}
 				}
+				if (noteTypesToChange.empty())
+					continue;
 
 				PlaySoundEffectTypeForNoteType(context, noteTypesToChange[0].NewValue);
 				context.Undo.Execute<Commands::ChangeMultipleNoteTypes_FlipTypes>(&course, &notes, std::move(noteTypesToChange));
@@ -1902,24 +1931,21 @@ namespace PeepoDrumKit
 		{
 			for (BranchType branch = {}; branch < BranchType::Count; IncrementEnum(branch))
 			{
-				size_t selectedNoteCount = 0;
 				SortedNotesList& notes = context.ChartSelectedCourse->GetNotes(branch);
-				for (const Note& note : notes) { if (note.IsSelected) selectedNoteCount++; }
-				if (selectedNoteCount <= 0)
+				const std::vector<size_t>& selectedNoteIndices = context.ChartSelectedCourse->GetSelectedIndices(BranchToNotesList(branch));
+				if (selectedNoteIndices.empty())
 					continue;
 
 				std::vector<Commands::ChangeMultipleNoteTypes::Data> noteTypesToChange;
-				noteTypesToChange.reserve(selectedNoteCount);
+				noteTypesToChange.reserve(selectedNoteIndices.size());
 
-				for (Note& note : notes)
+				for (const size_t noteIndex : selectedNoteIndices)
 				{
-					if (note.IsSelected)
-					{
-						auto& data = noteTypesToChange.emplace_back();
-						data.Index = ArrayItToIndex(&note, &notes[0]);
-						data.NewValue = ToggleNoteSize(note.Type);
-						note.ClickAnimationTimeRemaining = note.ClickAnimationTimeDuration = NoteHitAnimationDuration;
-					}
+					Note& note = notes[noteIndex];
+					auto& data = noteTypesToChange.emplace_back();
+					data.Index = noteIndex;
+					data.NewValue = ToggleNoteSize(note.Type);
+					note.ClickAnimationTimeRemaining = note.ClickAnimationTimeDuration = NoteHitAnimationDuration;
 				}
 
 				PlaySoundEffectTypeForNoteType(context, noteTypesToChange[0].NewValue);
@@ -1932,7 +1958,7 @@ namespace PeepoDrumKit
 			assert(param.TimeRatio[1] != 0);
 			if (param.TimeRatio[0] == param.TimeRatio[1])
 				break;
-			size_t selectedItemCount = 0; ForEachSelectedChartItem(course, [&](const ForEachChartItemData& it) { selectedItemCount++; });
+			const size_t selectedItemCount = CountSelectedChartItems(course);
 			if (selectedItemCount <= 0)
 				return;
 
@@ -2339,54 +2365,50 @@ namespace PeepoDrumKit
 						const Rect screenRowRect = Rect(LocalToScreenSpace(vec2(0.0f, rowIt.LocalY)), LocalToScreenSpace(vec2(Regions.Content.GetWidth(), rowIt.LocalY + rowIt.LocalHeight)));
 						const vec2 screenRectCenter = screenRowRect.GetCenter();
 
-						for (size_t i = 0; i < GetGenericListCount(selectedCourse, list); i++)
+						for (const size_t i : selectedCourse.GetSelectedIndices(list))
 						{
-							b8 isSelected {};
-							if (TryGet<GenericMember::B8_IsSelected>(selectedCourse, list, i, isSelected) && isSelected)
-							{
-								Beat beatStart {}, beatDuration {};
-								f32 timeDuration {};
-								const b8 hasBeatStart = TryGet<GenericMember::Beat_Start>(selectedCourse, list, i, beatStart);
-								const b8 hasBeatDuration = TryGet<GenericMember::Beat_Duration>(selectedCourse, list, i, beatDuration);
-								const b8 hasTimeDuration = TryGet<GenericMember::F32_JPOSScrollDuration>(selectedCourse, list, i, timeDuration);
-
-								const vec2 center = vec2(LocalToScreenSpace(vec2(Camera.TimeToLocalSpaceX(context.BeatToTime(beatStart)), 0.0f)).x, screenRectCenter.y);
-								vec2 centerTail = center;
-
-								f32 hitboxSize = TimelineSelectedNoteHitBoxSizeSmall;
-								if (isNotesRow) {
-									NoteType noteType = GetOrEmpty<GenericMember::NoteType_V>(selectedCourse, list, i);
-									hitboxSize = (IsBigNote(noteType) ? TimelineSelectedNoteHitBoxSizeBig : TimelineSelectedNoteHitBoxSizeSmall);
-								}
+							Beat beatStart {}, beatDuration {};
+							f32 timeDuration {};
+							const b8 hasBeatStart = TryGet<GenericMember::Beat_Start>(selectedCourse, list, i, beatStart);
+							const b8 hasBeatDuration = TryGet<GenericMember::Beat_Duration>(selectedCourse, list, i, beatDuration);
+							const b8 hasTimeDuration = TryGet<GenericMember::F32_JPOSScrollDuration>(selectedCourse, list, i, timeDuration);
+
+							const vec2 center = vec2(LocalToScreenSpace(vec2(Camera.TimeToLocalSpaceX(context.BeatToTime(beatStart)), 0.0f)).x, screenRectCenter.y);
+							vec2 centerTail = center;
+
+							f32 hitboxSize = TimelineSelectedNoteHitBoxSizeSmall;
+							if (isNotesRow) {
+								NoteType noteType = GetOrEmpty<GenericMember::NoteType_V>(selectedCourse, list, i);
+								hitboxSize = (IsBigNote(noteType) ? TimelineSelectedNoteHitBoxSizeBig : TimelineSelectedNoteHitBoxSizeSmall);
+							}
 
-								Rect screenHitbox = Rect::FromCenterSize(center, vec2(GuiScale(hitboxSize)));
-								Rect screenHitboxTail = screenHitbox;
-								if (hasBeatDuration && beatDuration > Beat::Zero()) {
-									// TODO: Proper hitboxses (at least for gogo range and lyrics?)
-									centerTail = vec2(LocalToScreenSpace(vec2(Camera.TimeToLocalSpaceX(context.BeatToTime(beatStart + beatDuration)), 0.0f)).x, screenRectCenter.y);
-									screenHitboxTail = Rect::FromCenterSize(centerTail, vec2(GuiScale(hitboxSize)));
-								}
-								else if (hasTimeDuration) {
-									centerTail = vec2(LocalToScreenSpace(vec2(Camera.TimeToLocalSpaceX(context.BeatToTime(beatStart) + Time::FromSec(timeDuration)), 0.0f)).x, screenRectCenter.y);
-									screenHitboxTail = Rect::FromCenterSize(centerTail, vec2(GuiScale(hitboxSize)));
-								}
+							Rect screenHitbox = Rect::FromCenterSize(center, vec2(GuiScale(hitboxSize)));
+							Rect screenHitboxTail = screenHitbox;
+							if (hasBeatDuration && beatDuration > Beat::Zero()) {
+								// TODO: Proper hitboxses (at least for gogo range and lyrics?)
+								centerTail = vec2(LocalToScreenSpace(vec2(Camera.TimeToLocalSpaceX(context.BeatToTime(beatStart + beatDuration)), 0.0f)).x, screenRectCenter.y);
+								screenHitboxTail = Rect::FromCenterSize(centerTail, vec2(GuiScale(hitboxSize)));
+							}
+							else if (hasTimeDuration) {
+								centerTail = vec2(LocalToScreenSpace(vec2(Camera.TimeToLocalSpaceX(context.BeatToTime(beatStart) + Time::FromSec(timeDuration)), 0.0f)).x, screenRectCenter.y);
+								screenHitboxTail = Rect::FromCenterSize(centerTail, vec2(GuiScale(hitboxSize)));
+							}
 
-								for (const auto& [hitbox, target] : {
-									std::make_tuple(screenHitbox, EDragTarget::Body),
-									std::make_tuple(screenHitboxTail, EDragTarget::Tail),
-									}) {
-									if (hitbox.Contains(MousePosThisFrame))
+							for (const auto& [hitbox, target] : {
+								std::make_tuple(screenHitbox, EDragTarget::Body),
+								std::make_tuple(screenHitboxTail, EDragTarget::Tail),
+								}) {
+								if (hitbox.Contains(MousePosThisFrame))
+								{
+									SelectedItemDrag.HoverTarget = target;
+									if (Gui::IsMouseClicked(ImGuiMouseButton_Left))
 									{
-										SelectedItemDrag.HoverTarget = target;
-										if (Gui::IsMouseClicked(ImGuiMouseButton_Left))
-										{
-											SelectedItemDrag.ActiveTarget = target;
-											SelectedItemDrag.BeatOnMouseDown = SelectedItemDrag.MouseBeatThisFrame;
-											SelectedItemDrag.BeatDistanceMovedSoFar = Beat::Zero();
-											context.Undo.DisallowMergeForLastCommand();
-										}
-										break;
+										SelectedItemDrag.ActiveTarget = target;
+										SelectedItemDrag.BeatOnMouseDown = SelectedItemDrag.MouseBeatThisFrame;
+										SelectedItemDrag.BeatDistanceMovedSoFar = Beat::Zero();
+										context.Undo.DisallowMergeForLastCommand();
 									}
+									break;
 								}
 							}
 						}
@@ -3093,9 +3115,10 @@ namespace PeepoDrumKit
 								case BoxSelectionAction::XOR: { isSelected ^= isInsideSelectionBox; } break;
 								}
 
-								TrySet<GenericMember::B8_IsSelected>(*context.ChartSelectedCourse, list, i, isSelected);
+								SetIsSelectedWithoutIndexUpdate(isSelected, ForEachChartItemData { list, i }, *context.ChartSelectedCourse);
 							}
 						});
+						context.ChartSelectedCourse->InvalidateSelectionIndex();
 					}
 				}
 
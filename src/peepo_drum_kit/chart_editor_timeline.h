@@ -343,8 +343,7 @@ namespace PeepoDrumKit
 		static constexpr bool isLongEvent = IsMemberAvailable<TEvent, GenericMember::Beat_Duration>;
 		ChartCourse& course = *context.ChartSelectedCourse;
 
-		size_t nonTargetedEventSelectedItemCount = 0;
-		ForEachSelectedChartItem(course, [&](const ForEachChartItemData& it) { nonTargetedEventSelectedItemCount += (it.List != List); });
+		const size_t nonTargetedEventSelectedItemCount = CountSelectedChartItems(course) - course.GetSelectedIndices(List).size();
 		if (nonTargetedEventSelectedItemCount <= 0)
 			return;
 
@@ -380,6 +379,7 @@ namespace PeepoDrumKit
 							// check overlapping to to-be-inserted event's head
 							if (lastEvent != nullptr && GetBeat(*lastEvent) + GetBeatDuration(*lastEvent) > itBeat) {
 								SetBeatDuration(itBeat - GetBeat(*lastEvent), *lastEvent); // shorten to fit
+								eventList->UpdateOverlapIndexAt(lastEvent - &(*eventList)[0]);
 							}
 						}
 						TEvent event = (lastEvent != nullptr) ? *lastEvent : FallbackEvent<TEvent>;
@@ -406,7 +406,10 @@ namespace PeepoDrumKit
 		if (!eventsThatAlreadyExist.empty() || !eventsToAdd.empty())
 		{
 			if (*Settings.General.ConvertSelectionToScrollChanges_UnselectOld)
-				ForEachSelectedChartItem(course, [&](const ForEachChartItemData& it) { SetIsSelected(false, it, course); });
+			{
+				ForEachSelectedChartItem(course, [&](const ForEachChartItemData& it) { SetIsSelectedWithoutIndexUpdate(false, it, course); });
+				course.InvalidateSelectionIndex();
+			}
 
 			if (*Settings.General.ConvertSelectionToScrollChanges_SelectNew)
 			{
@@ -416,6 +419,7 @@ namespace PeepoDrumKit
 				} else {
 					for (auto* it : eventsThatAlreadyExist) { SetIsSelected(true, *it); }
 					for (auto& it : eventsToAdd) { SetIsSelected(true, it); }
+					course.InvalidateSelectionIndex(List);
 				}
 			}
 
@@ -83,8 +83,40 @@ namespace PeepoDrumKit
 		template <typename TEvent>
 		static void RefreshChart(ChartCourse* Course, ChartCourseListType<TEvent>* Map)
 		{
-			if constexpr (TempoMapMemberPointer<TEvent> != nullptr) { Map->RebuildAccelerationStructure(); Course->RecalculateSENotes(); }
-			else if constexpr (expect_type_v<TEvent, Note>) { Course->RecalculateSENotes(); }
+			Course->InvalidateSelectionIndex();
+			if constexpr (TempoMapMemberPointer<TEvent> != nullptr) { Map->RebuildAccelerationStructure(); Course->RecalculateSENotes(); Course->InvalidateStats(); }
+			else if constexpr (expect_type_v<TEvent, Note>) { Course->RecalculateSENotes(); Course->InvalidateStats(); }
+		}
+
+		// NOTE: Only the notes around the changed ones have to be updated, unless the list isn't one of the note lists of the course
+		static void RefreshNotes(ChartCourse* Course, const SortedNotesList* Notes, NoteBeatRange changedNotes)
+		{
+			for (BranchType branch = BranchType::Normal; branch < BranchType::Count; IncrementEnum(branch))
+			{
+				if (&Course->GetNotes(branch) == Notes)
+				{
+					Course->InvalidateStats(branch);
+					return Course->RecalculateSENotes(branch, changedNotes);
+				}
+			}
+			Course->RecalculateSENotes();
+			Course->InvalidateStats();
+		}
+
+		template <typename TEvent>
+		static void RefreshChart(ChartCourse* Course, ChartCourseListType<TEvent>* Map, NoteBeatRange changedEvents)
+		{
+			if constexpr (expect_type_v<TEvent, Note>) { Course->InvalidateSelectionIndex(); RefreshNotes(Course, Map, changedEvents); }
+			else { RefreshChart<TEvent>(Course, Map); }
+		}
+
+		template <typename TEvents>
+		static NoteBeatRange GetEventsBeatRange(const TEvents& events)
+		{
+			NoteBeatRange range {};
+			for (const auto& event : events)
+				range.Add(GetBeat(event));
+			return range;
 		}
 
 		template <typename TEvent>
@@ -100,12 +132,12 @@ namespace PeepoDrumKit
 					GetEventList<EventList>(*Map).InsertOrUpdate(ReplacedValue.value());
 				else
 					GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(NewValue));
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, NoteBeatRange::FromBeat(GetBeat(NewValue)));
 			}
 			void Redo() override
 			{
 				GetEventList<EventList>(*Map).InsertOrFunc(NewValue, [&](TEvent& v, ...) { ReplacedValue = std::move(v); v = NewValue; }); // safe replace
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, NoteBeatRange::FromBeat(GetBeat(NewValue)));
 			}
 
 			Undo::MergeResult TryMerge(Command& commandToMerge) override { return Undo::MergeResult::Failed; }
@@ -136,18 +168,18 @@ namespace PeepoDrumKit
 					GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(event));
 				for (const auto& event : ReplacedEvents)
 					GetEventList<EventList>(*Map).InsertOrUpdate(event);
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, GetEventsBeatRange(NewEvents));
 			}
 			void Redo() override
 			{
 				ReplacedEvents.clear();
-				for (const auto& event : NewEvents)
-					GetEventList<EventList>(*Map).InsertOrFunc(event, [&](TEvent& v, ...) { ReplacedEvents.push_back(std::move(v)); v = event; }); // safe replace
-				RefreshChart<TEvent>(Course, Map);
+				GetEventList<EventList>(*Map).InsertManyOrFunc(NewEvents.data(), NewEvents.size(), [&](TEvent& v, const TEvent& event) { ReplacedEvents.push_back(std::move(v)); v = event; }); // safe replace
+				RefreshChart<TEvent>(Course, Map, GetEventsBeatRange(NewEvents));
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
 			Undo::CommandInfo GetInfo() const override { return { ConstevalStrJoined<ActionPrefixAdd, DisplayNameOfChartEvents<TEvent>> }; }
+			size_t GetMemoryUsage() const override { return sizeof(*this) + Undo::GetVectorMemoryUsage(NewEvents.Sorted) + Undo::GetVectorMemoryUsage(ReplacedEvents); }
 
 			ChartCourse* Course;
 			ChartCourseListType* Map;
@@ -165,8 +197,8 @@ namespace PeepoDrumKit
 			RemoveSingleChartEventBase(ChartCourse* course, ChartCourseListType* map, TEvent oldValue) : Course(course), Map(map), OldValue(oldValue) { }
 			RemoveSingleChartEventBase(ChartCourse* course, ChartCourseListType* map, Beat beat) : Course(course), Map(map), OldValue(*GetEventList<EventList>(*Map).TryFindExactAtBeat(beat)) { assert(GetBeat(OldValue) == beat); }
 
-			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map); }
-			void Redo() override { GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(OldValue)); RefreshChart<TEvent>(Course, Map); }
+			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map, NoteBeatRange::FromBeat(GetBeat(OldValue))); }
+			void Redo() override { GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(OldValue)); RefreshChart<TEvent>(Course, Map, NoteBeatRange::FromBeat(GetBeat(OldValue))); }
 
 			Undo::MergeResult TryMerge(Command& commandToMerge) override { return Undo::MergeResult::Failed; }
 			Undo::CommandInfo GetInfo() const override { return { ConstevalStrJoined<ActionPrefixRemove, DisplayNameOfChartEvent<TEvent>> }; }
@@ -189,16 +221,17 @@ namespace PeepoDrumKit
 			{
 				for (const auto& event : OldValues)
 					GetEventList<EventList>(*Map).InsertOrUpdate(event);
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, GetEventsBeatRange(OldValues));
 			}
 			void Redo() override
 			{
 				for (const TEvent& event : OldValues) GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(event));
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, GetEventsBeatRange(OldValues));
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
 			Undo::CommandInfo GetInfo() const override { return { ConstevalStrJoined<ActionPrefixRemove, DisplayNameOfChartEvents<TEvent>> }; }
+			size_t GetMemoryUsage() const override { return sizeof(*this) + Undo::GetVectorMemoryUsage(OldValues); }
 
 			ChartCourse* Course;
 			ChartCourseListType* Map;
@@ -218,17 +251,18 @@ namespace PeepoDrumKit
 			{
 				GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(NewValue));
 				EventsToRemove.Undo();
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, NoteBeatRange::FromBeat(GetBeat(NewValue)));
 			}
 			void Redo() override
 			{
 				EventsToRemove.Redo();
 				GetEventList<EventList>(*Map).InsertOrFunc(NewValue, [&](TEvent& v, ...) { EventsToRemove.OldValues.push_back(std::move(v)); v = NewValue; }); // safe replace
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, NoteBeatRange::FromBeat(GetBeat(NewValue)));
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
 			Undo::CommandInfo GetInfo() const override { return { ConstevalStrJoined<ActionPrefixAdd, DisplayNameOfLongChartEvent<TEvent>> }; }
+			size_t GetMemoryUsage() const override { return sizeof(*this) + Undo::GetVectorMemoryUsage(EventsToRemove.OldValues); }
 
 			ChartCourse* Course;
 			ChartCourseListType* Map;
@@ -245,8 +279,8 @@ namespace PeepoDrumKit
 			constexpr static auto EventList = TempoMapMemberPointer<TEvent>;
 			UpdateSingleChartEventBase(ChartCourse* course, ChartCourseListType* map, TEvent newValue) : Course(course), Map(map), NewValue(newValue), OldValue(*GetEventList<EventList>(*Map).TryFindExactAtBeat(GetBeat(newValue))) { assert(GetBeat(newValue) == GetBeat(OldValue)); }
 
-			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map); }
-			void Redo() override { GetEventList<EventList>(*Map).InsertOrUpdate(NewValue); RefreshChart<TEvent>(Course, Map); }
+			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map, NoteBeatRange::FromBeat(GetBeat(OldValue))); }
+			void Redo() override { GetEventList<EventList>(*Map).InsertOrUpdate(NewValue); RefreshChart<TEvent>(Course, Map, NoteBeatRange::FromBeat(GetBeat(NewValue))); }
 
 			Undo::MergeResult TryMerge(Command& commandToMerge) override
 			{
@@ -267,16 +301,135 @@ namespace PeepoDrumKit
 		template <typename TEvent>
 		struct UpdateSingleChartEvent : UpdateSingleChartEventBase<TEvent> { using UpdateSingleChartEventBase<TEvent>::UpdateSingleChartEventBase; };
 
+		template <typename TEvent>
+		constexpr b8 ChartEventsAreEqual(const TEvent& a, const TEvent& b)
+		{
+			if constexpr (expect_type_v<TEvent, LyricChange>)
+				return (a.BeatTime == b.BeatTime) && (a.Lyric == b.Lyric) && (a.IsSelected == b.IsSelected);
+			else // NOTE: Transient animation state is compared as well, which at worst only results in a few extra (redundant) modified items
+				return (memcmp(&a, &b, sizeof(TEvent)) == 0);
+		}
+
+		// NOTE: Only the ranges that differ between two lists sorted by (unique) beats, so that replacing a whole list doesn't have to keep around two full copies of it.
+		//		 Each hunk replaces a run of removed items starting at OldIndex with a run of inserted items starting at NewIndex (a modified item is simply removed and inserted again)
+		template <typename TEvent>
+		struct BeatSortedListDiff
+		{
+			struct Hunk
+			{
+				size_t OldIndex, NewIndex;
+				std::vector<TEvent> Removed, Inserted;
+			};
+			std::vector<Hunk> Hunks;
+
+		public:
+			static BeatSortedListDiff Create(const std::vector<TEvent>& oldList, const std::vector<TEvent>& newList)
+			{
+				static_assert(std::is_trivially_copyable_v<TEvent> || expect_type_v<TEvent, LyricChange>, "Unhandled non-trivial type in ChartEventsAreEqual()");
+
+				BeatSortedListDiff diff {};
+				Hunk* currentHunk = nullptr;
+				auto getHunk = [&](size_t oldIndex, size_t newIndex) -> Hunk& {
+					if (currentHunk == nullptr)
+						currentHunk = &diff.Hunks.emplace_back(Hunk { oldIndex, newIndex });
+					return *currentHunk;
+				};
+
+				size_t oldIndex = 0, newIndex = 0;
+				while (oldIndex < oldList.size() || newIndex < newList.size())
+				{
+					const b8 hasOld = (oldIndex < oldList.size()), hasNew = (newIndex < newList.size());
+					if (hasOld && hasNew && GetBeat(oldList[oldIndex]) == GetBeat(newList[newIndex]))
+					{
+						if (ChartEventsAreEqual(oldList[oldIndex], newList[newIndex])) { currentHunk = nullptr; oldIndex++; newIndex++; continue; }
+						Hunk& hunk = getHunk(oldIndex, newIndex);
+						hunk.Removed.push_back(oldList[oldIndex++]);
+						hunk.Inserted.push_back(newList[newIndex++]);
+					}
+					else if (hasOld && (!hasNew || GetBeat(oldList[oldIndex]) < GetBeat(newList[newIndex])))
+					{
+						getHunk(oldIndex, newIndex).Removed.push_back(oldList[oldIndex++]);
+					}
+					else
+					{
+						getHunk(oldIndex, newIndex).Inserted.push_back(newList[newIndex++]);
+					}
+				}
+				return diff;
+			}
+
+			// NOTE: Forward turns the old list into the new one and backward the new list into the old one
+			std::vector<TEvent> Apply(const std::vector<TEvent>& inList, b8 forward) const
+			{
+				std::vector<TEvent> outList;
+				outList.reserve(inList.size() + GetSizeChange(forward));
+
+				size_t inIndex = 0;
+				for (const Hunk& hunk : Hunks)
+				{
+					const size_t hunkInIndex = forward ? hunk.OldIndex : hunk.NewIndex;
+					const auto& itemsToSkip = forward ? hunk.Removed : hunk.Inserted;
+					const auto& itemsToAdd = forward ? hunk.Inserted : hunk.Removed;
+					assert(hunkInIndex >= inIndex && hunkInIndex + itemsToSkip.size() <= inList.size());
+
+					outList.insert(outList.end(), inList.begin() + inIndex, inList.begin() + hunkInIndex);
+					outList.insert(outList.end(), itemsToAdd.begin(), itemsToAdd.end());
+					inIndex = hunkInIndex + itemsToSkip.size();
+				}
+				outList.insert(outList.end(), inList.begin() + inIndex, inList.end());
+				return outList;
+			}
+
+			NoteBeatRange GetBeatRange() const
+			{
+				NoteBeatRange range {};
+				for (const Hunk& hunk : Hunks)
+				{
+					if (!hunk.Removed.empty()) { range.Add(GetBeat(hunk.Removed.front())); range.Add(GetBeat(hunk.Removed.back())); }
+					if (!hunk.Inserted.empty()) { range.Add(GetBeat(hunk.Inserted.front())); range.Add(GetBeat(hunk.Inserted.back())); }
+				}
+				return range;
+			}
+
+			size_t GetMemoryUsage() const
+			{
+				size_t memoryUsage = Undo::GetVectorMemoryUsage(Hunks);
+				for (const Hunk& hunk : Hunks)
+					memoryUsage += Undo::GetVectorMemoryUsage(hunk.Removed) + Undo::GetVectorMemoryUsage(hunk.Inserted);
+				return memoryUsage;
+			}
+
+		private:
+			size_t GetSizeChange(b8 forward) const
+			{
+				size_t sizeChange = 0;
+				for (const Hunk& hunk : Hunks)
+				{
+					if (forward && hunk.Inserted.size() > hunk.Removed.size()) sizeChange += (hunk.Inserted.size() - hunk.Removed.size());
+					if (!forward && hunk.Removed.size() > hunk.Inserted.size()) sizeChange += (hunk.Removed.size() - hunk.Inserted.size());
+				}
+				return sizeChange;
+			}
+		};
+
 		template <typename TEvent>
 		struct ReplaceAllChartEventsBase : Undo::Command
 		{
 			using ChartCourseListType = ChartCourseListType<TEvent>;
 			using SortedEventsList = BeatSortedList<TEvent>;
 			constexpr static auto EventList = TempoMapMemberPointer<TEvent>;
-			ReplaceAllChartEventsBase(ChartCourse* course, ChartCourseListType* map, SortedEventsList newValues) : Course(course), Map(map), NewValues(std::move(newValues)), OldValues(GetEventList<EventList>(*map)) { }
+			ReplaceAllChartEventsBase(ChartCourse* course, ChartCourseListType* map, SortedEventsList newValues) : Course(course), Map(map), Diff(BeatSortedListDiff<TEvent>::Create(GetEventList<EventList>(*map).Sorted, newValues.Sorted)) { }
 
-			void Undo() override { GetEventList<EventList>(*Map) = OldValues; RefreshChart<TEvent>(Course, Map); }
-			void Redo() override { GetEventList<EventList>(*Map) = NewValues; RefreshChart<TEvent>(Course, Map); }
+			void Undo() override { ApplyAndRefresh(false); }
+			void Redo() override { ApplyAndRefresh(true); }
+
+			void ApplyAndRefresh(b8 forward)
+			{
+				auto& list = GetEventList<EventList>(*Map);
+				list.Sorted = Diff.Apply(list.Sorted, forward);
+				list.InvalidateOverlapIndex();
+				RefreshChart<TEvent>(Course, Map, Diff.GetBeatRange());
+			}
 
 			Undo::MergeResult TryMerge(Command& commandToMerge) override
 			{
@@ -284,15 +437,22 @@ namespace PeepoDrumKit
 				if (other->Map != Map)
 					return Undo::MergeResult::Failed;
 
-				NewValues = other->NewValues;
+				// NOTE: The other diff is relative to the current state while this one is relative to the state before this command,
+				//		 so the list is reverted here to have the following Redo() apply the combined diff on top of the original state
+				auto& list = GetEventList<EventList>(*Map);
+				std::vector<TEvent> oldValues = Diff.Apply(list.Sorted, false);
+				Diff = BeatSortedListDiff<TEvent>::Create(oldValues, other->Diff.Apply(list.Sorted, true));
+				list.Sorted = std::move(oldValues);
+				list.InvalidateOverlapIndex();
 				return Undo::MergeResult::ValueUpdated;
 			}
 
 			Undo::CommandInfo GetInfo() const override { return { ConstevalStrJoined<ActionPrefixUpdateAll, DisplayNameOfChartEvents<TEvent>> }; }
+			size_t GetMemoryUsage() const override { return sizeof(*this) + Diff.GetMemoryUsage(); }
 
 			ChartCourse* Course;
 			ChartCourseListType* Map;
-			SortedEventsList NewValues, OldValues;
+			BeatSortedListDiff<TEvent> Diff;
 		};
 		template <typename TEvent>
 		struct ReplaceAllChartEvents : ReplaceAllChartEventsBase<TEvent> { using ReplaceAllChartEventsBase<TEvent>::ReplaceAllChartEventsBase; };
@@ -349,7 +509,7 @@ namespace PeepoDrumKit
 		};
 		using UpdateBarLineChange = UpdateSingleChartEvent<BarLineChange>;
 
-		// NOTE: Creating a full copy of the new/old state for now because it's easy and there typically are only a very few number of GoGoRanges
+		// NOTE: Not merged because each added GoGoRange should be undoable on its own
 		template <>
 		struct ReplaceAllChartEvents<GoGoRange> : ReplaceAllChartEventsBase<GoGoRange>
 		{
@@ -406,8 +566,17 @@ namespace PeepoDrumKit
 
 			ChangeSingleNoteAttributeBase(ChartCourse* course, SortedNotesList* notes, Data newData) : Course(course), Notes(notes), NewData(std::move(newData)) { NewData.OldValue = (*Notes)[NewData.Index].*Attr; }
 
-			void Undo() override { (*Notes)[NewData.Index].*Attr = NewData.OldValue; RefreshChart<Note>(Course, nullptr); }
-			void Redo() override { (*Notes)[NewData.Index].*Attr = NewData.NewValue; RefreshChart<Note>(Course, nullptr); }
+			void Undo() override { SetAndRefresh(NewData.OldValue); }
+			void Redo() override { SetAndRefresh(NewData.NewValue); }
+
+			void SetAndRefresh(const TAttr& value)
+			{
+				NoteBeatRange changedNotes = NoteBeatRange::FromBeat((*Notes)[NewData.Index].BeatTime);
+				(*Notes)[NewData.Index].*Attr = value;
+				changedNotes.Add((*Notes)[NewData.Index].BeatTime);
+				Notes->UpdateOverlapIndexAt(NewData.Index);
+				RefreshNotes(Course, Notes, changedNotes);
+			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override
 			{
@@ -447,16 +616,25 @@ namespace PeepoDrumKit
 
 			void Undo() override
 			{
-				for (const auto& newData : NewData)
-					(*Notes)[newData.Index].*Attr = newData.OldValue;
-				RefreshChart<Note>(Course, nullptr);
+				SetAllAndRefresh(&Data::OldValue);
 			}
 
 			void Redo() override
 			{
+				SetAllAndRefresh(&Data::NewValue);
+			}
+
+			void SetAllAndRefresh(TAttr Data::* value)
+			{
+				NoteBeatRange changedNotes {};
 				for (const auto& newData : NewData)
-					(*Notes)[newData.Index].*Attr = newData.NewValue;
-				RefreshChart<Note>(Course, nullptr);
+				{
+					changedNotes.Add((*Notes)[newData.Index].BeatTime);
+					(*Notes)[newData.Index].*Attr = newData.*value;
+					changedNotes.Add((*Notes)[newData.Index].BeatTime);
+					Notes->UpdateOverlapIndexAt(newData.Index);
+				}
+				RefreshNotes(Course, Notes, changedNotes);
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override
@@ -481,6 +659,7 @@ namespace PeepoDrumKit
 			}
 
 			Undo::CommandInfo GetInfo() const override { return { "Change Note Attributes" }; }
+			size_t GetMemoryUsage() const override { return sizeof(*this) + Undo::GetVectorMemoryUsage(NewData); }
 
 			ChartCourse* Course;
 			SortedNotesList* Notes;
@@ -560,85 +739,90 @@ namespace PeepoDrumKit
 					if (data.List == GenericList::TempoChanges)
 						UpdateTempoMap = true;
 					else if (IsNotesList(data.List))
-						UpdateNotes = true;
+						ChangedNotes[EnumToIndex(NotesListToBranch(data.List))].Add(GetBeat(data));
 				}
 			}
 
 			void Undo() override
 			{
-				for (const auto& list : NewData) {
-					for (const auto& data : list)
-						TryRemoveGenericStruct(*Course, data.List, data.Value);
-				}
-				for (const auto& data : ReplacedData)
-					TryAddOrReplaceGenericStruct(*Course, data.List, data.Value);
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
+				for (GenericList list = {}; list < GenericList::Count; IncrementEnum(list))
+					TryRemoveManyGenericStructs(*Course, list, NewData[EnumToIndex(list)].data(), NewData[EnumToIndex(list)].size());
+				ForEachGenericListRun(ReplacedData, [&](GenericList list, const GenericListStructWithType* values, size_t valueCount) { TryAddOrReplaceManyGenericStructs(*Course, list, values, valueCount); });
+				Course->InvalidateSelectionIndex();
+				Course->DeferRefresh(UpdateTempoMap, ChangedNotes);
 			}
 
 			void Redo() override
 			{
+				// NOTE: Replaced items are appended in list and beat order, the same order they can then be added back in again by Undo()
 				ReplacedData.clear();
-				for (const auto& list : NewData) {
-					for (const auto& data : list)
-						TryAddOrFuncGenericStruct(*Course, data.List, data.Value, [&](auto& v, auto&& vNew) { ReplacedData.emplace_back(data.List, std::move(v)); v = vNew; }); // safe replace
+				for (GenericList list = {}; list < GenericList::Count; IncrementEnum(list))
+				{
+					TryAddManyOrFuncGenericStructs(*Course, list, NewData[EnumToIndex(list)].data(), NewData[EnumToIndex(list)].size(),
+						[&](auto& v, auto&& vNew) { ReplacedData.emplace_back(list, std::move(v)); v = vNew; }); // safe replace
 				}
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
+				Course->InvalidateSelectionIndex();
+				Course->DeferRefresh(UpdateTempoMap, ChangedNotes);
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
 			Undo::CommandInfo GetInfo() const override { return { "Add Items" }; }
+			size_t GetMemoryUsage() const override
+			{
+				size_t memoryUsage = sizeof(*this) + Undo::GetVectorMemoryUsage(ReplacedData);
+				for (const auto& list : NewData)
+					memoryUsage += Undo::GetVectorMemoryUsage(list.Sorted);
+				return memoryUsage;
+			}
 
 			ChartCourse* Course;
 			BeatSortedList<GenericListStructWithType> NewData[EnumCount<GenericList>];
 			std::vector<GenericListStructWithType> ReplacedData;
-			b8 UpdateTempoMap, UpdateNotes;
+			b8 UpdateTempoMap;
+			NoteBeatRange ChangedNotes[EnumCount<BranchType>] {};
 		};
 
 		struct RemoveMultipleGenericItems : Undo::Command
 		{
 			RemoveMultipleGenericItems(ChartCourse* course, std::vector<GenericListStructWithType> oldData) : Course(course), OldData(std::move(oldData)), UpdateTempoMap(false)
 			{
+				// NOTE: Grouped by list and sorted by beat to be removed / added back in again one list at a time
+				std::stable_sort(OldData.begin(), OldData.end(), [](const GenericListStructWithType& a, const GenericListStructWithType& b)
+				{
+					return (a.List != b.List) ? (a.List < b.List) : (GetBeat(a) < GetBeat(b));
+				});
+
 				for (const auto& data : OldData)
 				{
 					if (data.List == GenericList::TempoChanges)
 						UpdateTempoMap = true;
 					else if (IsNotesList(data.List))
-						UpdateNotes = true;
+						ChangedNotes[EnumToIndex(NotesListToBranch(data.List))].Add(GetBeat(data));
 				}
 			}
 
 			void Undo() override
 			{
-				for (const auto& data : OldData)
-					TryAddOrReplaceGenericStruct(*Course, data.List, data.Value);
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
+				ForEachGenericListRun(OldData, [&](GenericList list, const GenericListStructWithType* values, size_t valueCount) { TryAddOrReplaceManyGenericStructs(*Course, list, values, valueCount); });
+				Course->InvalidateSelectionIndex();
+				Course->DeferRefresh(UpdateTempoMap, ChangedNotes);
 			}
 
 			void Redo() override
 			{
-				for (const auto& data : OldData)
-					TryRemoveGenericStruct(*Course, data.List, data.Value);
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
+				ForEachGenericListRun(OldData, [&](GenericList list, const GenericListStructWithType* values, size_t valueCount) { TryRemoveManyGenericStructs(*Course, list, values, valueCount); });
+				Course->InvalidateSelectionIndex();
+				Course->DeferRefresh(UpdateTempoMap, ChangedNotes);
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
 			Undo::CommandInfo GetInfo() const override { return { "Remove Items" }; }
+			size_t GetMemoryUsage() const override { return sizeof(*this) + Undo::GetVectorMemoryUsage(OldData); }
 
 			ChartCourse* Course;
 			std::vector<GenericListStructWithType> OldData;
-			b8 UpdateTempoMap, UpdateNotes;
+			b8 UpdateTempoMap;
+			NoteBeatRange ChangedNotes[EnumCount<BranchType>] {};
 		};
 
 		struct AddMultipleGenericItems_Paste : AddMultipleGenericItems
@@ -684,29 +868,27 @@ namespace PeepoDrumKit
 					assert(success);
 					if (data.List == GenericList::TempoChanges)
 						UpdateTempoMap = true;
-					else if (IsNotesList(data.List))
-						UpdateNotes = true;
 				}
 			}
 
-			void Undo() override
-			{
-				for (const auto& newData : NewData)
-					TrySet(*Course, newData.List, newData.Index, newData.Member, newData.OldValue);
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
-			}
+			void Undo() override { SetAllAndRefresh(&Data::OldValue); }
+			void Redo() override { SetAllAndRefresh(&Data::NewValue); }
 
-			void Redo() override
+			void SetAllAndRefresh(GenericMemberUnion Data::* value)
 			{
+				NoteBeatRange changedNotes[EnumCount<BranchType>] {};
 				for (const auto& newData : NewData)
-					TrySet(*Course, newData.List, newData.Index, newData.Member, newData.NewValue);
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
+				{
+					const b8 isNotesList = IsNotesList(newData.List);
+					const SortedNotesList* notes = isNotesList ? &Course->GetNotes(NotesListToBranch(newData.List)) : nullptr;
+					NoteBeatRange* changedBranchNotes = isNotesList ? &changedNotes[EnumToIndex(NotesListToBranch(newData.List))] : nullptr;
+
+					if (isNotesList) changedBranchNotes->Add((*notes)[newData.Index].BeatTime);
+					TrySet(*Course, newData.List, newData.Index, newData.Member, newData.*value);
+					if (newData.Member == GenericMember::B8_IsSelected) Course->InvalidateSelectionIndex(newData.List);
+					if (isNotesList) changedBranchNotes->Add((*notes)[newData.Index].BeatTime);
+				}
+				Course->DeferRefresh(UpdateTempoMap, changedNotes);
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override
@@ -733,10 +915,11 @@ namespace PeepoDrumKit
 			}
 
 			Undo::CommandInfo GetInfo() const override { return { "Change Properties" }; }
+			size_t GetMemoryUsage() const override { return sizeof(*this) + Undo::GetVectorMemoryUsage(NewData); }
 
 			ChartCourse* Course;
 			std::vector<Data> NewData;
-			b8 UpdateTempoMap, UpdateNotes;
+			b8 UpdateTempoMap;
 		};
 
 		struct ChangeMultipleGenericProperties_MoveItems : ChangeMultipleGenericProperties
@@ -763,6 +946,7 @@ namespace PeepoDrumKit
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
 			Undo::CommandInfo GetInfo() const override { return { "Remove and Add Items" }; }
+			size_t GetMemoryUsage() const override { return sizeof(*this) + (RemoveCommand.GetMemoryUsage() - sizeof(RemoveCommand)) + (AddCommand.GetMemoryUsage() - sizeof(AddCommand)); }
 
 			RemoveMultipleGenericItems RemoveCommand;
 			AddMultipleGenericItems AddCommand;
@@ -660,14 +660,14 @@ namespace PeepoDrumKit
 
 			// Details
 			{
-				SortedNotesList& notes = context.ChartSelectedCourse->GetNotes(context.ChartSelectedBranch);
+				const ChartCourseStats& stats = course.GetStats(context.ChartSelectedBranch);
 
-				int _donCount = notes.CountIf([](Note N) {return IsDonNote(N.Type);});
-				int _kaCount = notes.CountIf([](Note N) {return IsKaNote(N.Type);});
-				int _kaDonCount = notes.CountIf([](Note N) {return IsKaDonNote(N.Type);});
-				int _adLibCount = notes.CountIf([](Note N) {return IsAdlibNote(N.Type);});
-				int _bombCount = notes.CountIf([](Note N) {return IsBombNote(N.Type);});
-				int _maxCombo = _donCount + _kaCount + _kaDonCount;
+				int _donCount = stats.DonCount;
+				int _kaCount = stats.KaCount;
+				int _kaDonCount = stats.KaDonCount;
+				int _adLibCount = stats.AdlibCount;
+				int _bombCount = stats.BombCount;
+				int _maxCombo = stats.MaxCombo;
 
 				f64 _density = _maxCombo / chart.ChartDuration.Seconds;
 
@@ -702,9 +702,28 @@ namespace PeepoDrumKit
 				Gui::PushStyleColor(ImGuiCol_Text, IM_COL32(122, 122, 122, 255));
 				Gui::Text("Bomb: %d", _bombCount);
 				Gui::PopStyleColor();
-				
+
+				Gui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 200, 80, 255));
+				Gui::Text("Drumroll: %d (%.2fs)", stats.DrumrollCount, stats.DrumrollDuration.ToSec());
+				Gui::Text("Balloon: %d (%d hits)", stats.BalloonCount, stats.BalloonPopCount);
+				Gui::PopStyleColor();
+
 				Gui::PopFont();
 
+				if (!stats.HitsPerSecond.empty())
+				{
+					Gui::PushFont(FontMain, GuiScaleI32_AtTarget(FontBaseSizes::Small));
+					Gui::PushStyleColor(ImGuiCol_Text, colors.RedBright);
+					Gui::Text("Peak Density: %d hit/s at %s", stats.PeakHitsPerSecond, stats.PeakHitsPerSecondTime.ToString().Data);
+					Gui::PopStyleColor();
+
+					char overlayText[32];
+					sprintf_s(overlayText, "%s - %s", stats.FirstHitTime.ToString().Data, stats.LastHitTime.ToString().Data);
+					Gui::PlotHistogram("##HitsPerSecond", stats.HitsPerSecond.data(), static_cast<i32>(stats.HitsPerSecond.size()), 0, overlayText,
+						0.0f, static_cast<f32>(stats.PeakHitsPerSecond), vec2(Gui::GetContentRegionAvail().x, GuiScale(64.0f)));
+					Gui::PopFont();
+				}
+
 			}
 
 
@@ -874,6 +893,20 @@ namespace PeepoDrumKit
 		Gui::PushStyleColor(ImGuiCol_HeaderHovered, Gui::GetColorU32(ImGuiCol_HeaderHovered, 0.5f));
 		defer { Gui::PopStyleColor(2); Gui::PopStyleVar(2); };
 
+		{
+			const f64 memoryUsageMB = static_cast<f64>(context.Undo.MemoryUsage) / (1024.0 * 1024.0);
+			const f64 memoryBudgetMB = static_cast<f64>(context.Undo.MemoryBudget) / (1024.0 * 1024.0);
+			if (context.Undo.MemoryBudget > 0)
+				Gui::TextDisabled("%s: %.2f / %.0f MB", UI_Str("UNDO_HISTORY_MEMORY_USAGE"), memoryUsageMB, memoryBudgetMB);
+			else
+				Gui::TextDisabled("%s: %.2f MB", UI_Str("UNDO_HISTORY_MEMORY_USAGE"), memoryUsageMB);
+			if (context.Undo.NumberOfDroppedCommands > 0)
+			{
+				Gui::SameLine();
+				Gui::TextDisabled("(%s: %d)", UI_Str("UNDO_HISTORY_DROPPED_COMMANDS"), context.Undo.NumberOfDroppedCommands);
+			}
+		}
+
 		if (Gui::BeginTable("UndoHistoryTable", 2, ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY, Gui::GetContentRegionAvail()))
 		{
 			Gui::PushFont(FontMain, GuiScaleI32_AtTarget(FontBaseSizes::Medium));
@@ -1197,8 +1230,9 @@ namespace PeepoDrumKit
 									for (const auto& selectedItem : SelectedItems)
 									{
 										if (selectedItem.List != list)
-											TrySet<GenericMember::B8_IsSelected>(course, selectedItem.List, selectedItem.Index, false);
+											SetIsSelectedWithoutIndexUpdate(false, ForEachChartItemData { selectedItem.List, selectedItem.Index }, course);
 									}
+									course.InvalidateSelectionIndex();
 								}
 								Gui::PopStyleColor(3);
 								Gui::PopStyleVar(1);
@@ -163,12 +163,12 @@ namespace PeepoDrumKit
 
 			f32 x = 0;
 			f32 y = 0;
-			Time jposTimeStamp = accelerationStructure.ConvertBeatToTimeUsingLookupTableIndexing(jposScrollChanges[0].BeatTime);
+			Time jposTimeStamp = accelerationStructure.ConvertBeatToTime(jposScrollChanges[0].BeatTime);
 			Time nextJposTimeStamp;
 			for (size_t i = 0; i < jposScrollChanges.size() && timeStamp >= jposTimeStamp; i++) {
 				JPOSScrollChange jposChange = jposScrollChanges[i];
 				nextJposTimeStamp = !(i + 1 < jposScrollChanges.size()) ? Time::FromSec(F32Max)
-					: accelerationStructure.ConvertBeatToTimeUsingLookupTableIndexing(jposScrollChanges[i + 1].BeatTime);
+					: accelerationStructure.ConvertBeatToTime(jposScrollChanges[i + 1].BeatTime);
 
 				Complex jposMove = jposChange.Move;
 				Time jposDuration = Time::FromSec(jposChange.Duration);
@@ -235,7 +235,7 @@ namespace PeepoDrumKit
 				case (ScrollMethod::HBSCROLL):
 				case (ScrollMethod::BMSCROLL):
 				{
-					f64 noteHBScrollBeatTick = accelerationStructure.ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(noteBeat, noteTime);
+					f64 noteHBScrollBeatTick = accelerationStructure.ConvertBeatAndTimeToHBScrollBeatTick(noteBeat, noteTime);
 					return scrollSpeed * ((noteHBScrollBeatTick - cursorHBScrollBeatTick) / Beat::TicksPerBeat) * GameWorldSpaceDistancePerLaneBeat;
 				}
 				case (ScrollMethod::NMSCROLL):
@@ -405,21 +405,35 @@ namespace PeepoDrumKit
 		} Tail;
 	};
 
+	// NOTE: Seeks to the last item at or before the beat so that a forward iterator can start anywhere within the list
+	template <typename T>
+	static BeatSortedForwardIterator<T> BeatSortedForwardIteratorAt(const std::vector<T>& sortedList, Beat beat)
+	{
+		const size_t indexAfter = SearchForFirstIndexAfterBeat(sortedList, beat);
+		return BeatSortedForwardIterator<T> { (indexAfter > 0) ? (indexAfter - 1) : 0 };
+	}
+
+	// NOTE: Starting at firstNoteIndex and stopping as soon as perNoteFunc returns ControlFlow::Break
 	template <typename Func>
-	static void ForEachNoteOnNoteLane(const ChartCourse& course, BranchType branch, Func perNoteFunc)
+	static void ForEachNoteOnNoteLaneFrom(const ChartCourse& course, BranchType branch, size_t firstNoteIndex, Func perNoteFunc)
 	{
-		BeatSortedForwardIterator<TempoChange> tempoChangeIt {};
-		BeatSortedForwardIterator<ScrollChange> scrollChangeIt {};
-		BeatSortedForwardIterator<ScrollType> scrollTypeIt {};
-		BeatSortedForwardIterator<JPOSScrollChange> JPOSscrollChangeIt {};
+		const SortedNotesList& notes = course.GetNotes(branch);
+		if (firstNoteIndex >= notes.size())
+			return;
 
-		for (const Note& note : course.GetNotes(branch))
+		const Beat firstBeat = notes[firstNoteIndex].BeatTime;
+		auto tempoChangeIt = BeatSortedForwardIteratorAt(course.TempoMap.Tempo.Sorted, firstBeat);
+		auto scrollChangeIt = BeatSortedForwardIteratorAt(course.ScrollChanges.Sorted, firstBeat);
+		auto scrollTypeIt = BeatSortedForwardIteratorAt(course.ScrollTypes.Sorted, firstBeat);
+
+		for (size_t i = firstNoteIndex; i < notes.size(); i++)
 		{
+			const Note& note = notes[i];
 			const Beat beat = note.BeatTime;
 			const Time head = (course.TempoMap.BeatToTime(beat) + note.TimeOffset);
 			const Beat beatTail = (note.BeatDuration > Beat::Zero()) ? (beat + note.BeatDuration) : beat;
 			const Time tail = (note.BeatDuration > Beat::Zero()) ? (course.TempoMap.BeatToTime(beatTail) + note.TimeOffset) : head;
-			perNoteFunc(ForEachNoteLaneData { &note, beat, head,
+			const ControlFlow flow = perNoteFunc(ForEachNoteLaneData { &note, beat, head,
 				TempoOrDefault(tempoChangeIt.Next(course.TempoMap.Tempo.Sorted, beat)),
 				ScrollOrDefault(scrollChangeIt.Next(course.ScrollChanges.Sorted, beat)),
 				ScrollTypeOrDefault(scrollTypeIt.Next(course.ScrollTypes.Sorted, beat)),
@@ -430,18 +444,48 @@ namespace PeepoDrumKit
 					ScrollTypeOrDefault(scrollTypeIt.Next(course.ScrollTypes.Sorted, beatTail)),
 				},
 			});
+
+			if (flow == ControlFlow::Break)
+				break;
 		}
 	}
 
-	void ChartCourse::RecalculateSENotes(BranchType branch) const
+	template <typename Func>
+	static void ForEachNoteOnNoteLane(const ChartCourse& course, BranchType branch, Func perNoteFunc)
 	{
-		enum class SEFormType { Long, Short, Alternate, Final };
+		ForEachNoteOnNoteLaneFrom(course, branch, 0, [&](const ForEachNoteLaneData& it) { perNoteFunc(it); return ControlFlow::Continue; });
+	}
+
+	// prev, curr, next, n(ext)2nd
+	struct SENoteWindow
+	{
+		ForEachNoteLaneData RingBuffer[4] = {};
+		i32 RingOffset = 0;
+
+		inline ForEachNoteLaneData& operator[](i32 idx) { return RingBuffer[(RingOffset + idx) & 3]; }
+		inline void PushNext(const ForEachNoteLaneData& n2nd) { RingOffset = (RingOffset + 1) & 3; (*this)[3] = n2nd; }
+	};
+
+	// NOTE: Alternating "do-ko" chain carried over from one note to the next
+	struct SEAlternationState
+	{
+		std::vector<const Note*> AlterChain;
+		b8 IsAlterChain = true;
+		Time TimeIntervalAlter = Time::Zero();
+		Time TimeStartAlter = Time::Zero();
+	};
+
+	struct SENoteDensity
+	{
+		b8 DenseToSparse, SparseToDense;
+		b8 IsLongAvoided, IsPrePause;
+		Time TimeToPrev, TimeToNext;
+	};
 
-		// prev, curr, next, n(ext)2nd
-		ForEachNoteLaneData noteDataRingBuffer[4] = {};
-		i32 noteDataRingOffset = 0;
-		auto getNoteData = [&](i32 idx) -> decltype(auto) { return noteDataRingBuffer[(noteDataRingOffset + idx) & 3]; };
+	static constexpr Time SENoteTimeEpsilon = Time::FromMS(1e-3);
 
+	static SENoteDensity GetSENoteDensity(SENoteWindow& window)
+	{
 		// distance when curr is on the judgement mark
 		// other is NMScroll: visual beat distance = sec_time * visual_beat_per_second_other
 		// other is HBScroll: visual beat distance = scroll_other * beat_distance
@@ -453,100 +497,152 @@ namespace PeepoDrumKit
 				: /* (prev.ScrollType == ScrollMethod::BMSCROLL) ? */ abs(curr.Beat - other.Beat).Ticks / Beat::TicksPerBeat;
 		};
 
-		auto getNoteDistance = [&]()
-		{
-			const auto& prev = getNoteData(0);
-			const auto& curr = getNoteData(1);
-			const auto& next = getNoteData(2);
-			const auto& n2nd = getNoteData(3);
-			const f32 scrollPrev = abs(prev.ScrollSpeed.cpx);
-			const f32 scrollNextCapped = std::min(1.0f, abs(next.ScrollSpeed.cpx));
-			// visual beat per second
-			const f32 vbpsPrev = scrollPrev * prev.Tempo.BPM / 60;
-			const f32 vbpsNextCapped = scrollNextCapped * next.Tempo.BPM / 60;
-			// time distance
-			const Time tdToPrev = (prev.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (curr.Time - prev.Time);
-			const Time tdToNext = (next.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (next.Time - curr.Time);
-			const Time tdToN2nd = (n2nd.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (n2nd.Time - next.Time);
-			const f32 vbdToPrev = getVisualBeat(curr, prev, scrollPrev, vbpsPrev, tdToPrev);
-			const f32 vbdToNextCapped = getVisualBeat(curr, next, scrollNextCapped, vbpsNextCapped, tdToNext);
-			return std::tuple{ tdToPrev, vbdToPrev, tdToNext, vbdToNextCapped, tdToN2nd };
-		};
+		const auto& prev = window[0];
+		const auto& curr = window[1];
+		const auto& next = window[2];
+		const auto& n2nd = window[3];
+		const f32 scrollPrev = abs(prev.ScrollSpeed.cpx);
+		const f32 scrollNextCapped = std::min(1.0f, abs(next.ScrollSpeed.cpx));
+		// visual beat per second
+		const f32 vbpsPrev = scrollPrev * prev.Tempo.BPM / 60;
+		const f32 vbpsNextCapped = scrollNextCapped * next.Tempo.BPM / 60;
+		// time distance
+		const Time tdToPrev = (prev.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (curr.Time - prev.Time);
+		const Time tdToNext = (next.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (next.Time - curr.Time);
+		const Time tdToN2nd = (n2nd.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (n2nd.Time - next.Time);
+		const f32 vbdToPrev = getVisualBeat(curr, prev, scrollPrev, vbpsPrev, tdToPrev);
+		const f32 vbdToNextCapped = getVisualBeat(curr, next, scrollNextCapped, vbpsNextCapped, tdToNext);
+
+		SENoteDensity out;
+		out.DenseToSparse = (tdToNext >= tdToPrev + SENoteTimeEpsilon);
+		out.SparseToDense = (tdToN2nd <= tdToNext - SENoteTimeEpsilon);
+		const f32 beatsEpsilon = 4 / 192.0;
+		out.IsLongAvoided = (vbdToPrev <= 4 / 16.0 - beatsEpsilon
+			|| vbdToNextCapped <= 4 / 12.0 - beatsEpsilon); // avoid text from overlapping or extending under next note
+		out.IsPrePause = (vbdToNextCapped >= 4 / 8.0 + beatsEpsilon);
+		out.TimeToPrev = tdToPrev;
+		out.TimeToNext = tdToNext;
+		return out;
+	}
 
-		const SortedNotesList& notes = GetNotes(branch);
-		std::vector<const Note*> alterChain;
-		b8 isAlterChain = true;
-		Time timeIntervalAlter = Time::Zero();
-		Time timeStartAlter = Time::Zero();
+	// NOTE: After these notes the alternation state no longer depends on any of the notes before them
+	static constexpr b8 IsSEAlternationStateReset(const Note& note, const SENoteDensity& density) { return (note.Type != NoteType::Don) || density.DenseToSparse || density.SparseToDense; }
+	static constexpr b8 SEAlternationStateAfterReset(const SENoteDensity& density) { return (density.DenseToSparse || density.SparseToDense) ? density.SparseToDense : false; }
 
-		auto assignSingleNote = [&]()
-		{
-			auto& curr = getNoteData(1);
-			const Note& it = *getNoteData(1).OriginalNote;
-			auto [tdToPrev, vbdToPrev, tdToNext, vbdToNextCapped, tdToN2nd] = getNoteDistance();
-			const Time timeEpsilon = Time::FromMS(1e-3);
-			const b8 denseToSparse = (tdToNext >= tdToPrev + timeEpsilon);
-			const b8 sparseToDense = (tdToN2nd <= tdToNext - timeEpsilon);
-			const f32 beatsEpsilon = 4 / 192.0;
-			const b8 isLongAvoided = (vbdToPrev <= 4 / 16.0 - beatsEpsilon
-				|| vbdToNextCapped <= 4 / 12.0 - beatsEpsilon); // avoid text from overlapping or extending under next note
-			const b8 isPrePause = (vbdToNextCapped >= 4 / 8.0 + beatsEpsilon);
-			auto se = (!isLongAvoided && (denseToSparse || sparseToDense || isPrePause)) ? SEFormType::Long : SEFormType::Short;
-			if (isAlterChain) {
-				if (it.Type == NoteType::Don && alterChain.empty()) {
-					timeIntervalAlter = tdToNext;
-					timeStartAlter = curr.Time;
-					alterChain.push_back(&it);
-				} else if (it.Type == NoteType::Don && abs(tdToPrev - timeIntervalAlter) < timeEpsilon && abs(timeStartAlter - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
-					alterChain.push_back(&it);
-				} else {
-					isAlterChain = false;
-					alterChain.clear();
-				}
+	// NOTE: Returns whether the note has reset the alternation state
+	static b8 AssignSENote(SENoteWindow& window, SEAlternationState& state)
+	{
+		enum class SEFormType { Long, Short, Alternate, Final };
+
+		const auto& curr = window[1];
+		const Note& it = *curr.OriginalNote;
+		const SENoteDensity density = GetSENoteDensity(window);
+		const auto [denseToSparse, sparseToDense, isLongAvoided, isPrePause, tdToPrev, tdToNext] = density;
+		const Time timeEpsilon = SENoteTimeEpsilon;
+		auto se = (!isLongAvoided && (denseToSparse || sparseToDense || isPrePause)) ? SEFormType::Long : SEFormType::Short;
+		if (state.IsAlterChain) {
+			if (it.Type == NoteType::Don && state.AlterChain.empty()) {
+				state.TimeIntervalAlter = tdToNext;
+				state.TimeStartAlter = curr.Time;
+				state.AlterChain.push_back(&it);
+			} else if (it.Type == NoteType::Don && abs(tdToPrev - state.TimeIntervalAlter) < timeEpsilon && abs(state.TimeStartAlter - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
+				state.AlterChain.push_back(&it);
+			} else {
+				state.IsAlterChain = false;
+				state.AlterChain.clear();
 			}
-			if (denseToSparse || sparseToDense) {
-				if (denseToSparse && isAlterChain && !isLongAvoided && size(alterChain) % 2 != 0 && abs(timeStartAlter - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
-					for (i32 ia = 0; ia < size(alterChain); ++ia) {
-						if (ia % 2 == 1)
-							alterChain[ia]->TempSEType = NoteSEType::Ko;
-					}
+		}
+		if (denseToSparse || sparseToDense) {
+			if (denseToSparse && state.IsAlterChain && !isLongAvoided && size(state.AlterChain) % 2 != 0 && abs(state.TimeStartAlter - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
+				for (i32 ia = 0; ia < size(state.AlterChain); ++ia) {
+					if (ia % 2 == 1)
+						state.AlterChain[ia]->TempSEType = NoteSEType::Ko;
 				}
-				alterChain.clear();
-				isAlterChain = sparseToDense;
 			}
+			state.AlterChain.clear();
+			state.IsAlterChain = sparseToDense;
+		}
+
+		switch (it.Type)
+		{
+		case NoteType::Don: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Don : NoteSEType::Do; } break;
+		case NoteType::DonBig: { it.TempSEType = NoteSEType::DonBig; } break;
+		case NoteType::DonBigHand: { it.TempSEType = NoteSEType::DonHand; } break;
+		case NoteType::Ka: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Katsu : NoteSEType::Ka; } break;
+		case NoteType::KaBig: { it.TempSEType = NoteSEType::KatsuBig; } break;
+		case NoteType::KaBigHand: { it.TempSEType = NoteSEType::KatsuHand; } break;
+		case NoteType::Drumroll: { it.TempSEType = NoteSEType::Drumroll; } break;
+		case NoteType::DrumrollBig: { it.TempSEType = NoteSEType::DrumrollBig; } break;
+		case NoteType::Balloon: { it.TempSEType = NoteSEType::Balloon; } break;
+		case NoteType::BalloonSpecial: { it.TempSEType = NoteSEType::BalloonSpecial; } break;
+		default: { it.TempSEType = NoteSEType::Count; } break;
+		}
+
+		return IsSEAlternationStateReset(it, density);
+	}
+
+	void ChartCourse::RecalculateSENotes(BranchType branch) const
+	{
+		RecalculateSENotes(branch, NoteBeatRange { Beat::FromTicks(I32Min), Beat::FromTicks(I32Max) });
+	}
 
-			switch (it.Type)
+	void ChartCourse::RecalculateSENotes(BranchType branch, NoteBeatRange changedNotes) const
+	{
+		const SortedNotesList& notes = GetNotes(branch);
+		const i64 noteCount = static_cast<i64>(notes.size());
+		if (noteCount <= 0 || changedNotes.IsEmpty())
+			return;
+
+		// NOTE: Each note is assigned based on its (prev, curr, next, n2nd) window,
+		//		 so a changed (or removed) note affects the assignment of the two notes before and the one note after it
+		const i64 firstDirtyIndex = static_cast<i64>(SearchForFirstIndexAtOrAfterBeat(notes.Sorted, changedNotes.Min)) - 2;
+		const i64 lastDirtyIndex = static_cast<i64>(SearchForFirstIndexAfterBeat(notes.Sorted, changedNotes.Max));
+
+		// NOTE: Resume right after the closest unaffected note resetting the alternation state, as everything before it is still up to date.
+		//		 Only long runs of evenly spaced small don notes have to be walked back any further than a few notes
+		i64 startIndex = 0;
+		b8 startIsAlterChain = true;
+		for (i64 resetIndex = (firstDirtyIndex - 1); resetIndex >= 0; resetIndex--)
+		{
+			SENoteWindow window = {};
+			i32 windowSlot = (resetIndex > 0) ? 0 : 1;
+			ForEachNoteOnNoteLaneFrom(*this, branch, static_cast<size_t>(Max<i64>(resetIndex - 1, 0)), [&](const ForEachNoteLaneData& it)
+			{
+				window[windowSlot] = it;
+				return (++windowSlot > 3) ? ControlFlow::Break : ControlFlow::Continue;
+			});
+
+			const SENoteDensity density = GetSENoteDensity(window);
+			if (IsSEAlternationStateReset(notes[resetIndex], density))
 			{
-			case NoteType::Don: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Don : NoteSEType::Do; } break;
-			case NoteType::DonBig: { it.TempSEType = NoteSEType::DonBig; } break;
-			case NoteType::DonBigHand: { it.TempSEType = NoteSEType::DonHand; } break;
-			case NoteType::Ka: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Katsu : NoteSEType::Ka; } break;
-			case NoteType::KaBig: { it.TempSEType = NoteSEType::KatsuBig; } break;
-			case NoteType::KaBigHand: { it.TempSEType = NoteSEType::KatsuHand; } break;
-			case NoteType::Drumroll: { it.TempSEType = NoteSEType::Drumroll; } break;
-			case NoteType::DrumrollBig: { it.TempSEType = NoteSEType::DrumrollBig; } break;
-			case NoteType::Balloon: { it.TempSEType = NoteSEType::Balloon; } break;
-			case NoteType::BalloonSpecial: { it.TempSEType = NoteSEType::BalloonSpecial; } break;
-			default: { it.TempSEType = NoteSEType::Count; } break;
+				startIndex = (resetIndex + 1);
+				startIsAlterChain = SEAlternationStateAfterReset(density);
+				break;
 			}
-		};
+		}
 
-		// fetch 2nd next note, update current note
-		i32 lastFilled = 0;
-		ForEachNoteOnNoteLane(*this, branch, [&](const ForEachNoteLaneData& dataIt)
+		// NOTE: Stop once past the affected notes at the next note resetting the alternation state, after which the previous result is still valid
+		SENoteWindow window = {};
+		SEAlternationState state = {};
+		state.IsAlterChain = startIsAlterChain;
+		const i64 firstWindowIndex = Max<i64>(startIndex - 1, 0);
+		i64 currIndex = (firstWindowIndex - 3);
+		b8 hasConverged = false;
+
+		auto pushAndAssignNext = [&](const ForEachNoteLaneData& n2nd)
 		{
-			if (getNoteData(1).OriginalNote != nullptr)
-				assignSingleNote();
-			noteDataRingOffset = (noteDataRingOffset + 1) & 3;
-			getNoteData(3) = dataIt;
-			lastFilled = 3;
-		});
-		for (; lastFilled >= 1; --lastFilled) {
-			if (getNoteData(1).OriginalNote != nullptr)
-				assignSingleNote();
-			noteDataRingOffset = (noteDataRingOffset + 1) & 3;
-			getNoteData(3).OriginalNote = nullptr;
-		}
+			window.PushNext(n2nd);
+			if (++currIndex < startIndex || window[1].OriginalNote == nullptr)
+				return ControlFlow::Continue;
+
+			const b8 isReset = AssignSENote(window, state);
+			hasConverged = (isReset && currIndex > lastDirtyIndex);
+			return hasConverged ? ControlFlow::Break : ControlFlow::Continue;
+		};
+
+		ForEachNoteOnNoteLaneFrom(*this, branch, static_cast<size_t>(firstWindowIndex), pushAndAssignNext);
+		for (i32 i = 0; i < 2 && !hasConverged; i++)
+			pushAndAssignNext(ForEachNoteLaneData {});
 	}
 
 	void ChartGamePreview::DrawGui(ChartContext& context, Time animatedCursorTime)
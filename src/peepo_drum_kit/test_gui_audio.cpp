@@ -133,6 +133,11 @@ namespace PeepoDrumKit
 					Gui::PlotLines("##CallbackProcessDuration", durationsMS, ArrayCountI32(durationsMS), 0, overlayTextBuffer, FLT_MAX, FLT_MAX, vec2(Gui::GetContentRegionAvail().x, 32.0f));
 				});
 
+				Gui::Property::PropertyTextValueFunc("Late Callbacks", [&]
+				{
+					Gui::Text("%lld", static_cast<long long>(Audio::Engine.DebugGetLateCallbackCount()));
+				});
+
 				Gui::Property::PropertyTextValueFunc("Rendered Samples", [&]
 				{
 					Gui::PushStyleColor(ImGuiCol_PlotLines, Gui::GetStyleColorVec4(ImGuiCol_PlotHistogram));
@@ -183,9 +188,9 @@ namespace PeepoDrumKit
 				Gui::TableNextColumn(); Gui::Text("%.0f%%", ToPercent(voiceIt.GetVolume()));
 				Gui::TableNextColumn(); Gui::Text("%.0f%%", ToPercent(voiceIt.GetPan()));
 				Gui::TableNextColumn(); Gui::Text("%.0f%%", ToPercent(voiceIt.GetPlaybackSpeed()));
-				Gui::TableNextColumn(); Gui::Text("0x%04X", static_cast<Audio::HandleBaseType>(voiceIt.Handle));
-				Gui::TableNextColumn(); Gui::Text("0x%04X", static_cast<Audio::HandleBaseType>(voiceIt.GetSource()));
-				static_assert(sizeof(Audio::HandleBaseType) == 2, "TODO: Update format strings");
+				Gui::TableNextColumn(); Gui::Text("0x%08X", static_cast<Audio::HandleBaseType>(voiceIt.Handle));
+				Gui::TableNextColumn(); Gui::Text("0x%08X", static_cast<Audio::HandleBaseType>(voiceIt.GetSource()));
+				static_assert(sizeof(Audio::HandleBaseType) == 4, "TODO: Update format strings");
 
 				Gui::TableNextColumn();
 				if (voiceIt.GetIsLooping()) voiceFlagsBuffer += "Loop | ";
@@ -260,8 +265,8 @@ namespace PeepoDrumKit
 					}
 					Gui::SameLine(0.0f, 0.0f); Gui::TextUnformatted(sourceItName);
 				}
-				static_assert(sizeof(Audio::HandleBaseType) == 2, "TODO: Update format strings");
-				Gui::TableNextColumn(); Gui::Text("0x%04X", static_cast<Audio::HandleBaseType>(sourceIt));
+				static_assert(sizeof(Audio::HandleBaseType) == 4, "TODO: Update format strings");
+				Gui::TableNextColumn(); Gui::Text("0x%08X", static_cast<Audio::HandleBaseType>(sourceIt));
 				Gui::TableNextColumn(); Gui::Text("%.2f%%", ToPercent(sourceItBaseVolume));
 				Gui::TableNextColumn(); Gui::Text("%d", sourceItInstanceCount);
 				Gui::TableNextColumn(); (sourceItSampleBuffer != nullptr) ? Gui::Text("%d", sourceItSampleBuffer->ChannelCount) : Gui::TextDisabled("n/a");
@@ -399,11 +399,11 @@ namespace PeepoDrumKit
 							case TJA::ParsedChartCommandType::MeasureNotes:
 							{
 								static std::string strBuffer; strBuffer.clear();
-								for (const TJA::NoteType& note : param.MeasureNotes.Notes)
+								for (const TJA::NoteType& note : course.GetMeasureNotes(command))
 								{
-									strBuffer += TJANoteTypeNames[EnumToIndex(note)];
-									if (&note != &param.MeasureNotes.Notes.back())
+									if (!strBuffer.empty())
 										strBuffer += " ";
+									strBuffer += TJANoteTypeNames[EnumToIndex(note)];
 								}
 								if (!strBuffer.empty())
 									memcpy(paramBuffer, strBuffer.data(), strBuffer.size() + sizeof('\0'));